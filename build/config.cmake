@@ -93,6 +93,10 @@ IF (NOT DEFINED ESCARGOT_LIBICU_SUPPORT_WITH_DLOPEN)
     SET (ESCARGOT_LIBICU_SUPPORT_WITH_DLOPEN ON)
 ENDIF()
 
+IF (NOT DEFINED ESCARGOT_REGEXP_JIT)
+    SET (ESCARGOT_REGEXP_JIT ON)
+ENDIF()
+
 
 IF (${ESCARGOT_HOST} STREQUAL "android")
     SET (ESCARGOT_LIBICU_SUPPORT OFF)
@@ -133,6 +137,11 @@ ENDIF()
 
 SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_COMPRESSIBLE_STRING)
 
+# native regexp code is generated for x86-64 only. other targets keep using the yarr interpreter
+IF (${ESCARGOT_REGEXP_JIT} STREQUAL "ON" AND (${ESCARGOT_ARCH} STREQUAL "x64" OR ${ESCARGOT_ARCH} STREQUAL "x86_64"))
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_REGEXP_JIT)
+ENDIF()
+
 #######################################################
 # flags for $(MODE) : debug/release
 #######################################################
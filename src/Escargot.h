@@ -412,16 +412,50 @@ typedef uint16_t LexicalBlockIndex;
 #define STRING_SUB_STRING_MIN_VIEW_LENGTH 32
 #endif
 
+// a substring view of a string at least this long does not keep it alive
+// if the view is shorter than 1 / STRING_VIEW_DETACH_LENGTH_RATIO of it
+#ifndef STRING_VIEW_DETACH_MIN_PARENT_LENGTH
+#define STRING_VIEW_DETACH_MIN_PARENT_LENGTH (64 * 1024)
+#endif
+
+#ifndef STRING_VIEW_DETACH_LENGTH_RATIO
+#define STRING_VIEW_DETACH_LENGTH_RATIO 8
+#endif
+
+// bytes of characters a StringBuilder keeps on the stack before it allocates a buffer
 #ifndef STRING_BUILDER_INLINE_STORAGE_MAX
-#define STRING_BUILDER_INLINE_STORAGE_MAX 24
+#define STRING_BUILDER_INLINE_STORAGE_MAX 256
+#endif
+
+// strings at least this long are referenced by a StringBuilder instead of being copied into its buffer
+#ifndef STRING_BUILDER_PIECE_LENGTH_MIN
+#define STRING_BUILDER_PIECE_LENGTH_MIN 256
 #endif
 
 #ifndef SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX
 #define SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX 1024 * 256
 #endif
 
-#ifndef REGEXP_CACHE_SIZE_MAX
-#define REGEXP_CACHE_SIZE_MAX 64
+// entries of the direct-mapped caches in StaticStrings. should be powers of 2
+#ifndef NUMBER_TO_STRING_CACHE_SIZE
+#define NUMBER_TO_STRING_CACHE_SIZE 1024
+#endif
+
+#ifndef ARRAY_INDEX_STRING_CACHE_SIZE
+#define ARRAY_INDEX_STRING_CACHE_SIZE 256
+#endif
+
+#ifndef STACK_TRACE_DEPTH_MAX
+#define STACK_TRACE_DEPTH_MAX 128
+#endif
+
+#ifndef REGEXP_CACHE_BYTE_SIZE_MAX
+#define REGEXP_CACHE_BYTE_SIZE_MAX (1024 * 256)
+#endif
+
+// RegExpJIT emits System V x86-64 code into mmap'd pages
+#if defined(ENABLE_REGEXP_JIT) && (!defined(CPU_X86_64) || !defined(__linux__))
+#undef ENABLE_REGEXP_JIT
 #endif
 
 
@@ -429,6 +463,16 @@ typedef uint16_t LexicalBlockIndex;
 #define ROPE_STRING_MIN_LENGTH 24
 #endif
 
+// a rope deeper than this is rebalanced when it is concatenated unless it is already balanced
+#ifndef ROPE_STRING_BALANCE_DEPTH
+#define ROPE_STRING_BALANCE_DEPTH 32
+#endif
+
+// charAt flattens a rope after walking its tree this many times
+#ifndef ROPE_STRING_CHAR_ACCESS_MAX
+#define ROPE_STRING_CHAR_ACCESS_MAX 16
+#endif
+
 #include "heap/Heap.h"
 #include "CheckedArithmetic.h"
 #include "runtime/String.h"
@@ -52,10 +52,12 @@
 #include "runtime/WeakMapObject.h"
 #include "runtime/GlobalObjectProxyObject.h"
 #include "runtime/CompressibleString.h"
+#include "runtime/UTF8String.h"
 #include "runtime/Template.h"
 #include "runtime/ObjectTemplate.h"
 #include "runtime/FunctionTemplate.h"
 #include "interpreter/ByteCode.h"
+#include "heap/HeapSnapshot.h"
 #include "api/internal/ValueAdapter.h"
 
 namespace Escargot {
@@ -326,6 +328,34 @@ StringRef* StringRef::createExternalFromUTF16(const char16_t* s, size_t len)
     return toRef(new UTF16String(s, len, String::FromExternalMemory));
 }
 
+static StringRef* setExternalStringReleaseCallback(String* str, const void* buffer, size_t byteLength, StringRef::ExternalStringReleaseCallback releaseCallback, void* callbackData)
+{
+    if (releaseCallback) {
+        str->setExternalMemoryReleaseCallback(buffer, byteLength, releaseCallback, callbackData);
+    }
+    return toRef(str);
+}
+
+StringRef* StringRef::createExternalFromASCII(const char* s, size_t len, ExternalStringReleaseCallback releaseCallback, void* callbackData)
+{
+    return setExternalStringReleaseCallback(new ASCIIString(s, len, String::FromExternalMemory), s, len, releaseCallback, callbackData);
+}
+
+StringRef* StringRef::createExternalFromLatin1(const unsigned char* s, size_t len, ExternalStringReleaseCallback releaseCallback, void* callbackData)
+{
+    return setExternalStringReleaseCallback(new Latin1String(s, len, String::FromExternalMemory), s, len, releaseCallback, callbackData);
+}
+
+StringRef* StringRef::createExternalFromUTF16(const char16_t* s, size_t len, ExternalStringReleaseCallback releaseCallback, void* callbackData)
+{
+    return setExternalStringReleaseCallback(new UTF16String(s, len, String::FromExternalMemory), s, len * sizeof(char16_t), releaseCallback, callbackData);
+}
+
+StringRef* StringRef::createExternalFromUTF8(const char* s, size_t len, ExternalStringReleaseCallback releaseCallback, void* callbackData)
+{
+    return setExternalStringReleaseCallback(new UTF8String(s, len, String::FromExternalMemory), s, len, releaseCallback, callbackData);
+}
+
 bool StringRef::isCompressibleStringEnabled()
 {
 #if defined(ENABLE_COMPRESSIBLE_STRING)
@@ -777,6 +807,88 @@ void VMInstanceRef::clearCachesRelatedWithContext()
     imp->globalSymbolRegistry().clear();
 }
 
+VMInstanceRef::RegExpCacheStatistics VMInstanceRef::regexpCacheStatistics()
+{
+    RegExpCache* cache = toImpl(this)->m_regexpCache;
+    RegExpCacheStatistics statistics;
+    statistics.entryCount = cache->size();
+    statistics.byteSize = cache->byteSize();
+    statistics.hitCount = cache->hitCount();
+    statistics.missCount = cache->missCount();
+    statistics.evictionCount = cache->evictionCount();
+    return statistics;
+}
+
+VMInstanceRef::StringViewStatistics VMInstanceRef::stringViewStatistics()
+{
+    const DetachableStringView::Statistics& viewStatistics = DetachableStringView::statistics();
+    StringViewStatistics statistics;
+    statistics.detachedViewCount = viewStatistics.detachedViewCount;
+    statistics.copiedBytes = viewStatistics.copiedBytes;
+    statistics.reclaimedBytes = viewStatistics.reclaimedBytes;
+    return statistics;
+}
+
+VMInstanceRef::CompressibleStringPolicy VMInstanceRef::compressibleStringPolicy()
+{
+    CompressibleStringPolicy policy;
+    memset(&policy, 0, sizeof(CompressibleStringPolicy));
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    const VMInstance::CompressibleStringPolicy& implPolicy = toImpl(this)->compressibleStringPolicy();
+    policy.checkInterval = implPolicy.m_checkInterval;
+    policy.coldTime = implPolicy.m_coldTime;
+    policy.minByteSize = implPolicy.m_minByteSize;
+    policy.byteBudget = implPolicy.m_byteBudget;
+    policy.timeBudget = implPolicy.m_timeBudget;
+#endif
+    return policy;
+}
+
+void VMInstanceRef::setCompressibleStringPolicy(const CompressibleStringPolicy& policy)
+{
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    VMInstance::CompressibleStringPolicy implPolicy;
+    implPolicy.m_checkInterval = policy.checkInterval;
+    implPolicy.m_coldTime = policy.coldTime;
+    implPolicy.m_minByteSize = policy.minByteSize;
+    implPolicy.m_byteBudget = policy.byteBudget;
+    implPolicy.m_timeBudget = policy.timeBudget;
+    toImpl(this)->setCompressibleStringPolicy(implPolicy);
+#endif
+}
+
+VMInstanceRef::CompressibleStringStatistics VMInstanceRef::compressibleStringStatistics()
+{
+    CompressibleStringStatistics statistics;
+    memset(&statistics, 0, sizeof(CompressibleStringStatistics));
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    const VMInstance::CompressibleStringStatistics& implStatistics = toImpl(this)->compressibleStringStatistics();
+    statistics.compressionCount = implStatistics.m_compressionCount;
+    statistics.compressedBytes = implStatistics.m_compressedBytes;
+    statistics.compressedSize = implStatistics.m_compressedSize;
+    statistics.decompressionCount = implStatistics.m_decompressionCount;
+    statistics.decompressedBytes = implStatistics.m_decompressedBytes;
+    statistics.compressionTime = implStatistics.m_compressionTime;
+    statistics.decompressionTime = implStatistics.m_decompressionTime;
+#endif
+    return statistics;
+}
+
+void VMInstanceRef::writeHeapSnapshot(HeapSnapshotOutputCallback callback, void* callbackData)
+{
+    HeapSnapshot::write(toImpl(this), callback, callbackData);
+}
+
+size_t VMInstanceRef::maxStackTraceDepth()
+{
+    return toImpl(this)->maxStackTraceDepth();
+}
+
+void VMInstanceRef::setMaxStackTraceDepth(size_t depth)
+{
+    toImpl(this)->setMaxStackTraceDepth(depth);
+}
+
 #define DECLARE_GLOBAL_SYMBOLS(name)                      \
     SymbolRef* VMInstanceRef::name##Symbol()              \
     {                                                     \
@@ -1791,22 +1903,23 @@ GCManagedVector<Evaluator::StackTraceData> ExecutionStateRef::computeStackTraceD
 
     new (&result) GCManagedVector<Evaluator::StackTraceData>(stackTraceData.size());
     for (size_t i = 0; i < stackTraceData.size(); i++) {
-        if ((size_t)stackTraceData[i].second.loc.index == SIZE_MAX && (size_t)stackTraceData[i].second.loc.actualCodeBlock != SIZE_MAX) {
-            ByteCodeBlock* byteCodeBlock = stackTraceData[i].second.loc.actualCodeBlock;
-            size_t byteCodePosition = stackTraceData[i].second.loc.byteCodePosition;
-            stackTraceData[i].second.loc = byteCodeBlock->computeNodeLOCFromByteCode(state->context(), byteCodePosition, byteCodeBlock->m_codeBlock);
+        SandBox::StackTraceData data = stackTraceData[i].toStackTraceData();
+        if ((size_t)data.loc.index == SIZE_MAX && (size_t)data.loc.actualCodeBlock != SIZE_MAX) {
+            ByteCodeBlock* byteCodeBlock = data.loc.actualCodeBlock;
+            size_t byteCodePosition = data.loc.byteCodePosition;
+            data.loc = byteCodeBlock->computeNodeLOCFromByteCode(state->context(), byteCodePosition, byteCodeBlock->m_codeBlock);
         }
         Evaluator::StackTraceData t;
-        t.src = toRef(stackTraceData[i].second.src);
-        t.sourceCode = toRef(stackTraceData[i].second.sourceCode);
-        t.loc.index = stackTraceData[i].second.loc.index;
-        t.loc.line = stackTraceData[i].second.loc.line;
-        t.loc.column = stackTraceData[i].second.loc.column;
-        t.functionName = toRef(stackTraceData[i].second.functionName);
-        t.isFunction = stackTraceData[i].second.isFunction;
-        t.isConstructor = stackTraceData[i].second.isConstructor;
-        t.isAssociatedWithJavaScriptCode = stackTraceData[i].second.isAssociatedWithJavaScriptCode;
-        t.isEval = stackTraceData[i].second.isEval;
+        t.src = toRef(data.resolvedSrc());
+        t.sourceCode = toRef(data.sourceCode);
+        t.loc.index = data.loc.index;
+        t.loc.line = data.loc.line;
+        t.loc.column = data.loc.column;
+        t.functionName = toRef(data.functionName);
+        t.isFunction = data.isFunction;
+        t.isConstructor = data.isConstructor;
+        t.isAssociatedWithJavaScriptCode = data.isAssociatedWithJavaScriptCode;
+        t.isEval = data.isEval;
         result[i] = t;
     }
 
@@ -2079,6 +2192,40 @@ ArrayObjectRef* ArrayObjectRef::create(ExecutionStateRef* state, ValueVectorRef*
     return toRef(ret);
 }
 
+ArrayObjectRef* ArrayObjectRef::create(ExecutionStateRef* state, const double* source, size_t length)
+{
+    ArrayObject* ret = new ArrayObject(*toImpl(state), (uint64_t)length);
+    ret->copyNumbersFrom(*toImpl(state), source, 0, length);
+    return toRef(ret);
+}
+
+ArrayObjectRef* ArrayObjectRef::create(ExecutionStateRef* state, const int32_t* source, size_t length)
+{
+    ArrayObject* ret = new ArrayObject(*toImpl(state), (uint64_t)length);
+    ret->copyNumbersFrom(*toImpl(state), source, 0, length);
+    return toRef(ret);
+}
+
+void ArrayObjectRef::copyTo(ExecutionStateRef* state, double* dst, size_t start, size_t length)
+{
+    toImpl(this)->copyNumbersTo(*toImpl(state), dst, start, length);
+}
+
+void ArrayObjectRef::copyTo(ExecutionStateRef* state, int32_t* dst, size_t start, size_t length)
+{
+    toImpl(this)->copyNumbersTo(*toImpl(state), dst, start, length);
+}
+
+void ArrayObjectRef::copyFrom(ExecutionStateRef* state, const double* src, size_t start, size_t length)
+{
+    toImpl(this)->copyNumbersFrom(*toImpl(state), src, start, length);
+}
+
+void ArrayObjectRef::copyFrom(ExecutionStateRef* state, const int32_t* src, size_t start, size_t length)
+{
+    toImpl(this)->copyNumbersFrom(*toImpl(state), src, start, length);
+}
+
 IteratorObjectRef* ArrayObjectRef::values(ExecutionStateRef* state)
 {
     return toRef(toImpl(this)->values(*toImpl(state)));
@@ -2245,6 +2392,13 @@ ArrayBufferObjectRef* ArrayBufferObjectRef::create(ExecutionStateRef* state)
     return toRef(new ArrayBufferObject(*toImpl(state)));
 }
 
+ArrayBufferObjectRef* ArrayBufferObjectRef::createExternal(ExecutionStateRef* state, void* buffer, size_t byteLength, ExternalBufferReleaseCallback releaseCallback, void* callbackData)
+{
+    ArrayBufferObject* ret = new ArrayBufferObject(*toImpl(state));
+    ret->attachExternalBuffer(*toImpl(state), buffer, byteLength, releaseCallback, callbackData);
+    return toRef(ret);
+}
+
 void ArrayBufferObjectRef::allocateBuffer(ExecutionStateRef* state, size_t bytelength)
 {
     toImpl(this)->allocateBuffer(*toImpl(state), bytelength);
@@ -2290,24 +2444,48 @@ void ArrayBufferViewRef::setBuffer(ArrayBufferObjectRef* bo, size_t byteOffset,
     toImpl(this)->setBuffer(toImpl(bo), byteOffset, byteLength);
 }
 
+bool ArrayBufferViewRef::isDetachedBuffer()
+{
+    ArrayBufferObject* buffer = toImpl(this)->buffer();
+    return !buffer || buffer->isDetachedBuffer();
+}
+
 uint8_t* ArrayBufferViewRef::rawBuffer()
 {
-    return toImpl(this)->rawBuffer();
+    return isDetachedBuffer() ? nullptr : toImpl(this)->rawBuffer();
 }
 
 size_t ArrayBufferViewRef::byteLength()
 {
-    return toImpl(this)->byteLength();
+    return isDetachedBuffer() ? 0 : toImpl(this)->byteLength();
 }
 
 size_t ArrayBufferViewRef::byteOffset()
 {
-    return toImpl(this)->byteOffset();
+    return isDetachedBuffer() ? 0 : toImpl(this)->byteOffset();
 }
 
 size_t ArrayBufferViewRef::arrayLength()
 {
-    return toImpl(this)->arrayLength();
+    return isDetachedBuffer() ? 0 : toImpl(this)->arrayLength();
+}
+
+template <typename TypedArrayObjectType>
+static TypedArrayObjectType* createTypedArrayOnBuffer(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    ASSERT(state != nullptr);
+    ExecutionState& s = *toImpl(state);
+    TypedArrayObjectType* ret = new TypedArrayObjectType(s);
+    ArrayBufferObject* bufferObject = toImpl(buffer);
+    bufferObject->throwTypeErrorIfDetached(s);
+
+    size_t elementSize = ret->elementSize();
+    size_t bufferByteLength = bufferObject->byteLength();
+    if (byteOffset % elementSize || byteOffset > bufferByteLength || arrayLength > (bufferByteLength - byteOffset) / elementSize) {
+        ErrorObject::throwBuiltinError(s, ErrorObject::RangeError, s.context()->staticStrings().TypedArray.string(), true, s.context()->staticStrings().constructor.string(), ErrorObject::Messages::GlobalObject_InvalidArrayBufferOffset);
+    }
+    ret->setBuffer(bufferObject, byteOffset, arrayLength * elementSize, arrayLength);
+    return ret;
 }
 
 Int8ArrayObjectRef* Int8ArrayObjectRef::create(ExecutionStateRef* state)
@@ -2316,54 +2494,99 @@ Int8ArrayObjectRef* Int8ArrayObjectRef::create(ExecutionStateRef* state)
     return toRef(new Int8ArrayObject(*toImpl(state)));
 }
 
+Int8ArrayObjectRef* Int8ArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Int8ArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 Uint8ArrayObjectRef* Uint8ArrayObjectRef::create(ExecutionStateRef* state)
 {
     ASSERT(state != nullptr);
     return toRef(new Uint8ArrayObject(*toImpl(state)));
 }
 
+Uint8ArrayObjectRef* Uint8ArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Uint8ArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 Int16ArrayObjectRef* Int16ArrayObjectRef::create(ExecutionStateRef* state)
 {
     ASSERT(state != nullptr);
     return toRef(new Int16ArrayObject(*toImpl(state)));
 }
 
+Int16ArrayObjectRef* Int16ArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Int16ArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 Uint16ArrayObjectRef* Uint16ArrayObjectRef::create(ExecutionStateRef* state)
 {
     ASSERT(state != nullptr);
     return toRef(new Uint16ArrayObject(*toImpl(state)));
 }
 
+Uint16ArrayObjectRef* Uint16ArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Uint16ArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 Uint32ArrayObjectRef* Uint32ArrayObjectRef::create(ExecutionStateRef* state)
 {
     ASSERT(state != nullptr);
     return toRef(new Uint32ArrayObject(*toImpl(state)));
 }
 
+Uint32ArrayObjectRef* Uint32ArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Uint32ArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 Int32ArrayObjectRef* Int32ArrayObjectRef::create(ExecutionStateRef* state)
 {
     ASSERT(state != nullptr);
     return toRef(new Int32ArrayObject(*toImpl(state)));
 }
 
+Int32ArrayObjectRef* Int32ArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Int32ArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 Float32ArrayObjectRef* Float32ArrayObjectRef::create(ExecutionStateRef* state)
 {
     ASSERT(state != nullptr);
     return toRef(new Float32ArrayObject(*toImpl(state)));
 }
 
+Float32ArrayObjectRef* Float32ArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Float32ArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 Float64ArrayObjectRef* Float64ArrayObjectRef::create(ExecutionStateRef* state)
 {
     ASSERT(state != nullptr);
     return toRef(new Float64ArrayObject(*toImpl(state)));
 }
 
+Float64ArrayObjectRef* Float64ArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Float64ArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 Uint8ClampedArrayObjectRef* Uint8ClampedArrayObjectRef::create(ExecutionStateRef* state)
 {
     ASSERT(state != nullptr);
     return toRef(new Uint8ClampedArrayObject(*toImpl(state)));
 }
 
+Uint8ClampedArrayObjectRef* Uint8ClampedArrayObjectRef::create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength)
+{
+    return toRef(createTypedArrayOnBuffer<Uint8ClampedArrayObject>(state, buffer, byteOffset, arrayLength));
+}
+
 PromiseObjectRef* PromiseObjectRef::create(ExecutionStateRef* state)
 {
     return toRef(new PromiseObject(*toImpl(state)));
@@ -2725,9 +2948,8 @@ ScriptRef* ScriptParserRef::InitializeScriptResult::fetchScriptThrowsExceptionIf
     return script.value();
 }
 
-ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScript(StringRef* script, StringRef* fileName, bool isModule)
+static ScriptParserRef::InitializeScriptResult toInitializeScriptResultRef(ScriptParser::InitializeScriptResult internalResult)
 {
-    auto internalResult = toImpl(this)->initializeScript(toImpl(script), toImpl(fileName), isModule);
     ScriptParserRef::InitializeScriptResult result;
     if (internalResult.script) {
         result.script = toRef(internalResult.script.value());
@@ -2739,6 +2961,16 @@ ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScript(String
     return result;
 }
 
+ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScript(StringRef* script, StringRef* fileName, bool isModule)
+{
+    return toInitializeScriptResultRef(toImpl(this)->initializeScript(toImpl(script), toImpl(fileName), isModule));
+}
+
+ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScriptFromStream(SourceChunkReader reader, void* readerData, StringRef* fileName, bool isModule, size_t sourceLengthHint)
+{
+    return toInitializeScriptResultRef(toImpl(this)->initializeScriptFromStream(reader, readerData, toImpl(fileName), isModule, sourceLengthHint));
+}
+
 bool ScriptRef::isModule()
 {
     return toImpl(this)->isModule();
@@ -547,6 +547,58 @@ public:
 
     void clearCachesRelatedWithContext();
 
+    // compiled RegExp patterns are shared by every context of a VMInstance
+    struct RegExpCacheStatistics {
+        size_t entryCount;
+        size_t byteSize;
+        size_t hitCount;
+        size_t missCount;
+        size_t evictionCount;
+    };
+    RegExpCacheStatistics regexpCacheStatistics();
+
+    // short substring views stop keeping a long string alive once nothing else refers to it.
+    // their characters are copied out then. counted for every VMInstance of the process
+    struct StringViewStatistics {
+        size_t detachedViewCount;
+        size_t copiedBytes;
+        size_t reclaimedBytes; // characters of the long strings released that way
+    };
+    StringViewStatistics stringViewStatistics();
+
+    // cold CompressibleStrings are compressed after GC. times of the policy are in milliseconds
+    // chunks decompressed for a range of a compressed string are released the same way once cold
+    // these do nothing unless compressible string is enabled (see StringRef::isCompressibleStringEnabled)
+    struct CompressibleStringPolicy {
+        uint64_t checkInterval; // between two compression passes
+        uint64_t coldTime; // a string unused for this long is compressed
+        size_t minByteSize; // smaller strings are never compressed
+        size_t byteBudget; // uncompressed bytes compressed by one pass at most
+        uint64_t timeBudget; // a pass does not start another string after this long
+    };
+    CompressibleStringPolicy compressibleStringPolicy();
+    void setCompressibleStringPolicy(const CompressibleStringPolicy& policy);
+
+    struct CompressibleStringStatistics {
+        size_t compressionCount;
+        size_t compressedBytes; // uncompressed bytes of the strings compressed
+        size_t compressedSize; // bytes they were compressed into
+        size_t decompressionCount;
+        size_t decompressedBytes; // compiling a function of a compressed source decompresses only the chunks of the function
+        uint64_t compressionTime; // in microseconds
+        uint64_t decompressionTime; // in microseconds
+    };
+    CompressibleStringStatistics compressibleStringStatistics();
+
+    // number of frames recorded for stack traces of thrown exceptions (STACK_TRACE_DEPTH_MAX by default)
+    size_t maxStackTraceDepth();
+    void setMaxStackTraceDepth(size_t depth);
+
+    // writes the objects reachable from the contexts of this instance in Chrome DevTools .heapsnapshot format
+    // the JSON text is passed to callback in pieces. this runs a full GC, so don't call it in performance-critical path
+    typedef void (*HeapSnapshotOutputCallback)(const char* data, size_t length, void* callbackData);
+    void writeHeapSnapshot(HeapSnapshotOutputCallback callback, void* callbackData);
+
     PlatformRef* platform();
 
     SymbolRef* toStringTagSymbol();
@@ -800,6 +852,15 @@ public:
     static StringRef* createExternalFromLatin1(const unsigned char* s, size_t len);
     static StringRef* createExternalFromUTF16(const char16_t* s, size_t len);
 
+    // external strings on embedder owned memory (e.g. mmap'd files). the memory must not change while the string is alive.
+    // releaseCallback is called once, when the string is collected. callbackData is not traced by GC
+    typedef void (*ExternalStringReleaseCallback)(const void* buffer, size_t byteLength, void* callbackData);
+    static StringRef* createExternalFromASCII(const char* s, size_t len, ExternalStringReleaseCallback releaseCallback, void* callbackData);
+    static StringRef* createExternalFromLatin1(const unsigned char* s, size_t len, ExternalStringReleaseCallback releaseCallback, void* callbackData);
+    static StringRef* createExternalFromUTF16(const char16_t* s, size_t len, ExternalStringReleaseCallback releaseCallback, void* callbackData);
+    // s should be valid UTF-8. it is kept as is and decoded only when characters of the string are accessed
+    static StringRef* createExternalFromUTF8(const char* s, size_t len, ExternalStringReleaseCallback releaseCallback = nullptr, void* callbackData = nullptr);
+
     // you can use these functions only if you enabled source compression
     // you don't need to use CompressibleString when string is small(~128KB)
     static bool isCompressibleStringEnabled();
@@ -1159,6 +1220,15 @@ class ESCARGOT_EXPORT ArrayObjectRef : public ObjectRef {
 public:
     static ArrayObjectRef* create(ExecutionStateRef* state);
     static ArrayObjectRef* create(ExecutionStateRef* state, ValueVectorRef* source);
+    static ArrayObjectRef* create(ExecutionStateRef* state, const double* source, size_t length);
+    static ArrayObjectRef* create(ExecutionStateRef* state, const int32_t* source, size_t length);
+    // copies length elements from start without creating a ValueRef for each one.
+    // elements are converted with ToNumber (ToInt32 for int32_t). missing elements read as undefined
+    void copyTo(ExecutionStateRef* state, double* dst, size_t start, size_t length);
+    void copyTo(ExecutionStateRef* state, int32_t* dst, size_t start, size_t length);
+    // stores length numbers from start. the array grows if start + length is larger than its length
+    void copyFrom(ExecutionStateRef* state, const double* src, size_t start, size_t length);
+    void copyFrom(ExecutionStateRef* state, const int32_t* src, size_t start, size_t length);
     IteratorObjectRef* values(ExecutionStateRef* state);
     IteratorObjectRef* keys(ExecutionStateRef* state);
     IteratorObjectRef* entries(ExecutionStateRef* state);
@@ -1269,69 +1339,89 @@ public:
 
 class ESCARGOT_EXPORT ArrayBufferObjectRef : public ObjectRef {
 public:
+    typedef void (*ExternalBufferReleaseCallback)(void* buffer, size_t byteLength, void* callbackData);
+
     static ArrayBufferObjectRef* create(ExecutionStateRef* state);
+    // wraps an embedder owned buffer without copying it. releaseCallback is called once,
+    // when the buffer is detached or the ArrayBuffer is collected. callbackData is not traced by GC
+    static ArrayBufferObjectRef* createExternal(ExecutionStateRef* state, void* buffer, size_t byteLength, ExternalBufferReleaseCallback releaseCallback, void* callbackData);
     void allocateBuffer(ExecutionStateRef* state, size_t bytelength);
     void attachBuffer(ExecutionStateRef* state, void* buffer, size_t bytelength);
     void detachArrayBuffer(ExecutionStateRef* state);
+    // nullptr and 0 once the buffer is detached
     uint8_t* rawBuffer();
     size_t byteLength();
     bool isDetachedBuffer();
 };
 
+// typed arrays are created without a buffer, or as a view of arrayLength elements of a buffer from byteOffset.
+// the latter throws RangeError when the elements are not in the buffer
 class ESCARGOT_EXPORT ArrayBufferViewRef : public ObjectRef {
 public:
     ArrayBufferObjectRef* buffer();
     void setBuffer(ArrayBufferObjectRef* bo, size_t byteOffset, size_t byteLength, size_t arrayLength);
     void setBuffer(ArrayBufferObjectRef* bo, size_t byteOffset, size_t byteLength);
+    // direct access to the elements. rawBuffer() is nullptr and the lengths are 0 once the buffer is detached,
+    // so check them again after running any script which could detach the buffer
     uint8_t* rawBuffer();
     size_t byteLength();
     size_t byteOffset();
     size_t arrayLength();
+    bool isDetachedBuffer();
 };
 
 class ESCARGOT_EXPORT Int8ArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Int8ArrayObjectRef* create(ExecutionStateRef* state);
+    static Int8ArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT Uint8ArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Uint8ArrayObjectRef* create(ExecutionStateRef* state);
+    static Uint8ArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT Int16ArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Int16ArrayObjectRef* create(ExecutionStateRef* state);
+    static Int16ArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT Uint16ArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Uint16ArrayObjectRef* create(ExecutionStateRef* state);
+    static Uint16ArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT Uint32ArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Uint32ArrayObjectRef* create(ExecutionStateRef* state);
+    static Uint32ArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT Int32ArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Int32ArrayObjectRef* create(ExecutionStateRef* state);
+    static Int32ArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT Uint8ClampedArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Uint8ClampedArrayObjectRef* create(ExecutionStateRef* state);
+    static Uint8ClampedArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT Float32ArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Float32ArrayObjectRef* create(ExecutionStateRef* state);
+    static Float32ArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT Float64ArrayObjectRef : public ArrayBufferViewRef {
 public:
     static Float64ArrayObjectRef* create(ExecutionStateRef* state);
+    static Float64ArrayObjectRef* create(ExecutionStateRef* state, ArrayBufferObjectRef* buffer, size_t byteOffset, size_t arrayLength);
 };
 
 class ESCARGOT_EXPORT PromiseObjectRef : public ObjectRef {
@@ -1483,6 +1573,15 @@ public:
     };
 
     InitializeScriptResult initializeScript(StringRef* scriptSource, StringRef* fileName, bool isModule = false);
+
+    // returns the length of the next chunk of UTF-8 source and points chunk to it. returning 0 ends the source.
+    // a chunk only needs to stay valid until the next call, and a character may be split between two chunks
+    typedef size_t (*SourceChunkReader)(const char** chunk, void* readerData);
+    // pulls the source from reader while decoding each chunk into the final source buffer, so the embedder
+    // does not need to gather the whole file into one string first. sourceLengthHint is the expected
+    // source length in characters (the byte length of the file is fine), or 0 if unknown.
+    // if compressible strings are enabled, the source becomes a compressible string
+    InitializeScriptResult initializeScriptFromStream(SourceChunkReader reader, void* readerData, StringRef* fileName, bool isModule = false, size_t sourceLengthHint = 0);
 };
 
 class ESCARGOT_EXPORT ScriptRef {
@@ -307,13 +307,13 @@ void Debugger::getBacktrace(ExecutionState* state, uint32_t minDepth, uint32_t m
     }
 
     for (uint32_t i = minDepth; i < maxDepth; i++) {
-        if ((size_t)stackTraceData[i].second.loc.index == SIZE_MAX && (size_t)stackTraceData[i].second.loc.actualCodeBlock != SIZE_MAX) {
-            ByteCodeBlock* byteCodeBlock = stackTraceData[i].second.loc.actualCodeBlock;
-            size_t byteCodePosition = stackTraceData[i].second.loc.byteCodePosition;
+        if (stackTraceData[i].byteCodeBlock) {
+            ByteCodeBlock* byteCodeBlock = stackTraceData[i].byteCodeBlock;
+            size_t byteCodePosition = stackTraceData[i].byteCodePosition;
 
             ExtendedNodeLOC loc = byteCodeBlock->computeNodeLOCFromByteCode(state->context(), byteCodePosition, byteCodeBlock->m_codeBlock);
 
-            sendBacktraceInfo(ESCARGOT_MESSAGE_BACKTRACE, byteCodeBlock, (uint32_t)loc.line, (uint32_t)loc.column, (uint32_t)stackTraceData[i].second.executionStateDepth);
+            sendBacktraceInfo(ESCARGOT_MESSAGE_BACKTRACE, byteCodeBlock, (uint32_t)loc.line, (uint32_t)loc.column, stackTraceData[i].executionStateDepth);
 
             if (!enabled()) {
                 return;
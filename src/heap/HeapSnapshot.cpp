@@ -0,0 +1,747 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "HeapSnapshot.h"
+
+#include "runtime/VMInstance.h"
+#include "runtime/Context.h"
+#include "runtime/Object.h"
+#include "runtime/ArrayObject.h"
+#include "runtime/FunctionObject.h"
+#include "runtime/ScriptFunctionObject.h"
+#include "runtime/RegExpObject.h"
+#include "runtime/BoundFunctionObject.h"
+#include "runtime/MapObject.h"
+#include "runtime/SetObject.h"
+#include "runtime/WeakMapObject.h"
+#include "runtime/WeakSetObject.h"
+#include "runtime/PromiseObject.h"
+#include "runtime/ArrayBufferObject.h"
+#include "runtime/GeneratorObject.h"
+#include "runtime/AsyncGeneratorObject.h"
+#include "runtime/ScriptAsyncFunctionObject.h"
+#include "runtime/ExecutionPauser.h"
+#include "runtime/RopeString.h"
+#include "runtime/Symbol.h"
+#include "runtime/ObjectStructure.h"
+#include "runtime/Environment.h"
+#include "runtime/EnvironmentRecord.h"
+#include "parser/CodeBlock.h"
+#include "interpreter/ByteCode.h"
+
+namespace Escargot {
+
+// string nodes are named after their contents. longer strings are cut
+#define HEAP_SNAPSHOT_STRING_NAME_LENGTH_MAX 1024
+#define HEAP_SNAPSHOT_OUTPUT_BUFFER_SIZE (64 * 1024)
+
+static size_t allocationSize(const void* ptr)
+{
+    if (!ptr) {
+        return 0;
+    }
+    // static strings and other non-GC memory have no base
+    void* base = GC_base(const_cast<void*>(ptr));
+    return base ? GC_size(base) : 0;
+}
+
+template <typename CharType>
+static void appendAsUTF8(std::string& dst, const CharType* src, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        char32_t ch = src[i];
+        if (ch >= 0xD800 && ch <= 0xDFFF) {
+            if (ch <= 0xDBFF && i + 1 < length && src[i + 1] >= 0xDC00 && src[i + 1] <= 0xDFFF) {
+                ch = 0x10000 + ((ch - 0xD800) << 10) + (src[i + 1] - 0xDC00);
+                i++;
+            } else {
+                ch = 0xFFFD;
+            }
+        }
+
+        if (ch < 0x80) {
+            dst += (char)ch;
+        } else if (ch < 0x800) {
+            dst += (char)(0xC0 | (ch >> 6));
+            dst += (char)(0x80 | (ch & 0x3F));
+        } else if (ch < 0x10000) {
+            dst += (char)(0xE0 | (ch >> 12));
+            dst += (char)(0x80 | ((ch >> 6) & 0x3F));
+            dst += (char)(0x80 | (ch & 0x3F));
+        } else {
+            dst += (char)(0xF0 | (ch >> 18));
+            dst += (char)(0x80 | ((ch >> 12) & 0x3F));
+            dst += (char)(0x80 | ((ch >> 6) & 0x3F));
+            dst += (char)(0x80 | (ch & 0x3F));
+        }
+    }
+}
+
+HeapSnapshot::HeapSnapshot(VMInstance* instance)
+    : m_instance(instance)
+{
+    // the root is always the first node and the empty string is always the first string
+    stringIndex("");
+}
+
+void HeapSnapshot::write(VMInstance* instance, OutputCallback callback, void* callbackData)
+{
+    // collect first, so dead contexts are unregistered and every visited object is live
+    GC_gcollect();
+
+    GC_disable();
+    {
+        HeapSnapshot snapshot(instance);
+        snapshot.build();
+        snapshot.output(callback, callbackData);
+    }
+    GC_enable();
+}
+
+size_t HeapSnapshot::stringIndex(const std::string& str)
+{
+    auto iter = m_stringIndex.find(str);
+    if (iter != m_stringIndex.end()) {
+        return iter->second;
+    }
+    size_t index = m_strings.size();
+    m_strings.push_back(str);
+    m_stringIndex.insert(std::make_pair(str, index));
+    return index;
+}
+
+size_t HeapSnapshot::stringIndex(String* str)
+{
+    std::string result;
+    // strings with special implementation (ropes, compressed, lazily decoded strings)
+    // would be flattened or decoded by reading their buffer
+    if (!str->m_bufferData.hasSpecialImpl) {
+        size_t length = std::min(str->length(), (size_t)HEAP_SNAPSHOT_STRING_NAME_LENGTH_MAX);
+        if (str->m_bufferData.has8BitContent) {
+            appendAsUTF8(result, (const LChar*)str->m_bufferData.buffer, length);
+        } else {
+            appendAsUTF8(result, str->m_bufferData.bufferAs16Bit, length);
+        }
+    }
+    return stringIndex(result);
+}
+
+size_t HeapSnapshot::nodeFor(EntryKind kind, void* pointer)
+{
+    auto iter = m_nodeIndex.find(pointer);
+    if (iter != m_nodeIndex.end()) {
+        return iter->second;
+    }
+
+    size_t index = m_nodes.size();
+    m_nodes.push_back(Node());
+    Node& node = m_nodes.back();
+    node.m_type = HiddenNode;
+    node.m_kind = kind;
+    node.m_pointer = pointer;
+    node.m_name = 0;
+    node.m_selfSize = 0;
+    node.m_edgeCount = 0;
+    describeNode(node);
+
+    m_nodeIndex.insert(std::make_pair(pointer, index));
+    return index;
+}
+
+void HeapSnapshot::describeNode(Node& node)
+{
+    switch (node.m_kind) {
+    case RootEntry:
+        node.m_type = SyntheticNode;
+        break;
+    case PointerValueEntry: {
+        PointerValue* value = (PointerValue*)node.m_pointer;
+        if (value->isString()) {
+            describeString(node, value->asString());
+        } else if (value->isSymbol()) {
+            Symbol* symbol = value->asSymbol();
+            node.m_type = SymbolNode;
+            node.m_name = symbol->description() ? stringIndex(symbol->description().value()) : 0;
+            node.m_selfSize = allocationSize(symbol);
+        } else {
+            describeObject(node, value->asObject());
+        }
+        break;
+    }
+    case StructureEntry: {
+        ObjectStructure* structure = (ObjectStructure*)node.m_pointer;
+        node.m_name = stringIndex("system / ObjectStructure");
+        node.m_selfSize = allocationSize(structure);
+        // the property table is usually a separate allocation
+        if (GC_base(const_cast<ObjectStructureItem*>(structure->properties())) != GC_base(structure)) {
+            node.m_selfSize += allocationSize(structure->properties());
+        }
+        break;
+    }
+    case CodeBlockEntry: {
+        CodeBlock* codeBlock = (CodeBlock*)node.m_pointer;
+        node.m_type = CodeNode;
+        node.m_name = stringIndex(codeBlock->functionName().string());
+        node.m_selfSize = allocationSize(codeBlock);
+        break;
+    }
+    case ByteCodeBlockEntry:
+        node.m_type = CodeNode;
+        node.m_name = stringIndex("(bytecode)");
+        node.m_selfSize = ((ByteCodeBlock*)node.m_pointer)->memoryAllocatedSize();
+        break;
+    case EnvironmentEntry: {
+        LexicalEnvironment* environment = (LexicalEnvironment*)node.m_pointer;
+        node.m_type = ObjectNode;
+        node.m_name = stringIndex("system / Context");
+        node.m_selfSize = allocationSize(environment) + allocationSize(environment->record());
+        break;
+    }
+    case GlobalLexicalScopeEntry: {
+        Context* context = (Context*)node.m_pointer;
+        node.m_type = ObjectNode;
+        node.m_name = stringIndex("system / Context");
+        node.m_selfSize = allocationSize(context->globalDeclarativeStorage()->data()) + allocationSize(context->globalDeclarativeRecord()->data());
+        break;
+    }
+    case ExecutionPauserEntry: {
+        ExecutionPauser* pauser = (ExecutionPauser*)node.m_pointer;
+        node.m_type = ObjectNode;
+        node.m_name = stringIndex("system / SuspendedFrame");
+        // generators embed their pauser, async functions allocate it on its own
+        node.m_selfSize = (GC_base(pauser) == pauser ? allocationSize(pauser) : 0) + allocationSize(pauser->m_registerFile);
+        break;
+    }
+    }
+}
+
+void HeapSnapshot::describeObject(Node& node, Object* object)
+{
+    node.m_type = ObjectNode;
+    node.m_selfSize = allocationSize(object) + allocationSize(object->m_values.data());
+
+    if (object->isFunctionObject()) {
+        node.m_type = ClosureNode;
+        CodeBlock* codeBlock = object->asFunctionObject()->codeBlock();
+        if (codeBlock) {
+            node.m_name = stringIndex(codeBlock->functionName().string());
+        }
+        return;
+    }
+
+    if (object->isRegExpObject()) {
+        node.m_type = RegExpNode;
+        node.m_name = stringIndex(object->asRegExpObject()->source());
+        return;
+    }
+
+    if (object->isArrayObject()) {
+        ArrayObject* array = object->asArrayObject();
+#if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
+        node.m_selfSize += allocationSize(array->m_fastModeData.data());
+#else
+        node.m_selfSize += allocationSize(array->m_fastModeData);
+#endif
+    }
+
+    // name objects after their constructor like DevTools does
+    const char* name = object->isArrayObject() ? "Array" : "Object";
+    if (object->isGlobalObject()) {
+        name = "global";
+    } else if (object->rawInternalPrototypeObject()) {
+        Optional<Value> constructor = object->rawInternalPrototypeObject()->readConstructorSlotWithoutState();
+        if (constructor && constructor.value().isFunction()) {
+            CodeBlock* codeBlock = constructor.value().asFunction()->codeBlock();
+            if (codeBlock && codeBlock->functionName().string()->length()) {
+                node.m_name = stringIndex(codeBlock->functionName().string());
+                return;
+            }
+        }
+    }
+    node.m_name = stringIndex(name);
+}
+
+void HeapSnapshot::describeString(Node& node, String* string)
+{
+    node.m_selfSize = allocationSize(string);
+    if (string->isRopeString() && string->m_bufferData.hasSpecialImpl) {
+        node.m_type = ConcatenatedStringNode;
+        return;
+    }
+
+    node.m_type = StringNode;
+    node.m_name = stringIndex(string);
+    if (!string->m_bufferData.hasSpecialImpl) {
+        node.m_selfSize += allocationSize(string->m_bufferData.buffer);
+    }
+}
+
+void HeapSnapshot::addEdge(EdgeType type, size_t nameOrIndex, EntryKind kind, void* pointer)
+{
+    if (!pointer) {
+        return;
+    }
+    Edge edge;
+    edge.m_type = type;
+    edge.m_nameOrIndex = nameOrIndex;
+    edge.m_toNode = nodeFor(kind, pointer);
+    m_edges.push_back(edge);
+}
+
+void HeapSnapshot::addValueEdge(EdgeType type, size_t nameOrIndex, const Value& value)
+{
+    if (value.isEmpty() || !value.isPointerValue()) {
+        return;
+    }
+    PointerValue* pointer = value.asPointerValue();
+    // boxed doubles of EncodedValue are not worth a node
+    if (pointer->isDoubleInEncodedValue()) {
+        return;
+    }
+    if (!pointer->isString() && !pointer->isSymbol() && !pointer->isObject()) {
+        return;
+    }
+    addEdge(type, nameOrIndex, PointerValueEntry, pointer);
+}
+
+void HeapSnapshot::build()
+{
+    nodeFor(RootEntry, nullptr);
+
+    // nodes are visited in the order they are found,
+    // so the edges of every node are contiguous and in node order as the format requires
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        size_t edgeCountBefore = m_edges.size();
+        EntryKind kind = m_nodes[i].m_kind;
+        void* pointer = m_nodes[i].m_pointer;
+
+        switch (kind) {
+        case RootEntry:
+            visitRoot();
+            break;
+        case PointerValueEntry: {
+            PointerValue* value = (PointerValue*)pointer;
+            if (value->isString()) {
+                visitString(value->asString());
+            } else if (value->isObject()) {
+                visitObject(value->asObject());
+            }
+            break;
+        }
+        case CodeBlockEntry:
+            visitCodeBlock((CodeBlock*)pointer);
+            break;
+        case ByteCodeBlockEntry:
+            visitByteCodeBlock((ByteCodeBlock*)pointer);
+            break;
+        case EnvironmentEntry:
+            visitEnvironment((LexicalEnvironment*)pointer);
+            break;
+        case GlobalLexicalScopeEntry:
+            visitGlobalLexicalScope((Context*)pointer);
+            break;
+        case ExecutionPauserEntry:
+            visitExecutionPauser((ExecutionPauser*)pointer);
+            break;
+        default:
+            break;
+        }
+
+        // m_nodes can be reallocated while visiting
+        m_nodes[i].m_edgeCount = m_edges.size() - edgeCountBefore;
+    }
+}
+
+void HeapSnapshot::visitRoot()
+{
+    ContextVector contexts = m_instance->liveContexts();
+    size_t index = 0;
+    for (size_t i = 0; i < contexts.size(); i++) {
+        Context* context = contexts[i];
+        addEdge(ElementEdge, index++, PointerValueEntry, context->globalObject());
+        if (context->globalObjectProxy() != context->globalObject()) {
+            addEdge(ElementEdge, index++, PointerValueEntry, context->globalObjectProxy());
+        }
+        addEdge(ElementEdge, index++, GlobalLexicalScopeEntry, context);
+    }
+
+    auto& registry = m_instance->globalSymbolRegistry();
+    for (size_t i = 0; i < registry.size(); i++) {
+        addEdge(ElementEdge, index++, PointerValueEntry, registry[i].symbol);
+    }
+}
+
+void HeapSnapshot::visitObject(Object* object)
+{
+    Optional<Object*> prototype = object->rawInternalPrototypeObject();
+    if (prototype) {
+        addEdge(PropertyEdge, "__proto__", PointerValueEntry, prototype.value());
+    }
+    addEdge(InternalEdge, "map", StructureEntry, object->m_structure);
+
+    ObjectStructure* structure = object->m_structure;
+    size_t propertyCount = structure->propertyCount();
+    const ObjectStructureItem* items = structure->properties();
+    for (size_t i = 0; i < propertyCount; i++) {
+        if (items[i].m_descriptor.isNativeAccessorProperty()) {
+            // the slot holds native getter/setter data (embedder memory for API accessors), not a Value
+            continue;
+        }
+
+        const ObjectStructurePropertyName& propertyName = items[i].m_propertyName;
+        std::string name;
+        if (propertyName.isSymbol()) {
+            Symbol* symbol = propertyName.symbol();
+            name = "<symbol";
+            if (symbol->description()) {
+                name += " " + m_strings[stringIndex(symbol->description().value())];
+            }
+            name += ">";
+        } else {
+            name = m_strings[stringIndex(propertyName.plainString())];
+        }
+
+        Value value = object->m_values[i];
+        if (items[i].m_descriptor.isAccessorProperty()) {
+            JSGetterSetter* getterSetter = value.asPointerValue()->asJSGetterSetter();
+            addValueEdge(PropertyEdge, stringIndex("get " + name), getterSetter->getter());
+            addValueEdge(PropertyEdge, stringIndex("set " + name), getterSetter->setter());
+        } else {
+            addValueEdge(PropertyEdge, stringIndex(name), value);
+        }
+    }
+
+    if (object->isArrayObject()) {
+        ArrayObject* array = object->asArrayObject();
+        if (array->isFastModeArray()) {
+            for (size_t i = 0; i < array->m_arrayLength; i++) {
+                addValueEdge(ElementEdge, i, Value(array->m_fastModeData[i]));
+            }
+        }
+    }
+
+    if (object->isFunctionObject()) {
+        CodeBlock* codeBlock = object->asFunctionObject()->codeBlock();
+        if (codeBlock && codeBlock->isInterpretedCodeBlock()) {
+            addEdge(InternalEdge, "shared", CodeBlockEntry, codeBlock);
+        }
+        if (object->isScriptFunctionObject()) {
+            addEdge(InternalEdge, "context", EnvironmentEntry, object->asScriptFunctionObject()->outerEnvironment());
+        } else if (object->isNativeFunctionObject()) {
+            addEdge(InternalEdge, "frame", ExecutionPauserEntry, ScriptAsyncFunctionObject::awaitHandlerExecutionPauser(object));
+        }
+    }
+
+    visitInternalSlots(object);
+}
+
+void HeapSnapshot::visitInternalSlots(Object* object)
+{
+    if (object->isBoundFunctionObject()) {
+        BoundFunctionObject* boundFunction = object->asBoundFunctionObject();
+        addEdge(InternalEdge, "bound_function", PointerValueEntry, boundFunction->m_boundTargetFunction);
+        addValueEdge(InternalEdge, stringIndex("bound_this"), Value(boundFunction->m_boundThis));
+        size_t boundArgumentsName = stringIndex("bound_argument");
+        for (size_t i = 0; i < boundFunction->m_boundArguments.size(); i++) {
+            addValueEdge(InternalEdge, boundArgumentsName, Value(boundFunction->m_boundArguments[i]));
+        }
+    } else if (object->isMapObject()) {
+        // deleted entries are left empty
+        const MapObject::MapObjectData& storage = object->asMapObject()->storage();
+        size_t keyName = stringIndex("key");
+        size_t valueName = stringIndex("value");
+        for (size_t i = 0; i < storage.size(); i++) {
+            addValueEdge(InternalEdge, keyName, Value(storage[i].first));
+            addValueEdge(InternalEdge, valueName, Value(storage[i].second));
+        }
+    } else if (object->isSetObject()) {
+        const SetObject::SetObjectData& storage = object->asSetObject()->storage();
+        size_t valueName = stringIndex("value");
+        for (size_t i = 0; i < storage.size(); i++) {
+            addValueEdge(InternalEdge, valueName, Value(storage[i]));
+        }
+    } else if (object->isWeakMapObject()) {
+        // keys don't keep entries alive. an entry keeps its value alive while the key lives
+        const WeakMapObject::WeakMapObjectData& storage = object->asWeakMapObject()->m_storage;
+        size_t keyName = stringIndex("key");
+        size_t valueName = stringIndex("value");
+        for (size_t i = 0; i < storage.size(); i++) {
+            if (storage[i]->key) {
+                addEdge(WeakEdge, keyName, PointerValueEntry, storage[i]->key);
+                addValueEdge(InternalEdge, valueName, Value(storage[i]->data));
+            }
+        }
+    } else if (object->isWeakSetObject()) {
+        const WeakSetObject::WeakSetObjectData& storage = object->asWeakSetObject()->m_storage;
+        size_t keyName = stringIndex("key");
+        for (size_t i = 0; i < storage.size(); i++) {
+            if (storage[i]) {
+                addEdge(WeakEdge, keyName, PointerValueEntry, storage[i]->key);
+            }
+        }
+    } else if (object->isPromiseObject()) {
+        PromiseObject* promise = object->asPromiseObject();
+        addValueEdge(InternalEdge, stringIndex("result"), promise->promiseResult());
+        // both lists share the capabilities, so they are added once
+        for (size_t i = 0; i < promise->m_fulfillReactions.size(); i++) {
+            const PromiseReaction& reaction = promise->m_fulfillReactions[i];
+            addEdge(InternalEdge, "fulfill_handler", PointerValueEntry, reaction.m_handler);
+            addEdge(InternalEdge, "reaction_promise", PointerValueEntry, reaction.m_capability.m_promise);
+            addEdge(InternalEdge, "reaction_resolve", PointerValueEntry, reaction.m_capability.m_resolveFunction);
+            addEdge(InternalEdge, "reaction_reject", PointerValueEntry, reaction.m_capability.m_rejectFunction);
+        }
+        for (size_t i = 0; i < promise->m_rejectReactions.size(); i++) {
+            addEdge(InternalEdge, "reject_handler", PointerValueEntry, promise->m_rejectReactions[i].m_handler);
+        }
+    } else if (object->isArrayBufferView()) {
+        addEdge(InternalEdge, "buffer", PointerValueEntry, object->asArrayBufferView()->buffer());
+    } else if (object->isGeneratorObject()) {
+        addEdge(InternalEdge, "frame", ExecutionPauserEntry, object->asGeneratorObject()->executionPauser());
+    } else if (object->isAsyncGeneratorObject()) {
+        addEdge(InternalEdge, "frame", ExecutionPauserEntry, object->asAsyncGeneratorObject()->executionPauser());
+    }
+}
+
+void HeapSnapshot::visitString(String* string)
+{
+    if (string->isRopeString() && string->m_bufferData.hasSpecialImpl) {
+        RopeString* rope = (RopeString*)string;
+        addEdge(InternalEdge, "first", PointerValueEntry, rope->m_left);
+        addEdge(InternalEdge, "second", PointerValueEntry, rope->m_bufferData.bufferAsString);
+    }
+}
+
+void HeapSnapshot::visitCodeBlock(CodeBlock* codeBlock)
+{
+    InterpretedCodeBlock* interpretedCodeBlock = codeBlock->asInterpretedCodeBlock();
+    addEdge(InternalEdge, "bytecode", ByteCodeBlockEntry, interpretedCodeBlock->byteCodeBlock());
+}
+
+void HeapSnapshot::visitByteCodeBlock(ByteCodeBlock* byteCodeBlock)
+{
+    ByteCodeValueLiteralData& literals = byteCodeBlock->m_valueLiteralData;
+    for (size_t i = 0; i < literals.size(); i++) {
+        addValueEdge(ElementEdge, i, Value(literals[i]));
+    }
+}
+
+void HeapSnapshot::visitExecutionPauser(ExecutionPauser* pauser)
+{
+    addEdge(InternalEdge, "source", PointerValueEntry, pauser->m_sourceObject);
+    addEdge(InternalEdge, "promise", PointerValueEntry, pauser->m_promiseCapability.m_promise);
+    addEdge(InternalEdge, "resolve", PointerValueEntry, pauser->m_promiseCapability.m_resolveFunction);
+    addEdge(InternalEdge, "reject", PointerValueEntry, pauser->m_promiseCapability.m_rejectFunction);
+
+    // a finished execution has released its byte code and registers
+    ByteCodeBlock* byteCodeBlock = pauser->m_byteCodeBlock;
+    if (!byteCodeBlock) {
+        return;
+    }
+    addEdge(InternalEdge, "bytecode", ByteCodeBlockEntry, byteCodeBlock);
+    // registers followed by the stack allocated variables. the numeral literals after them are not pointers
+    size_t registerCount = byteCodeBlock->m_requiredRegisterFileSizeInValueSize + byteCodeBlock->m_codeBlock->totalStackAllocatedVariableSize();
+    for (size_t i = 0; i < registerCount; i++) {
+        addValueEdge(ElementEdge, i, pauser->m_registerFile[i]);
+    }
+}
+
+void HeapSnapshot::visitEnvironment(LexicalEnvironment* environment)
+{
+    EnvironmentRecord* record = environment->record();
+
+    if (record->isDeclarativeEnvironmentRecord()) {
+        DeclarativeEnvironmentRecord* declarativeRecord = record->asDeclarativeEnvironmentRecord();
+        if (declarativeRecord->isDeclarativeEnvironmentRecordIndexed()) {
+            DeclarativeEnvironmentRecordIndexed* indexedRecord = declarativeRecord->asDeclarativeEnvironmentRecordIndexed();
+            const auto& identifiers = indexedRecord->m_blockInfo->m_identifiers;
+            for (size_t i = 0; i < identifiers.size(); i++) {
+                if (!identifiers[i].m_needToAllocateOnStack) {
+                    addValueEdge(ContextEdge, stringIndex(identifiers[i].m_name.string()), indexedRecord->m_heapStorage[identifiers[i].m_indexForIndexedStorage]);
+                }
+            }
+        } else if (declarativeRecord->isDeclarativeEnvironmentRecordNotIndexed()) {
+            DeclarativeEnvironmentRecordNotIndexed* notIndexedRecord = declarativeRecord->asDeclarativeEnvironmentRecordNotIndexed();
+            for (size_t i = 0; i < notIndexedRecord->m_recordVector.size(); i++) {
+                addValueEdge(ContextEdge, stringIndex(notIndexedRecord->m_recordVector[i].m_name.string()), notIndexedRecord->m_heapStorage[i]);
+            }
+        } else if (declarativeRecord->isFunctionEnvironmentRecord()) {
+            FunctionEnvironmentRecord* functionRecord = declarativeRecord->asFunctionEnvironmentRecord();
+            addEdge(InternalEdge, "function", PointerValueEntry, functionRecord->functionObject());
+            if (functionRecord->isFunctionEnvironmentRecordOnHeap()) {
+                const auto& identifiers = functionRecord->functionObject()->interpretedCodeBlock()->identifierInfos();
+                auto& storage = functionRecord->heapStorage();
+                for (size_t i = 0; i < identifiers.size(); i++) {
+                    if (!identifiers[i].m_needToAllocateOnStack) {
+                        addValueEdge(ContextEdge, stringIndex(identifiers[i].m_name.string()), storage[identifiers[i].m_indexForIndexedStorage]);
+                    }
+                }
+            }
+        } else if (record->isModuleEnvironmentRecord()) {
+            const auto& bindings = record->asModuleEnvironmentRecord()->moduleBindings();
+            for (size_t i = 0; i < bindings.size(); i++) {
+                addValueEdge(ContextEdge, stringIndex(bindings[i].m_localName.string()), bindings[i].m_value);
+            }
+        }
+    } else if (record->isObjectEnvironmentRecord()) {
+        addEdge(InternalEdge, "object", PointerValueEntry, record->asObjectEnvironmentRecord()->bindingObject());
+    }
+
+    addEdge(InternalEdge, "previous", EnvironmentEntry, environment->outerEnvironment());
+}
+
+void HeapSnapshot::visitGlobalLexicalScope(Context* context)
+{
+    IdentifierRecordVector* records = context->globalDeclarativeRecord();
+    EncodedValueVector* storage = context->globalDeclarativeStorage();
+    for (size_t i = 0; i < records->size() && i < storage->size(); i++) {
+        addValueEdge(ContextEdge, stringIndex((*records)[i].m_name.string()), (*storage)[i]);
+    }
+}
+
+class HeapSnapshotOutputStream {
+public:
+    HeapSnapshotOutputStream(HeapSnapshot::OutputCallback callback, void* callbackData)
+        : m_callback(callback)
+        , m_callbackData(callbackData)
+    {
+        m_buffer.reserve(HEAP_SNAPSHOT_OUTPUT_BUFFER_SIZE);
+    }
+
+    ~HeapSnapshotOutputStream()
+    {
+        flush();
+    }
+
+    void append(const char* str)
+    {
+        m_buffer += str;
+        flushIfNeeded();
+    }
+
+    void append(size_t number)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%zu", number);
+        append(buf);
+    }
+
+    void appendJSONString(const std::string& str)
+    {
+        m_buffer += '"';
+        for (size_t i = 0; i < str.length(); i++) {
+            unsigned char ch = str[i];
+            if (ch == '"' || ch == '\\') {
+                m_buffer += '\\';
+                m_buffer += (char)ch;
+            } else if (ch == '\n') {
+                m_buffer += "\\n";
+            } else if (ch == '\r') {
+                m_buffer += "\\r";
+            } else if (ch == '\t') {
+                m_buffer += "\\t";
+            } else if (ch < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                m_buffer += buf;
+            } else {
+                m_buffer += (char)ch;
+            }
+        }
+        m_buffer += '"';
+        flushIfNeeded();
+    }
+
+    void flush()
+    {
+        if (m_buffer.length()) {
+            m_callback(m_buffer.data(), m_buffer.length(), m_callbackData);
+            m_buffer.clear();
+        }
+    }
+
+private:
+    void flushIfNeeded()
+    {
+        if (m_buffer.length() >= HEAP_SNAPSHOT_OUTPUT_BUFFER_SIZE) {
+            flush();
+        }
+    }
+
+    HeapSnapshot::OutputCallback m_callback;
+    void* m_callbackData;
+    std::string m_buffer;
+};
+
+void HeapSnapshot::output(OutputCallback callback, void* callbackData)
+{
+    const size_t nodeFieldCount = 6;
+    HeapSnapshotOutputStream stream(callback, callbackData);
+
+    stream.append("{\"snapshot\":{\"meta\":{"
+                  "\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\",\"edge_count\",\"trace_node_id\"],"
+                  "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\",\"code\",\"closure\",\"regexp\",\"number\",\"native\",\"synthetic\",\"concatenated string\",\"sliced string\",\"symbol\",\"bigint\"],"
+                  "\"string\",\"number\",\"number\",\"number\",\"number\",\"number\"],"
+                  "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+                  "\"edge_types\":[[\"context\",\"element\",\"property\",\"internal\",\"hidden\",\"shortcut\",\"weak\"],\"string_or_number\",\"node\"],"
+                  "\"trace_function_info_fields\":[\"function_id\",\"name\",\"script_name\",\"script_id\",\"line\",\"column\"],"
+                  "\"trace_node_fields\":[\"id\",\"function_info_index\",\"count\",\"size\",\"children\"],"
+                  "\"sample_fields\":[\"timestamp_us\",\"last_assigned_id\"],"
+                  "\"location_fields\":[\"object_index\",\"script_id\",\"line\",\"column\"]},"
+                  "\"node_count\":");
+    stream.append(m_nodes.size());
+    stream.append(",\"edge_count\":");
+    stream.append(m_edges.size());
+    stream.append(",\"trace_function_count\":0},\n\"nodes\":[");
+
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        const Node& node = m_nodes[i];
+        stream.append(i ? ",\n" : "");
+        stream.append((size_t)node.m_type);
+        stream.append(",");
+        stream.append(node.m_name);
+        stream.append(",");
+        // ids of JS heap objects are odd in snapshots written by V8
+        stream.append(i * 2 + 1);
+        stream.append(",");
+        stream.append(node.m_selfSize);
+        stream.append(",");
+        stream.append(node.m_edgeCount);
+        stream.append(",0");
+    }
+
+    stream.append("],\n\"edges\":[");
+    for (size_t i = 0; i < m_edges.size(); i++) {
+        const Edge& edge = m_edges[i];
+        stream.append(i ? ",\n" : "");
+        stream.append((size_t)edge.m_type);
+        stream.append(",");
+        stream.append(edge.m_nameOrIndex);
+        stream.append(",");
+        stream.append(edge.m_toNode * nodeFieldCount);
+    }
+
+    stream.append("],\n\"trace_function_infos\":[],\"trace_tree\":[],\"samples\":[],\"locations\":[],\n\"strings\":[");
+    for (size_t i = 0; i < m_strings.size(); i++) {
+        stream.append(i ? ",\n" : "");
+        stream.appendJSONString(m_strings[i]);
+    }
+    stream.append("]}\n");
+}
+}
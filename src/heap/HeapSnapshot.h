@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotHeapSnapshot__
+#define __EscargotHeapSnapshot__
+
+namespace Escargot {
+
+class VMInstance;
+class Context;
+class Value;
+class Object;
+class String;
+class Symbol;
+class CodeBlock;
+class ByteCodeBlock;
+class LexicalEnvironment;
+class ObjectStructure;
+class ExecutionPauser;
+
+/*
+ * Writes what is reachable from the contexts of a VMInstance in the Chrome DevTools
+ * heap snapshot format (.heapsnapshot JSON), so a heap can be loaded into the Memory panel.
+ *
+ * Objects, strings, symbols, structures, code blocks, closure scopes and suspended generator or async frames become nodes.
+ * Properties, elements, prototypes, closure bindings, internal slots of builtin objects,
+ * literals of byte code and registers of suspended frames become edges.
+ * Values referenced only from the native stack or from embedder memory are not visited.
+ *
+ * It calls GC_gcollect() and disables GC while walking the heap.
+ * So don't call this in performance-critical path.
+ */
+class HeapSnapshot {
+public:
+    typedef void (*OutputCallback)(const char* data, size_t length, void* callbackData);
+    static void write(VMInstance* instance, OutputCallback callback, void* callbackData);
+
+private:
+    // same order as "node_types" and "edge_types" of the format
+    enum NodeType : uint8_t {
+        HiddenNode,
+        ArrayNode,
+        StringNode,
+        ObjectNode,
+        CodeNode,
+        ClosureNode,
+        RegExpNode,
+        NumberNode,
+        NativeNode,
+        SyntheticNode,
+        ConcatenatedStringNode,
+        SlicedStringNode,
+        SymbolNode,
+        BigIntNode,
+    };
+
+    enum EdgeType : uint8_t {
+        ContextEdge,
+        ElementEdge,
+        PropertyEdge,
+        InternalEdge,
+        HiddenEdge,
+        ShortcutEdge,
+        WeakEdge,
+    };
+
+    enum EntryKind : uint8_t {
+        RootEntry,
+        PointerValueEntry,
+        StructureEntry,
+        CodeBlockEntry,
+        ByteCodeBlockEntry,
+        EnvironmentEntry,
+        GlobalLexicalScopeEntry,
+        ExecutionPauserEntry,
+    };
+
+    struct Node {
+        NodeType m_type;
+        EntryKind m_kind;
+        void* m_pointer;
+        size_t m_name;
+        size_t m_selfSize;
+        size_t m_edgeCount;
+    };
+
+    struct Edge {
+        EdgeType m_type;
+        size_t m_nameOrIndex;
+        size_t m_toNode;
+    };
+
+    explicit HeapSnapshot(VMInstance* instance);
+
+    void build();
+    void output(OutputCallback callback, void* callbackData);
+
+    size_t nodeFor(EntryKind kind, void* pointer);
+    void describeNode(Node& node);
+    void describeObject(Node& node, Object* object);
+    void describeString(Node& node, String* string);
+
+    void addEdge(EdgeType type, size_t nameOrIndex, EntryKind kind, void* pointer);
+    void addEdge(EdgeType type, const char* name, EntryKind kind, void* pointer)
+    {
+        addEdge(type, stringIndex(name), kind, pointer);
+    }
+    void addValueEdge(EdgeType type, size_t nameOrIndex, const Value& value);
+
+    void visitRoot();
+    void visitObject(Object* object);
+    void visitInternalSlots(Object* object);
+    void visitString(String* string);
+    void visitCodeBlock(CodeBlock* codeBlock);
+    void visitByteCodeBlock(ByteCodeBlock* byteCodeBlock);
+    void visitExecutionPauser(ExecutionPauser* pauser);
+    void visitEnvironment(LexicalEnvironment* environment);
+    void visitGlobalLexicalScope(Context* context);
+
+    size_t stringIndex(const std::string& str);
+    size_t stringIndex(const char* str)
+    {
+        return stringIndex(std::string(str));
+    }
+    size_t stringIndex(String* str);
+
+    VMInstance* m_instance;
+    std::vector<Node> m_nodes;
+    std::vector<Edge> m_edges;
+    std::unordered_map<void*, size_t> m_nodeIndex;
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, size_t> m_stringIndex;
+};
+}
+
+#endif
@@ -25,7 +25,6 @@
 #include "parser/Lexer.h"
 #include "parser/ScriptParser.h"
 #include "parser/ast/AST.h"
-#include "parser/esprima_cpp/esprima.h"
 
 namespace Escargot {
 
@@ -84,7 +83,7 @@ ByteCodeBlock::ByteCodeBlock(InterpretedCodeBlock* codeBlock)
     , m_isOwnerMayFreed(false)
     , m_requiredRegisterFileSizeInValueSize(2)
     , m_inlineCacheDataSize(0)
-    , m_locData(nullptr)
+    , m_locData(new ByteCodeLOCData())
     , m_codeBlock(codeBlock)
 {
     auto& v = m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
@@ -121,6 +120,7 @@ void* ByteCodeBlock::operator new(size_t size)
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(ByteCodeBlock)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ByteCodeBlock, m_literalData));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ByteCodeBlock, m_valueLiteralData));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ByteCodeBlock, m_codeBlock));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ByteCodeBlock));
         typeInited = true;
@@ -128,71 +128,119 @@ void* ByteCodeBlock::operator new(size_t size)
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
-void ByteCodeBlock::fillLocDataIfNeeded(Context* c)
+void ByteCodeLOCData::append(size_t codePosition, size_t index)
 {
-    if (m_locData || m_codeBlock->src().length() == 0) {
-        return;
+    if (m_entryCount) {
+        ASSERT(codePosition > m_lastCodePosition);
+        if (index == m_lastIndex) {
+            return;
+        }
     }
 
-#ifdef ESCARGOT_DEBUGGER
-    if (c->debugger()) {
-        ASSERT(!c->debugger()->computeLocation());
-        c->debugger()->setComputeLocation(true);
+    if (m_entryCount % CheckpointInterval == 0) {
+        Checkpoint checkpoint;
+        checkpoint.m_codePosition = codePosition;
+        checkpoint.m_index = index;
+        checkpoint.m_streamPosition = m_stream.size();
+        m_checkpoints.push_back(checkpoint);
+    } else {
+        writeUnsigned(codePosition - m_lastCodePosition);
+        // index can be SIZE_MAX (no location), so the delta wraps around and is zigzag encoded as a signed value
+        intptr_t delta = static_cast<intptr_t>(index - m_lastIndex);
+        writeUnsigned((static_cast<size_t>(delta) << 1) ^ static_cast<size_t>(delta >> (sizeof(intptr_t) * 8 - 1)));
     }
-#endif /* ESCARGOT_DEBUGGER */
 
-    GC_disable();
+    m_entryCount++;
+    m_lastCodePosition = codePosition;
+    m_lastIndex = index;
+}
 
-    ByteCodeBlock* block;
-    // TODO give correct stack limit to parser
-    if (m_codeBlock->isGlobalScopeCodeBlock()) {
-        ProgramNode* nd = esprima::parseProgram(c, m_codeBlock->src(), m_codeBlock->script()->isModule(), m_codeBlock->isStrict(), m_codeBlock->inWith(), SIZE_MAX, false, false, false);
-        block = ByteCodeGenerator::generateByteCode(c, m_codeBlock, nd, m_isEvalMode, m_isOnGlobal, false, true);
-    } else {
-        auto body = esprima::parseSingleFunction(c, m_codeBlock, SIZE_MAX);
-        block = ByteCodeGenerator::generateByteCode(c, m_codeBlock, body, m_isEvalMode, m_isOnGlobal, false, true);
+void ByteCodeLOCData::clear()
+{
+    m_stream.clear();
+    m_checkpoints.clear();
+    m_entryCount = 0;
+    m_lastCodePosition = 0;
+    m_lastIndex = 0;
+}
+
+void ByteCodeLOCData::shrinkToFit()
+{
+    m_stream.shrink_to_fit();
+    m_checkpoints.shrink_to_fit();
+}
+
+bool ByteCodeLOCData::find(size_t codePosition, size_t& index) const
+{
+    auto iter = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), codePosition, [](size_t position, const Checkpoint& checkpoint) -> bool {
+        return position < checkpoint.m_codePosition;
+    });
+    if (iter == m_checkpoints.begin()) {
+        return false;
+    }
+
+    size_t streamEnd = (iter == m_checkpoints.end()) ? m_stream.size() : iter->m_streamPosition;
+    const Checkpoint& checkpoint = *(iter - 1);
+    size_t streamPosition = checkpoint.m_streamPosition;
+    size_t currentCodePosition = checkpoint.m_codePosition;
+    size_t currentIndex = checkpoint.m_index;
+    while (streamPosition < streamEnd) {
+        currentCodePosition += readUnsigned(streamPosition);
+        if (currentCodePosition > codePosition) {
+            break;
+        }
+        size_t zigzag = readUnsigned(streamPosition);
+        currentIndex += static_cast<size_t>(static_cast<intptr_t>(zigzag >> 1) ^ -static_cast<intptr_t>(zigzag & 1));
     }
-    m_locData = block->m_locData;
-    block->m_locData = nullptr;
-    // prevent infinate fillLocDataIfNeeded if m_locData.size() == 0 in here
-    m_locData->push_back(std::make_pair(SIZE_MAX, SIZE_MAX));
 
-    // reset ASTAllocator
-    c->astAllocator().reset();
-    GC_enable();
+    index = currentIndex;
+    return true;
+}
 
-#ifdef ESCARGOT_DEBUGGER
-    if (c->debugger()) {
-        c->debugger()->setComputeLocation(false);
+void ByteCodeLOCData::writeUnsigned(size_t value)
+{
+    while (value >= 0x80) {
+        m_stream.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
     }
-#endif /* ESCARGOT_DEBUGGER */
+    m_stream.push_back(static_cast<uint8_t>(value));
+}
+
+size_t ByteCodeLOCData::readUnsigned(size_t& streamPosition) const
+{
+    size_t value = 0;
+    size_t shift = 0;
+    uint8_t byte;
+    do {
+        byte = m_stream[streamPosition++];
+        value |= static_cast<size_t>(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
 }
 
 ExtendedNodeLOC ByteCodeBlock::computeNodeLOCFromByteCode(Context* c, size_t codePosition, InterpretedCodeBlock* cb)
 {
-    if (codePosition == SIZE_MAX) {
+    size_t index;
+    if (codePosition == SIZE_MAX || !m_locData->find(codePosition, index) || index == SIZE_MAX) {
         return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
     }
 
-    fillLocDataIfNeeded(c);
-
-    size_t index = 0;
-    for (size_t i = 0; i < m_locData->size(); i++) {
-        if ((*m_locData)[i].first == codePosition) {
-            index = (*m_locData)[i].second;
-            if (index == SIZE_MAX) {
-                return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
-            }
-            break;
+    ExtendedNodeLOC functionStart = cb->functionStart();
+    Script* script = cb->script();
+    if (script && script->sourceCode() && index >= functionStart.index && index <= script->sourceCode()->length()) {
+        // lines are counted from the function start like computeNodeLOC does,
+        // but with the line start table of the script instead of scanning the source
+        auto start = script->lineAndLineStart(functionStart.index);
+        auto current = script->lineAndLineStart(index);
+        if (start.first == current.first) {
+            return ExtendedNodeLOC(functionStart.line, functionStart.column + (index - functionStart.index), index);
         }
+        return ExtendedNodeLOC(functionStart.line + (current.first - start.first), index - current.second + 1, index);
     }
 
-    size_t indexRelatedWithScript = index;
-    index -= cb->functionStart().index;
-
-    auto result = computeNodeLOC(cb->src(), cb->functionStart(), index);
-    result.index = indexRelatedWithScript;
-
+    auto result = computeNodeLOC(cb->src(), functionStart, index - functionStart.index);
+    result.index = index;
     return result;
 }
 
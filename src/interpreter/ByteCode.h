@@ -82,6 +82,7 @@ struct GlobalVariableAccessCacheItem;
     F(ObjectDefineOwnPropertyWithNameOperation, 0, 0)       \
     F(ArrayDefineOwnPropertyOperation, 0, 0)                \
     F(ArrayDefineOwnPropertyBySpreadElementOperation, 0, 0) \
+    F(CopyDataProperties, 0, 0)                             \
     F(GetObject, 1, 2)                                      \
     F(SetObjectOperation, 0, 2)                             \
     F(GetObjectPreComputedCase, 1, 1)                       \
@@ -869,6 +870,30 @@ public:
 #endif
 };
 
+// https://www.ecma-international.org/ecma-262/10.0/#sec-copydataproperties
+// used for spread element in Object initialization
+class CopyDataProperties : public ByteCode {
+public:
+    CopyDataProperties(const ByteCodeLOC& loc, const size_t objectRegisterIndex, const size_t sourceRegisterIndex)
+        : ByteCode(Opcode::CopyDataPropertiesOpcode, loc)
+        , m_objectRegisterIndex(objectRegisterIndex)
+        , m_sourceRegisterIndex(sourceRegisterIndex)
+    {
+    }
+
+    ByteCodeRegisterIndex m_objectRegisterIndex;
+    ByteCodeRegisterIndex m_sourceRegisterIndex;
+
+#ifndef NDEBUG
+    void dump(const char* byteCodeStart)
+    {
+        printf("copy data properties r%d <- r%d", (int)m_objectRegisterIndex, (int)m_sourceRegisterIndex);
+    }
+#endif
+};
+
+BYTECODE_SIZE_CHECK_IN_32BIT(CopyDataProperties, sizeof(size_t) * 2);
+
 class ObjectStructureChainItem : public gc {
 public:
     ObjectStructureChainItem()
@@ -1930,17 +1955,20 @@ public:
 
 class ThrowOperation : public ByteCode {
 public:
-    ThrowOperation(const ByteCodeLOC& loc, const size_t registerIndex)
+    ThrowOperation(const ByteCodeLOC& loc, const size_t registerIndex, bool isInTryStatement)
         : ByteCode(Opcode::ThrowOperationOpcode, loc)
         , m_registerIndex(registerIndex)
+        , m_isInTryStatement(isInTryStatement)
     {
     }
     ByteCodeRegisterIndex m_registerIndex;
+    // a try statement of this function handles the exception, so it is passed to the tryOperation as a pending exception
+    bool m_isInTryStatement;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
     {
-        printf("throw r%d", (int)m_registerIndex);
+        printf("throw r%d%s", (int)m_registerIndex, m_isInTryStatement ? " (in try)" : "");
     }
 #endif
 };
@@ -2488,8 +2516,56 @@ public:
 
 
 typedef Vector<char, std::allocator<char>, ComputeReservedCapacityFunctionWithLog2<200>> ByteCodeBlockData;
-typedef std::vector<std::pair<size_t, size_t>, std::allocator<std::pair<size_t, size_t>>> ByteCodeLOCData;
+
+// Maps bytecode positions of a ByteCodeBlock to the source index each bytecode was generated from.
+// It is recorded with the bytecode and lives as long as the block, so an entry is added only when the
+// index changes and entries are stored as LEB128 (code position delta, zigzag source index delta) pairs.
+// Every CheckpointInterval-th entry is kept uncompressed as a checkpoint, so a lookup binary searches
+// the checkpoints and decodes at most CheckpointInterval - 1 entries.
+class ByteCodeLOCData {
+public:
+    static const size_t CheckpointInterval = 16;
+
+    ByteCodeLOCData()
+        : m_entryCount(0)
+        , m_lastCodePosition(0)
+        , m_lastIndex(0)
+    {
+    }
+
+    // codePosition must grow on every call
+    void append(size_t codePosition, size_t index);
+    void clear();
+    void shrinkToFit();
+
+    // finds the index of the last entry at or before codePosition. returns false if there is no such entry
+    bool find(size_t codePosition, size_t& index) const;
+
+    size_t memoryAllocatedSize() const
+    {
+        return sizeof(ByteCodeLOCData) + m_stream.capacity() + m_checkpoints.capacity() * sizeof(Checkpoint);
+    }
+
+private:
+    struct Checkpoint {
+        size_t m_codePosition;
+        size_t m_index;
+        // position in m_stream of the entries following this checkpoint
+        size_t m_streamPosition;
+    };
+
+    void writeUnsigned(size_t value);
+    size_t readUnsigned(size_t& streamPosition) const;
+
+    std::vector<uint8_t> m_stream;
+    std::vector<Checkpoint> m_checkpoints;
+    size_t m_entryCount;
+    size_t m_lastCodePosition;
+    size_t m_lastIndex;
+};
+
 typedef Vector<void*, GCUtil::gc_malloc_allocator<void*>> ByteCodeLiteralData;
+typedef Vector<PointerValue*, GCUtil::gc_malloc_allocator<PointerValue*>> ByteCodeValueLiteralData;
 typedef Vector<Value, std::allocator<Value>> ByteCodeNumeralLiteralData;
 
 class ByteCodeBlock : public gc {
@@ -2529,8 +2605,7 @@ public:
 
         char* first = (char*)&code;
         size_t start = m_code.size();
-        if (context->m_shouldGenerateLOCData)
-            m_locData->push_back(std::make_pair(start, idx));
+        m_locData->append(start, idx);
 
         m_code.resizeWithUninitializedValues(m_code.size() + sizeof(CodeType));
         for (size_t i = 0; i < sizeof(CodeType); i++) {
@@ -2592,16 +2667,16 @@ public:
     {
         size_t siz = m_code.capacity();
         siz += sizeof(ByteCodeBlock);
-        siz += m_locData ? (m_locData->size() * sizeof(std::pair<size_t, size_t>)) : 0;
+        siz += m_locData ? m_locData->memoryAllocatedSize() : 0;
         siz += m_numeralLiteralData.size() * sizeof(Value);
         siz += m_literalData.size() * sizeof(size_t);
+        siz += m_valueLiteralData.size() * sizeof(size_t);
         siz += m_inlineCacheDataSize;
         return siz;
     }
 
     ExtendedNodeLOC computeNodeLOCFromByteCode(Context* c, size_t codePosition, InterpretedCodeBlock* cb);
     ExtendedNodeLOC computeNodeLOC(StringView src, ExtendedNodeLOC sourceElementStart, size_t index);
-    void fillLocDataIfNeeded(Context* c);
 
     bool m_isEvalMode : 1;
     bool m_isOnGlobal : 1;
@@ -2612,6 +2687,8 @@ public:
     ByteCodeBlockData m_code;
     ByteCodeNumeralLiteralData m_numeralLiteralData;
     ByteCodeLiteralData m_literalData;
+    // strings and other PointerValues the byte code loads as literals
+    ByteCodeValueLiteralData m_valueLiteralData;
     size_t m_inlineCacheDataSize;
 
     ByteCodeLOCData* m_locData;
@@ -155,7 +155,7 @@ static const uint8_t byteCodeLengths[] = {
 #undef ITER_BYTE_CODE
 };
 
-ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, bool isEvalMode, bool isOnGlobal, bool inWithFromRuntime, bool shouldGenerateLOCData)
+ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, bool isEvalMode, bool isOnGlobal, bool inWithFromRuntime)
 {
     ByteCodeBlock* block = new ByteCodeBlock(codeBlock);
     block->m_isEvalMode = isEvalMode;
@@ -188,11 +188,6 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
     ctx.m_breakpointContext = &breakpointContext;
 #endif /* ESCARGOT_DEBUGGER */
 
-    ctx.m_shouldGenerateLOCData = shouldGenerateLOCData;
-    if (shouldGenerateLOCData) {
-        block->m_locData = new ByteCodeLOCData();
-    }
-
     // generate common codes
     try {
         AtomicString name = codeBlock->functionName();
@@ -216,7 +211,7 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         ast->generateStatementByteCode(block, &ctx);
 
 #ifdef ESCARGOT_DEBUGGER
-        if (c->debugger() && c->debugger()->enabled() && !c->debugger()->computeLocation()) {
+        if (c->debugger() && c->debugger()->enabled()) {
             c->debugger()->sendBreakpointLocations(breakpointContext.m_breakpointLocations);
         }
 #endif /* ESCARGOT_DEBUGGER */
@@ -229,11 +224,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         ThrowStaticErrorOperation code(ByteCodeLOC(err.m_index), ErrorObject::SyntaxError, data);
         block->m_code.resize(sizeof(ThrowStaticErrorOperation));
         memcpy(block->m_code.data(), &code, sizeof(ThrowStaticErrorOperation));
-        if (block->m_locData) {
-            delete block->m_locData;
-        }
-        block->m_locData = new ByteCodeLOCData();
-        block->m_locData->push_back(std::make_pair(0, err.m_index));
+        block->m_locData->clear();
+        block->m_locData->append(0, err.m_index);
     } catch (const char* err) {
         // TODO
         RELEASE_ASSERT_NOT_REACHED();
@@ -252,6 +244,7 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
             block->m_code.shrinkToFit();
         }
     }
+    block->m_locData->shrinkToFit();
 
     {
         ByteCodeRegisterIndex stackBase = REGULAR_REGISTER_LIMIT;
@@ -379,6 +372,12 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                     ASSIGN_STACKINDEX_IF_NEEDED(cd->m_loadRegisterIndexs[i], stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
+            case CopyDataPropertiesOpcode: {
+                CopyDataProperties* cd = (CopyDataProperties*)currentCode;
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_sourceRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
             case GetObjectPreComputedCaseOpcode: {
                 GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -717,7 +716,7 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
     }
 
 #ifndef NDEBUG
-    if (!shouldGenerateLOCData && getenv("DUMP_BYTECODE") && strlen(getenv("DUMP_BYTECODE"))) {
+    if (getenv("DUMP_BYTECODE") && strlen(getenv("DUMP_BYTECODE"))) {
         printf("dumpBytecode %s (%d:%d)>>>>>>>>>>>>>>>>>>>>>>\n", codeBlock->functionName().string()->toUTF8StringData().data(), (int)codeBlock->functionStart().line, (int)codeBlock->functionStart().column);
         printf("register info.. (stack variable total(%d), this + function + var (%d), max lexical depth (%d)) [", (int)codeBlock->totalStackAllocatedVariableSize(), (int)codeBlock->identifierOnStackCount(), (int)codeBlock->lexicalBlockStackAllocatedIdentifierMaximumDepth());
         for (size_t i = 0; i < block->m_requiredRegisterFileSizeInValueSize; i++) {
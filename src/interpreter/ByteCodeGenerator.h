@@ -100,7 +100,6 @@ struct ByteCodeGenerateContext {
         , m_keepNumberalLiteralsInRegisterFile(numeralLiteralData)
         , m_inObjectDestruction(false)
         , m_inParameterInitialization(false)
-        , m_shouldGenerateLOCData(false)
         , m_forInOfVarBinding(false)
         , m_isLeftBindingAffectedByRightExpression(false)
         , m_registerStack(new std::vector<ByteCodeRegisterIndex>())
@@ -138,7 +137,6 @@ struct ByteCodeGenerateContext {
         , m_inCallingExpressionScope(contextBefore.m_inCallingExpressionScope)
         , m_inObjectDestruction(contextBefore.m_inObjectDestruction)
         , m_inParameterInitialization(contextBefore.m_inParameterInitialization)
-        , m_shouldGenerateLOCData(contextBefore.m_shouldGenerateLOCData)
         , m_forInOfVarBinding(contextBefore.m_forInOfVarBinding)
         , m_isLeftBindingAffectedByRightExpression(contextBefore.m_isLeftBindingAffectedByRightExpression)
         , m_registerStack(contextBefore.m_registerStack)
@@ -366,7 +364,6 @@ struct ByteCodeGenerateContext {
     bool m_inObjectDestruction : 1;
     bool m_inParameterInitialization : 1;
     bool m_isHeadOfMemberExpression : 1;
-    bool m_shouldGenerateLOCData : 1;
     bool m_forInOfVarBinding : 1;
     bool m_isLeftBindingAffectedByRightExpression : 1; // x = delete x; or x = eval("var x"), 1;
 
@@ -405,7 +402,7 @@ struct ByteCodeGenerateContext {
 
 class ByteCodeGenerator {
 public:
-    static ByteCodeBlock* generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, bool isEvalMode = false, bool isOnGlobal = false, bool inWithFromRuntime = false, bool shouldGenerateLOCData = false);
+    static ByteCodeBlock* generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, bool isEvalMode = false, bool isOnGlobal = false, bool inWithFromRuntime = false);
 };
 }
 
@@ -78,6 +78,14 @@ private:
     size_t* m_oldAddress;
 };
 
+// `throw` inside a try statement sets a pending exception and returns instead of throwing a C++ exception.
+// frames between it and the tryOperation which handles it leave right after their nested interpret() like on pausing.
+// a call opcode does the same after a call from a state with ExecutionState::m_mayPassPendingException (see callPassingPendingException)
+static ALWAYS_INLINE bool hasPendingException(ExecutionState* state)
+{
+    return UNLIKELY(state->context()->vmInstance()->currentSandBox()->hasPendingException());
+}
+
 Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile)
 {
 #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
@@ -645,7 +653,14 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, ErrorObject::Messages::NOT_Callable);
             }
             // Return F.[[Call]](V, argumentsList).
-            registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            if (UNLIKELY(state->mayPassPendingException())) {
+                registerFile[code->m_resultIndex] = callPassingPendingException(*state, callee.asPointerValue(), Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                if (hasPendingException(state)) {
+                    return Value();
+                }
+            } else {
+                registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            }
 
             ADD_PROGRAM_COUNTER(CallFunction);
             NEXT_INSTRUCTION();
@@ -665,7 +680,14 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, ErrorObject::Messages::NOT_Callable);
             }
             // Return F.[[Call]](V, argumentsList).
-            registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            if (UNLIKELY(state->mayPassPendingException())) {
+                registerFile[code->m_resultIndex] = callPassingPendingException(*state, callee.asPointerValue(), receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                if (hasPendingException(state)) {
+                    return Value();
+                }
+            } else {
+                registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            }
 
             ADD_PROGRAM_COUNTER(CallFunctionWithReceiver);
             NEXT_INSTRUCTION();
@@ -893,6 +915,15 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             NEXT_INSTRUCTION();
         }
 
+        DEFINE_OPCODE(CopyDataProperties)
+            :
+        {
+            CopyDataProperties* code = (CopyDataProperties*)programCounter;
+            copyDataProperties(*state, code, registerFile);
+            ADD_PROGRAM_COUNTER(CopyDataProperties);
+            NEXT_INSTRUCTION();
+        }
+
         DEFINE_OPCODE(CreateSpreadArrayObject)
             :
         {
@@ -1069,6 +1100,10 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             ThrowOperation* code = (ThrowOperation*)programCounter;
+            if (code->m_isInTryStatement || state->m_mayPassPendingException) {
+                state->context()->vmInstance()->currentSandBox()->setPendingException(*state, registerFile[code->m_registerIndex]);
+                return Value();
+            }
             state->context()->throwException(*state, registerFile[code->m_registerIndex]);
         }
 
@@ -1288,9 +1323,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         DEFINE_OPCODE(ExecutionPause)
             :
         {
-            ExecutionPause* code = (ExecutionPause*)programCounter;
             executionPauseOperation(*state, registerFile, programCounter, codeBuffer);
-            ASSERT_NOT_REACHED();
+            // return to ExecutionPauser::start through the frames of recursive statements(see isPausing)
+            return Value();
         }
 
         DEFINE_OPCODE(BlockOperation)
@@ -2214,6 +2249,34 @@ NEVER_INLINE ArrayObject* ByteCodeInterpreter::createRestElementOperation(Execut
     return newArray;
 }
 
+// yield and await return through the interpret() frames of recursive statements instead of throwing.
+// a frame must leave right after its nested interpret() while the ExecutionPauser is pausing,
+// so ExecutionState and control flow data stay as they were for ExecutionResume
+static ALWAYS_INLINE bool isPausing(bool inPauserScope, ExecutionState* state)
+{
+    return UNLIKELY(inPauserScope) && state->executionPauser()->isPausing();
+}
+
+// [[Call]] from a state whose exceptions can be passed to their handler as pending ones.
+// a normal or arrow script function goes straight to FunctionObjectProcessCallGenerator::processCall and returns
+// what interpret() of the callee returns, so it gets the pending exception mode too.
+// natives, bound functions, proxies, class constructors and generators still throw C++ exceptions.
+// those are caught here and become the pending exception, so only the frames of the callee are unwound by C++
+NEVER_INLINE Value ByteCodeInterpreter::callPassingPendingException(ExecutionState& state, PointerValue* callee, const Value& receiver, const size_t argc, NULLABLE Value* argv)
+{
+    ASSERT(state.mayPassPendingException());
+    if (callee->isScriptFunctionObject() && !callee->isScriptClassConstructorFunctionObject()) {
+        state.m_calleeMayPassPendingException = true;
+    }
+    try {
+        return callee->call(state, receiver, argc, argv);
+    } catch (const Value& exception) {
+        // throwException has recorded the stack trace already
+        state.context()->vmInstance()->currentSandBox()->passCaughtExceptionAsPending(exception);
+        return Value();
+    }
+}
+
 NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, size_t& programCounter, ByteCodeBlock* byteCodeBlock, Value* registerFile)
 {
     char* codeBuffer = byteCodeBlock->m_code.data();
@@ -2231,6 +2294,8 @@ NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, siz
     } else {
         newState = new (alloca(sizeof(ExecutionState))) ExecutionState(state, state->lexicalEnvironment(), state->inStrictMode());
     }
+    bool oldMayPassPendingException = state->m_mayPassPendingException;
+    newState->m_mayPassPendingException = oldMayPassPendingException;
 
 #ifdef ESCARGOT_DEBUGGER
     Debugger::updateStopState(state->context()->debugger(), state, newState);
@@ -2247,33 +2312,40 @@ NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, siz
     SandBox::StackTraceDataVector stackTraceData;
 
     if (LIKELY(!code->m_isCatchResumeProcess && !code->m_isFinallyResumeProcess)) {
+        Value val;
+        bool hasException = false;
         try {
             newState->m_inTryStatement = true;
+            newState->m_mayPassPendingException = true;
             size_t newPc = programCounter + sizeof(TryOperation);
             interpret(newState, byteCodeBlock, resolveProgramCounter(codeBuffer, newPc), registerFile);
-            clearStack<512>();
-            if (UNLIKELY(code->m_isTryResumeProcess)) {
-#ifdef ESCARGOT_DEBUGGER
-                Debugger::updateStopState(state->context()->debugger(), newState, ESCARGOT_DEBUGGER_ALWAYS_STOP);
-#endif /* ESCARGOT_DEBUGGER */
-                state = newState->parent();
-                code = (TryOperation*)(byteCodeBlock->m_code.data() + newState->rareData()->m_programCounterWhenItStoppedByYield);
-                newState = new ExecutionState(state, state->lexicalEnvironment(), state->inStrictMode());
-                newState->ensureRareData()->m_controlFlowRecord = state->rareData()->m_controlFlowRecord;
+            if (isPausing(inPauserScope, newState)) {
+                return Value();
             }
-            newState->m_inTryStatement = oldInTryStatement;
-        } catch (const Value& val) {
-            if (UNLIKELY(code->m_isTryResumeProcess)) {
+            if (hasPendingException(newState)) {
+                val = newState->context()->vmInstance()->currentSandBox()->takePendingException();
+                hasException = true;
+            } else {
+                clearStack<512>();
+            }
+        } catch (const Value& exception) {
+            val = exception;
+            hasException = true;
+        }
+
+        if (UNLIKELY(code->m_isTryResumeProcess)) {
 #ifdef ESCARGOT_DEBUGGER
-                Debugger::updateStopState(state->context()->debugger(), newState, ESCARGOT_DEBUGGER_ALWAYS_STOP);
+            Debugger::updateStopState(state->context()->debugger(), newState, ESCARGOT_DEBUGGER_ALWAYS_STOP);
 #endif /* ESCARGOT_DEBUGGER */
-                state = newState->parent();
-                code = (TryOperation*)(byteCodeBlock->m_code.data() + newState->rareData()->m_programCounterWhenItStoppedByYield);
-                newState = new ExecutionState(state, state->lexicalEnvironment(), state->inStrictMode());
-                newState->ensureRareData()->m_controlFlowRecord = state->rareData()->m_controlFlowRecord;
-            }
-            newState->m_inTryStatement = oldInTryStatement;
+            state = newState->parent();
+            code = (TryOperation*)(byteCodeBlock->m_code.data() + newState->rareData()->m_programCounterWhenItStoppedByYield);
+            newState = new ExecutionState(state, state->lexicalEnvironment(), state->inStrictMode());
+            newState->ensureRareData()->m_controlFlowRecord = state->rareData()->m_controlFlowRecord;
+        }
+        newState->m_inTryStatement = oldInTryStatement;
+        newState->m_mayPassPendingException = oldMayPassPendingException;
 
+        if (hasException) {
             newState->context()->vmInstance()->currentSandBox()->fillStackDataIntoErrorObject(val);
 
 #ifndef NDEBUG
@@ -2285,14 +2357,22 @@ NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, siz
                 ESCARGOT_LOG_ERROR("%s\n", builder.finalize()->toUTF8StringData().data());
             }
 #endif
-            stackTraceData = std::move(newState->context()->vmInstance()->currentSandBox()->stackTraceData());
             if (!code->m_hasCatch) {
+                // kept for rethrowing after finally
+                stackTraceData = std::move(newState->context()->vmInstance()->currentSandBox()->stackTraceData());
                 newState->rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, val);
             } else {
-                stackTraceData.clear();
                 registerFile[code->m_catchedValueRegisterIndex] = val;
                 try {
                     interpret(newState, byteCodeBlock, code->m_catchPosition, registerFile);
+                    if (isPausing(inPauserScope, newState)) {
+                        return Value();
+                    }
+                    if (hasPendingException(newState)) {
+                        Value exception = newState->context()->vmInstance()->currentSandBox()->takePendingException();
+                        stackTraceData = newState->context()->vmInstance()->currentSandBox()->stackTraceData();
+                        newState->rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, exception);
+                    }
                 } catch (const Value& val) {
                     stackTraceData = newState->context()->vmInstance()->currentSandBox()->stackTraceData();
                     newState->rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, val);
@@ -2302,8 +2382,15 @@ NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, siz
     } else if (code->m_isCatchResumeProcess) {
         try {
             interpret(newState, byteCodeBlock, resolveProgramCounter(codeBuffer, programCounter + sizeof(TryOperation)), registerFile);
+            if (isPausing(inPauserScope, newState)) {
+                return Value();
+            }
             state = newState->parent();
             code = (TryOperation*)(byteCodeBlock->m_code.data() + newState->rareData()->m_programCounterWhenItStoppedByYield);
+            if (hasPendingException(newState)) {
+                Value exception = newState->context()->vmInstance()->currentSandBox()->takePendingException();
+                state->rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsThrow, exception);
+            }
         } catch (const Value& val) {
             state = newState->parent();
             code = (TryOperation*)(byteCodeBlock->m_code.data() + newState->rareData()->m_programCounterWhenItStoppedByYield);
@@ -2313,6 +2400,9 @@ NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, siz
 
     if (code->m_isFinallyResumeProcess) {
         interpret(newState, byteCodeBlock, resolveProgramCounter(codeBuffer, programCounter + sizeof(TryOperation)), registerFile);
+        if (isPausing(inPauserScope, newState) || hasPendingException(newState)) {
+            return Value();
+        }
         state = newState->parent();
         code = (TryOperation*)(byteCodeBlock->m_code.data() + newState->rareData()->m_programCounterWhenItStoppedByYield);
     } else if (code->m_hasFinalizer) {
@@ -2327,6 +2417,9 @@ NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, siz
         }
 
         interpret(newState, byteCodeBlock, code->m_tryCatchEndPosition, registerFile);
+        if (isPausing(inPauserScope, newState) || hasPendingException(newState)) {
+            return Value();
+        }
     }
 
     clearStack<512>();
@@ -2537,6 +2630,7 @@ NEVER_INLINE Value ByteCodeInterpreter::withOperation(ExecutionState*& state, si
     } else {
         newState = new (alloca(sizeof(ExecutionState))) ExecutionState(state, newEnv, state->inStrictMode());
     }
+    newState->m_mayPassPendingException = state->m_mayPassPendingException;
 
     if (!LIKELY(inPauserResumeProcess)) {
         newState->ensureRareData()->m_controlFlowRecord = state->rareData()->m_controlFlowRecord;
@@ -2549,6 +2643,9 @@ NEVER_INLINE Value ByteCodeInterpreter::withOperation(ExecutionState*& state, si
     size_t newPc = programCounter + sizeof(WithOperation);
     char* codeBuffer = byteCodeBlock->m_code.data();
     interpret(newState, byteCodeBlock, resolveProgramCounter(codeBuffer, newPc), registerFile);
+    if (isPausing(inPauserScope, newState) || hasPendingException(newState)) {
+        return Value();
+    }
 
     if (UNLIKELY(inPauserResumeProcess)) {
         state = newState->parent();
@@ -2657,6 +2754,7 @@ NEVER_INLINE Value ByteCodeInterpreter::blockOperation(ExecutionState*& state, B
     } else {
         newState = new (alloca(sizeof(ExecutionState))) ExecutionState(state, newEnv, state->inStrictMode());
     }
+    newState->m_mayPassPendingException = state->m_mayPassPendingException;
 
 #ifdef ESCARGOT_DEBUGGER
     Debugger::updateStopState(state->context()->debugger(), state, newState);
@@ -2667,6 +2765,9 @@ NEVER_INLINE Value ByteCodeInterpreter::blockOperation(ExecutionState*& state, B
     }
 
     interpret(newState, byteCodeBlock, resolveProgramCounter(codeBuffer, newPc), registerFile);
+    if (isPausing(inPauserScope, newState) || hasPendingException(newState)) {
+        return Value();
+    }
 
     if (UNLIKELY(inPauserResumeProcess)) {
         state = newState->parent();
@@ -2992,9 +3093,7 @@ NEVER_INLINE Value ByteCodeInterpreter::executionPauseOperation(ExecutionState&
         ExecutionPauser::pause(state, Value(), tailDataPosition, code->m_asyncGeneratorInitializeData.m_tailDataLength, nextProgramCounter, REGISTER_LIMIT, REGISTER_LIMIT, ExecutionPauser::PauseReason::GeneratorsInitialize);
     }
 
-    ASSERT_NOT_REACHED();
-    // never get here. but I add return statement for removing compile warning
-    return Value(Value::EmptyValue);
+    return Value();
 }
 
 NEVER_INLINE Value ByteCodeInterpreter::executionResumeOperation(ExecutionState*& state, size_t& programCounter, ByteCodeBlock* byteCodeBlock)
@@ -3209,6 +3308,37 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyBySpreadElementOper
     }
 }
 
+NEVER_INLINE void ByteCodeInterpreter::copyDataProperties(ExecutionState& state, CopyDataProperties* code, Value* registerFile)
+{
+    Object* target = registerFile[code->m_objectRegisterIndex].asObject();
+    const Value& source = registerFile[code->m_sourceRegisterIndex];
+    // If source is undefined or null, return target.
+    if (source.isUndefinedOrNull()) {
+        return;
+    }
+
+    // Let from be ! ToObject(source).
+    Object* from = source.toObject(state);
+    if (target->copyOwnPropertiesWithStructure(state, from, false)) {
+        return;
+    }
+
+    // Let keys be ? from.[[OwnPropertyKeys]]().
+    auto keys = from->ownPropertyKeys(state);
+    for (size_t i = 0; i < keys.size(); i++) {
+        ObjectPropertyName nextKey(state, keys[i]);
+        // Let desc be ? from.[[GetOwnProperty]](nextKey).
+        auto desc = from->getOwnProperty(state, nextKey);
+        // If desc is not undefined and desc.[[Enumerable]] is true, then
+        if (desc.hasValue() && desc.isEnumerable()) {
+            // Let propValue be ? Get(from, nextKey).
+            Value propValue = from->get(state, nextKey).value(state, from);
+            // Perform ! CreateDataProperty(target, nextKey, propValue).
+            target->defineOwnProperty(state, nextKey, ObjectPropertyDescriptor(propValue, ObjectPropertyDescriptor::AllPresent));
+        }
+    }
+}
+
 NEVER_INLINE void ByteCodeInterpreter::createSpreadArrayObject(ExecutionState& state, CreateSpreadArrayObject* code, Value* registerFile)
 {
     ArrayObject* spreadArray = ArrayObject::createSpreadArray(state);
@@ -55,6 +55,7 @@ class ObjectDefineOwnPropertyOperation;
 class ObjectDefineOwnPropertyWithNameOperation;
 class ArrayDefineOwnPropertyOperation;
 class ArrayDefineOwnPropertyBySpreadElementOperation;
+class CopyDataProperties;
 class CreateSpreadArrayObject;
 class ObjectDefineGetterSetter;
 class ResolveNameAddress;
@@ -117,6 +118,7 @@ private:
     static void replaceBlockLexicalEnvironmentOperation(ExecutionState& state, size_t programCounter, ByteCodeBlock* byteCodeBlock);
     static bool binaryInOperation(ExecutionState& state, const Value& left, const Value& right);
     static Value constructOperation(ExecutionState& state, const Value& constructor, const size_t argc, NULLABLE Value* argv);
+    static Value callPassingPendingException(ExecutionState& state, PointerValue* callee, const Value& receiver, const size_t argc, NULLABLE Value* argv);
     static void callFunctionComplexCase(ExecutionState& state, CallFunctionComplexCase* code, Value* registerFile, ByteCodeBlock* byteCodeBlock);
     static void spreadFunctionArguments(ExecutionState& state, const Value* argv, const size_t argc, ValueVector& argVector);
 
@@ -135,6 +137,7 @@ private:
     static void objectDefineOwnPropertyWithNameOperation(ExecutionState& state, ObjectDefineOwnPropertyWithNameOperation* code, Value* registerFile);
     static void arrayDefineOwnPropertyOperation(ExecutionState& state, ArrayDefineOwnPropertyOperation* code, Value* registerFile);
     static void arrayDefineOwnPropertyBySpreadElementOperation(ExecutionState& state, ArrayDefineOwnPropertyBySpreadElementOperation* code, Value* registerFile);
+    static void copyDataProperties(ExecutionState& state, CopyDataProperties* code, Value* registerFile);
     static void createSpreadArrayObject(ExecutionState& state, CreateSpreadArrayObject* code, Value* registerFile);
     static void defineObjectGetterSetter(ExecutionState& state, ObjectDefineGetterSetter* code, Value* registerFile);
     static Value incrementOperation(ExecutionState& state, const Value& value);
@@ -23,6 +23,7 @@
 #include "interpreter/ByteCodeGenerator.h"
 #include "interpreter/ByteCodeInterpreter.h"
 #include "parser/ast/Node.h"
+#include "parser/Lexer.h"
 #include "runtime/Context.h"
 #include "runtime/Environment.h"
 #include "runtime/EnvironmentRecord.h"
@@ -40,6 +41,32 @@ bool Script::isExecuted()
     return m_topCodeBlock->byteCodeBlock() == nullptr;
 }
 
+std::pair<size_t, size_t> Script::lineAndLineStart(size_t index)
+{
+    if (!m_lineStarts.size()) {
+        std::vector<size_t> lineStarts;
+        lineStarts.push_back(0);
+        auto bufferAccessData = m_sourceCode->bufferAccessData();
+        for (size_t i = 0; i < bufferAccessData.length; i++) {
+            char16_t c = bufferAccessData.charAt(i);
+            if (EscargotLexer::isLineTerminator(c)) {
+                // \r\n is one line terminator
+                if (c == 13 && i + 1 < bufferAccessData.length && bufferAccessData.charAt(i + 1) == 10) {
+                    i++;
+                }
+                lineStarts.push_back(i + 1);
+            }
+        }
+        m_lineStarts.resizeWithUninitializedValues(lineStarts.size());
+        memcpy(m_lineStarts.data(), lineStarts.data(), sizeof(size_t) * lineStarts.size());
+    }
+
+    const size_t* begin = m_lineStarts.data();
+    const size_t* end = begin + m_lineStarts.size();
+    size_t line = std::upper_bound(begin, end, index) - begin - 1;
+    return std::make_pair(line, begin[line]);
+}
+
 Context* Script::context()
 {
     return m_topCodeBlock->context();
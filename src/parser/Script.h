@@ -145,6 +145,10 @@ public:
 
     bool isExecuted();
 
+    // returns the zero-based line of a source index and the index where that line starts.
+    // the line start table is built from the source code on first use
+    std::pair<size_t, size_t> lineAndLineStart(size_t index);
+
 private:
     Script(String* src, String* sourceCode, ModuleData* moduleData, bool canExecuteAgain)
         : m_canExecuteAgain(canExecuteAgain && !moduleData)
@@ -227,6 +231,7 @@ private:
     String* m_sourceCode;
     InterpretedCodeBlock* m_topCodeBlock;
     ModuleData* m_moduleData;
+    TightVector<size_t, GCUtil::gc_malloc_atomic_allocator<size_t>> m_lineStarts;
 };
 }
 
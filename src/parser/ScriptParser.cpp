@@ -29,6 +29,10 @@
 #include "runtime/Environment.h"
 #include "runtime/EnvironmentRecord.h"
 #include "debugger/Debugger.h"
+#include "util/Transcoder.h"
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+#include "runtime/CompressibleString.h"
+#endif
 
 namespace Escargot {
 
@@ -295,6 +299,190 @@ ScriptParser::InitializeScriptResult ScriptParser::initializeScript(StringView s
     }
 }
 
+// decodes UTF-8 chunks into one growing buffer, which becomes the buffer of the resulting string.
+// with compressible strings, the buffer is the malloc'ed buffer of a CompressibleString like other script sources.
+// the content stays 8-bit until a chunk has a character out of Latin-1 range.
+// a sequence split between two chunks is kept in m_pending until its continuation bytes arrive
+class StreamingSourceDecoder {
+public:
+    StreamingSourceDecoder(Context* context, size_t capacityHint)
+        : m_context(context)
+        , m_is8Bit(true)
+        , m_buffer(nullptr)
+        , m_length(0)
+        , m_capacity(0)
+        , m_pendingLength(0)
+    {
+        ensureCapacity(capacityHint);
+    }
+
+    void append(const char* chunk, size_t len)
+    {
+        if (m_pendingLength) {
+            // complete the pending sequence with the continuation bytes at the front of this chunk
+            size_t needed = sequenceLength(m_pending[0]) - m_pendingLength;
+            while (needed && len && isContinuation(*chunk)) {
+                m_pending[m_pendingLength++] = *chunk++;
+                len--;
+                needed--;
+            }
+            if (needed && !len) {
+                return;
+            }
+            decode(m_pending, m_pendingLength);
+            m_pendingLength = 0;
+        }
+
+        size_t completeLength = len;
+        for (size_t back = 1; back <= 3 && back <= len; back++) {
+            unsigned char ch = chunk[len - back];
+            if (!isContinuation(ch)) {
+                if (ch >= 0xC0 && sequenceLength(ch) > back) {
+                    completeLength = len - back;
+                }
+                break;
+            }
+        }
+
+        decode(chunk, completeLength);
+        m_pendingLength = len - completeLength;
+        memcpy(m_pending, chunk + completeLength, m_pendingLength);
+    }
+
+    String* finish()
+    {
+        if (m_pendingLength) {
+            // truncated sequence at the end of the source
+            decode(m_pending, m_pendingLength);
+            m_pendingLength = 0;
+        }
+
+        size_t unitSize = m_is8Bit ? sizeof(LChar) : sizeof(char16_t);
+        if (m_capacity > m_length + m_length / 8) {
+            m_buffer = reallocateBuffer(m_buffer, (m_length + 1) * unitSize);
+            m_capacity = m_length;
+        }
+        memset((char*)m_buffer + m_length * unitSize, 0, unitSize);
+
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+        return new CompressibleString(m_context, m_buffer, m_length, m_is8Bit);
+#else
+        if (m_is8Bit) {
+            return new Latin1String((const LChar*)m_buffer, m_length, String::FromExternalMemory);
+        }
+        return new UTF16String((const char16_t*)m_buffer, m_length, String::FromExternalMemory);
+#endif
+    }
+
+private:
+    static void* allocateBuffer(size_t byteLength)
+    {
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+        return CompressibleString::allocateStringDataBuffer(byteLength);
+#else
+        return GC_MALLOC_ATOMIC(byteLength);
+#endif
+    }
+
+    static void* reallocateBuffer(void* buffer, size_t byteLength)
+    {
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+        return CompressibleString::reallocateStringDataBuffer(buffer, byteLength);
+#else
+        return GC_REALLOC(buffer, byteLength);
+#endif
+    }
+
+    static void freeBuffer(void* buffer)
+    {
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+        CompressibleString::deallocateStringDataBuffer(buffer);
+#else
+        GC_FREE(buffer);
+#endif
+    }
+
+    static bool isContinuation(unsigned char ch)
+    {
+        return (ch & 0xC0) == 0x80;
+    }
+
+    static size_t sequenceLength(unsigned char lead)
+    {
+        if (lead >= 0xF0 && lead <= 0xF7) {
+            return 4;
+        } else if (lead >= 0xE0 && lead < 0xF0) {
+            return 3;
+        } else if (lead >= 0xC0 && lead < 0xE0) {
+            return 2;
+        }
+        return 1;
+    }
+
+    void ensureCapacity(size_t units)
+    {
+        if (units <= m_capacity && m_buffer) {
+            return;
+        }
+        size_t newCapacity = std::max(units, std::max(m_capacity * 2, (size_t)1024));
+        size_t unitSize = m_is8Bit ? sizeof(LChar) : sizeof(char16_t);
+        // one more unit for the terminating zero
+        m_buffer = m_buffer ? reallocateBuffer(m_buffer, (newCapacity + 1) * unitSize) : allocateBuffer((newCapacity + 1) * unitSize);
+        m_capacity = newCapacity;
+    }
+
+    void widen()
+    {
+        ASSERT(m_is8Bit);
+        char16_t* newBuffer = (char16_t*)allocateBuffer((m_capacity + 1) * sizeof(char16_t));
+        Transcoder::widenLatin1ToUTF16((const LChar*)m_buffer, m_length, newBuffer);
+        freeBuffer(m_buffer);
+        m_buffer = newBuffer;
+        m_is8Bit = false;
+    }
+
+    void decode(const char* src, size_t len)
+    {
+        if (!len) {
+            return;
+        }
+        bool isLatin1;
+        size_t units = Transcoder::utf16LengthOfUTF8(src, len, isLatin1);
+        if (m_is8Bit && !isLatin1) {
+            widen();
+        }
+        ensureCapacity(m_length + units);
+        if (m_is8Bit) {
+            m_length += Transcoder::decodeUTF8(src, len, (LChar*)m_buffer + m_length);
+        } else {
+            m_length += Transcoder::decodeUTF8(src, len, (char16_t*)m_buffer + m_length);
+        }
+    }
+
+    Context* m_context;
+    bool m_is8Bit;
+    void* m_buffer;
+    size_t m_length;
+    size_t m_capacity;
+    char m_pending[4];
+    size_t m_pendingLength;
+};
+
+ScriptParser::InitializeScriptResult ScriptParser::initializeScriptFromStream(SourceChunkReader reader, void* readerData, String* fileName, bool isModule, size_t sourceLengthHint)
+{
+    StreamingSourceDecoder decoder(m_context, sourceLengthHint);
+    while (true) {
+        const char* chunk = nullptr;
+        size_t length = reader(&chunk, readerData);
+        if (!length) {
+            break;
+        }
+        decoder.append(chunk, length);
+    }
+
+    return initializeScript(decoder.finish(), fileName, isModule);
+}
+
 void ScriptParser::generateFunctionByteCode(ExecutionState& state, InterpretedCodeBlock* codeBlock, size_t stackSizeRemain)
 {
 #ifdef ESCARGOT_DEBUGGER
@@ -320,7 +508,7 @@ void ScriptParser::generateFunctionByteCode(ExecutionState& state, InterpretedCo
     }
 
     // Generate ByteCode
-    codeBlock->m_byteCodeBlock = ByteCodeGenerator::generateByteCode(state.context(), codeBlock, functionNode, false, false, false, false);
+    codeBlock->m_byteCodeBlock = ByteCodeGenerator::generateByteCode(state.context(), codeBlock, functionNode, false, false, false);
 
     // reset ASTAllocator
     m_context->astAllocator().reset();
@@ -367,7 +555,7 @@ void ScriptParser::recursivelyGenerateByteCode(InterpretedCodeBlock* topCodeBloc
 
         // Errors caught by the caller.
         FunctionNode* functionNode = esprima::parseSingleFunction(m_context, codeBlock, SIZE_MAX);
-        codeBlock->m_byteCodeBlock = ByteCodeGenerator::generateByteCode(m_context, codeBlock, functionNode, false, false, false, false);
+        codeBlock->m_byteCodeBlock = ByteCodeGenerator::generateByteCode(m_context, codeBlock, functionNode, false, false, false);
 
         if (m_context->debugger() != NULL && m_context->debugger()->enabled()) {
             String* functionName = codeBlock->functionName().string();
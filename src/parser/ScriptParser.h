@@ -64,6 +64,14 @@ public:
         return initializeScript(StringView(scriptSource, 0, scriptSource->length()), fileName, isModule, nullptr, strictFromOutside, isRunningEvalOnFunction, isEvalMode, false, stackSizeRemain, true, false, false, false);
     }
 
+    // returns the length of the next chunk of UTF-8 source and points chunk to it. 0 means the end of the source.
+    // a chunk only needs to stay valid until the next call
+    typedef size_t (*SourceChunkReader)(const char** chunk, void* readerData);
+    // pulls the source from reader and decodes every chunk as it arrives into the buffer of the final source string.
+    // sourceLengthHint is the expected length of the source in UTF-16 units (0 if unknown).
+    // with ENABLE_COMPRESSIBLE_STRING, the source is a CompressibleString
+    InitializeScriptResult initializeScriptFromStream(SourceChunkReader reader, void* readerData, String* fileName, bool isModule, size_t sourceLengthHint = 0);
+
     void generateFunctionByteCode(ExecutionState& state, InterpretedCodeBlock* codeBlock, size_t stackSizeRemain);
 
 private:
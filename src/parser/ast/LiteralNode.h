@@ -39,7 +39,7 @@ public:
     virtual void generateExpressionByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, ByteCodeRegisterIndex dstRegister) override
     {
         if (m_value.isPointerValue()) {
-            codeBlock->m_literalData.pushBack(m_value.asPointerValue());
+            codeBlock->m_valueLiteralData.pushBack(m_value.asPointerValue());
         }
         if (dstRegister < REGULAR_REGISTER_LIMIT + VARIABLE_LIMIT) {
             codeBlock->pushCode(LoadLiteral(ByteCodeLOC(m_loc.index), dstRegister, m_value), context, this);
@@ -92,53 +92,9 @@ public:
                 Node* element = property->astNode()->asSpreadElement()->argument();
 
                 ByteCodeRegisterIndex elementIndex = element->getRegister(codeBlock, context);
-                ByteCodeRegisterIndex dataIndex = context->getRegister();
-                ByteCodeRegisterIndex keyIndex = context->getRegister();
-                ByteCodeRegisterIndex valueIndex = context->getRegister();
-
                 element->generateExpressionByteCode(codeBlock, context, elementIndex);
-
-                size_t cmpIndex = context->getRegister();
-                LiteralNode* undefinedNode = new (alloca(sizeof(LiteralNode))) LiteralNode(Value());
-                size_t undefinedIndex = undefinedNode->getRegister(codeBlock, context);
-                undefinedNode->generateExpressionByteCode(codeBlock, context, undefinedIndex);
-                codeBlock->pushCode(BinaryEqual(ByteCodeLOC(m_loc.index), elementIndex, undefinedIndex, cmpIndex), context, this);
-                codeBlock->pushCode<JumpIfTrue>(JumpIfTrue(ByteCodeLOC(m_loc.index), cmpIndex), context, this);
-                size_t pos1 = codeBlock->lastCodePosition<JumpIfTrue>();
-                context->giveUpRegister(); // for drop undefinedIndex
-
-                LiteralNode* nullNode = new (alloca(sizeof(LiteralNode))) LiteralNode(Value(Value::Null));
-                size_t nullIndex = nullNode->getRegister(codeBlock, context);
-                nullNode->generateExpressionByteCode(codeBlock, context, nullIndex);
-                codeBlock->pushCode(BinaryEqual(ByteCodeLOC(m_loc.index), elementIndex, nullIndex, cmpIndex), context, this);
-                codeBlock->pushCode<JumpIfTrue>(JumpIfTrue(ByteCodeLOC(m_loc.index), cmpIndex), context, this);
-                size_t pos2 = codeBlock->lastCodePosition<JumpIfFalse>();
-                context->giveUpRegister(); // for drop nullIndex
-                context->giveUpRegister(); // for drop cmpIndex
-
-
-                codeBlock->pushCode(CreateEnumerateObject(ByteCodeLOC(m_loc.index), elementIndex, dataIndex, true), context, this);
-
-                size_t checkPos = codeBlock->currentCodeSize();
-                codeBlock->pushCode(CheckLastEnumerateKey(ByteCodeLOC(m_loc.index)), context, this);
-                codeBlock->peekCode<CheckLastEnumerateKey>(checkPos)->m_registerIndex = dataIndex;
-                codeBlock->pushCode(GetEnumerateKey(ByteCodeLOC(m_loc.index), keyIndex, dataIndex), context, this);
-
-                codeBlock->pushCode(GetObject(ByteCodeLOC(m_loc.index), elementIndex, keyIndex, valueIndex), context, this);
-                codeBlock->pushCode(ObjectDefineOwnPropertyOperation(ByteCodeLOC(m_loc.index), objIndex, keyIndex, valueIndex, ObjectPropertyDescriptor::AllPresent, false), context, this);
-                codeBlock->pushCode(Jump(ByteCodeLOC(m_loc.index), checkPos), context, this);
-
-                size_t exitPos = codeBlock->currentCodeSize();
-                codeBlock->peekCode<CheckLastEnumerateKey>(checkPos)->m_exitPosition = exitPos;
-
-                // for drop elementIndex, dataIndex, keyIndex, valueIndex
-                context->giveUpRegister();
-                context->giveUpRegister();
-                context->giveUpRegister();
-                context->giveUpRegister();
-
-                codeBlock->peekCode<JumpIfTrue>(pos1)->m_jumpPosition = codeBlock->currentCodeSize();
-                codeBlock->peekCode<JumpIfTrue>(pos2)->m_jumpPosition = codeBlock->currentCodeSize();
+                codeBlock->pushCode(CopyDataProperties(ByteCodeLOC(m_loc.index), objIndex, elementIndex), context, this);
+                context->giveUpRegister(); // for drop elementIndex
             }
 
             codeBlock->m_shouldClearStack = true;
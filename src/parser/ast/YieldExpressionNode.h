@@ -247,7 +247,7 @@ public:
                 codeBlock->pushCode(JumpIfEqual(ByteCodeLOC(m_loc.index), throwTestRegister, awaitStateRegister, false, false), context, this);
 
                 // throw innerResult;
-                codeBlock->pushCode(ThrowOperation(ByteCodeLOC(m_loc.index), returnOrInnerResultRegister), context, this);
+                codeBlock->pushCode(ThrowOperation(ByteCodeLOC(m_loc.index), returnOrInnerResultRegister, context->inTryStatement()), context, this);
                 // }
                 codeBlock->peekCode<JumpIfFalse>(throwTestIsTrueJumpPos)->m_jumpPosition = codeBlock->currentCodeSize();
                 codeBlock->peekCode<JumpIfEqual>(awaitNotReturnsThrowPos)->m_jumpPosition = codeBlock->currentCodeSize();
@@ -398,7 +398,7 @@ public:
                 codeBlock->pushCode(LoadLiteral(ByteCodeLOC(m_loc.index), stateCheckRegister, Value(ExecutionPauser::ResumeState::Throw)), context, this);
                 size_t stateIsNotThrowJumpPos = codeBlock->currentCodeSize();
                 codeBlock->pushCode(JumpIfEqual(ByteCodeLOC(m_loc.index), stateCheckRegister, dstStateRegister, false, false), context, this);
-                codeBlock->pushCode(ThrowOperation(ByteCodeLOC(m_loc.index), dstRegister), context, this);
+                codeBlock->pushCode(ThrowOperation(ByteCodeLOC(m_loc.index), dstRegister, context->inTryStatement()), context, this);
                 codeBlock->peekCode<JumpIfEqual>(stateIsNotThrowJumpPos)->m_jumpPosition = codeBlock->currentCodeSize();
 
                 // Let awaited be Await(resumptionValue.[[Value]]).
@@ -413,7 +413,7 @@ public:
                 codeBlock->pushCode(LoadLiteral(ByteCodeLOC(m_loc.index), stateCheckRegister, Value(ExecutionPauser::ResumeState::Throw)), context, this);
                 stateIsNotThrowJumpPos = codeBlock->currentCodeSize();
                 codeBlock->pushCode(JumpIfEqual(ByteCodeLOC(m_loc.index), stateCheckRegister, dstStateRegister, false, false), context, this);
-                codeBlock->pushCode(ThrowOperation(ByteCodeLOC(m_loc.index), dstRegister), context, this);
+                codeBlock->pushCode(ThrowOperation(ByteCodeLOC(m_loc.index), dstRegister, context->inTryStatement()), context, this);
                 codeBlock->peekCode<JumpIfEqual>(stateIsNotThrowJumpPos)->m_jumpPosition = codeBlock->currentCodeSize();
                 // Assert: awaited.[[Type]] is normal.
                 // Return Completion { [[Type]]: return, [[Value]]: awaited.[[Value]], [[Target]]: empty }.
@@ -150,6 +150,10 @@ public:
     size_t subCodeBlockIndex;
     size_t taggedTemplateExpressionIndex;
 
+    // last child of codeBlock returned by childBlockToSkip and its index
+    InterpretedCodeBlock* skipCursorBlock;
+    size_t skipCursorIndex;
+
     ASTBlockContext* currentBlockContext;
     LexicalBlockIndex lexicalBlockIndex;
     LexicalBlockIndex lexicalBlockCount;
@@ -202,6 +206,8 @@ public:
         this->trackUsingNames = true;
         this->isParsingSingleFunction = false;
         this->codeBlock = nullptr;
+        this->skipCursorBlock = nullptr;
+        this->skipCursorIndex = 0;
 
         this->scanner = &scannerInstance;
         this->sourceType = isModule ? Module : Script;
@@ -447,6 +453,57 @@ public:
         }
     }
 
+    // returns the child of codeBlock at subCodeBlockIndex, or nullptr if there is no such child.
+    // inner functions are skipped in source order, so the walk continues from the previous one
+    // instead of starting from the first child every time
+    InterpretedCodeBlock* childBlockToSkip()
+    {
+        ASSERT(this->isParsingSingleFunction);
+        if (!this->skipCursorBlock || this->subCodeBlockIndex < this->skipCursorIndex) {
+            this->skipCursorBlock = this->codeBlock->firstChild();
+            this->skipCursorIndex = 0;
+        }
+        while (this->skipCursorBlock && this->skipCursorIndex < this->subCodeBlockIndex) {
+            this->skipCursorBlock = this->skipCursorBlock->nextSibling();
+            this->skipCursorIndex++;
+        }
+        return this->skipCursorBlock;
+    }
+
+    // arrow functions begin with their parameters. when an inner arrow function starts at startIndex,
+    // jump over it with the bounds recorded by the first parsing without tokenizing the parameters
+    bool tryToSkipArrowFunctionParsing(size_t startIndex)
+    {
+        if (!this->isParsingSingleFunction) {
+            return false;
+        }
+
+        InterpretedCodeBlock* childBlock = childBlockToSkip();
+        if (!childBlock || !childBlock->isArrowFunctionExpression() || childBlock->functionStart().index != startIndex) {
+            return false;
+        }
+
+        this->context->isAssignmentTarget = false;
+        this->context->isBindingElement = false;
+        skipArrowFunction(childBlock);
+        return true;
+    }
+
+    // moves the scanner to the end of childBlock, an arrow function whose parsing is skipped
+    void skipArrowFunction(InterpretedCodeBlock* childBlock)
+    {
+        this->scanner->index = childBlock->src().length() + childBlock->functionStart().index - this->codeBlock->functionStart().index;
+        this->scanner->lineNumber = childBlock->functionStart().line;
+        this->scanner->lineStart = childBlock->functionStart().index - childBlock->functionStart().column;
+
+        this->lookahead.lineNumber = this->scanner->lineNumber;
+        this->lookahead.lineStart = this->scanner->lineStart;
+        this->nextToken();
+
+        // increase subCodeBlockIndex because parsing of an internal function is skipped
+        this->subCodeBlockIndex++;
+    }
+
     bool tryToSkipFunctionParsing()
     {
         // try to skip the function parsing during the parsing of function call only
@@ -458,7 +515,7 @@ public:
         size_t orgIndex = this->lookahead.start;
         this->expect(LeftParenthesis);
 
-        InterpretedCodeBlock* childBlock = currentTarget->childBlockAt(this->subCodeBlockIndex);
+        InterpretedCodeBlock* childBlock = childBlockToSkip();
         this->scanner->index = childBlock->src().length() + childBlock->functionStart().index - currentTarget->functionStart().index;
 
 #if !(defined NDEBUG) || defined ESCARGOT_DEBUGGER
@@ -2798,6 +2855,10 @@ public:
             MetaNode startNode = this->createNode();
             Marker startMarker = this->lastMarker;
 
+            if (tryToSkipArrowFunctionParsing(startNode.index)) {
+                return this->finalize(this->startNode(startToken), builder.createArrowFunctionExpressionNode(subCodeBlockIndex));
+            }
+
             bool isAsync = false;
             exprNode = this->parseConditionalExpression(builder);
 
@@ -2828,21 +2889,7 @@ public:
                     this->scanner->lineNumber = startMarker.lineNumber;
                     this->scanner->lineStart = startMarker.lineStart;
                     this->nextToken();
-
-                    InterpretedCodeBlock* currentTarget = this->codeBlock;
-                    size_t orgIndex = this->lookahead.start;
-
-                    InterpretedCodeBlock* childBlock = currentTarget->childBlockAt(this->subCodeBlockIndex);
-                    this->scanner->index = childBlock->src().length() + childBlock->functionStart().index - currentTarget->functionStart().index;
-                    this->scanner->lineNumber = childBlock->functionStart().line;
-                    this->scanner->lineStart = childBlock->functionStart().index - childBlock->functionStart().column;
-
-                    this->lookahead.lineNumber = this->scanner->lineNumber;
-                    this->lookahead.lineStart = this->scanner->lineStart;
-                    this->nextToken();
-
-                    // increase subCodeBlockIndex because parsing of an internal function is skipped
-                    this->subCodeBlockIndex++;
+                    skipArrowFunction(childBlockToSkip());
 
                     return this->finalize(this->startNode(startToken), builder.createArrowFunctionExpressionNode(subCodeBlockIndex));
                 }
@@ -66,17 +66,32 @@ ArrayBufferObject::ArrayBufferObject(ExecutionState& state, Object* proto)
     , m_context(state.context())
     , m_data(nullptr)
     , m_bytelength(0)
+    , m_releaseCallback(nullptr)
+    , m_releaseCallbackData(nullptr)
 {
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj,
                                             void*) {
         ArrayBufferObject* self = (ArrayBufferObject*)obj;
-        if (self->m_data) {
-            self->m_context->vmInstance()->platform()->onArrayBufferObjectDataBufferFree(self->m_context, self, self->m_data);
-        }
+        self->releaseData();
     },
                                    nullptr, nullptr, nullptr);
 }
 
+void ArrayBufferObject::releaseData()
+{
+    if (m_data) {
+        if (m_releaseCallback) {
+            m_releaseCallback(m_data, m_bytelength, m_releaseCallbackData);
+        } else {
+            m_context->vmInstance()->platform()->onArrayBufferObjectDataBufferFree(m_context, this, m_data);
+        }
+    }
+    m_data = nullptr;
+    m_bytelength = 0;
+    m_releaseCallback = nullptr;
+    m_releaseCallbackData = nullptr;
+}
+
 void ArrayBufferObject::allocateBuffer(ExecutionState& state, size_t bytelength)
 {
     ASSERT(isDetachedBuffer());
@@ -104,13 +119,18 @@ void ArrayBufferObject::attachBuffer(ExecutionState& state, void* buffer, size_t
     m_bytelength = bytelength;
 }
 
+void ArrayBufferObject::attachExternalBuffer(ExecutionState& state, void* buffer, size_t bytelength, ExternalBufferReleaseCallback releaseCallback, void* callbackData)
+{
+    ASSERT(isDetachedBuffer());
+    m_data = (uint8_t*)buffer;
+    m_bytelength = bytelength;
+    m_releaseCallback = releaseCallback;
+    m_releaseCallbackData = callbackData;
+}
+
 void ArrayBufferObject::detachArrayBuffer(ExecutionState& state)
 {
-    if (m_data) {
-        m_context->vmInstance()->platform()->onArrayBufferObjectDataBufferFree(m_context, this, m_data);
-    }
-    m_data = NULL;
-    m_bytelength = 0;
+    releaseData();
 }
 
 void* ArrayBufferObject::operator new(size_t size)
@@ -50,8 +50,13 @@ public:
 
     static const uint32_t maxArrayBufferSize = 210000000;
 
+    typedef void (*ExternalBufferReleaseCallback)(void* buffer, size_t bytelength, void* callbackData);
+
     void allocateBuffer(ExecutionState& state, size_t bytelength);
     void attachBuffer(ExecutionState& state, void* buffer, size_t bytelength);
+    // the buffer stays owned by the embedder. releaseCallback is called instead of Platform::onArrayBufferObjectDataBufferFree
+    // when the buffer is detached or this object is collected. callbackData is not traced by GC
+    void attachExternalBuffer(ExecutionState& state, void* buffer, size_t bytelength, ExternalBufferReleaseCallback releaseCallback, void* callbackData);
     void detachArrayBuffer(ExecutionState& state);
 
     virtual bool isArrayBufferObject() const
@@ -91,9 +96,13 @@ public:
     void* operator new[](size_t size) = delete;
 
 private:
+    void releaseData();
+
     Context* m_context;
     uint8_t* m_data;
     size_t m_bytelength;
+    ExternalBufferReleaseCallback m_releaseCallback;
+    void* m_releaseCallbackData;
 };
 
 class ArrayBufferView : public Object {
@@ -625,6 +625,78 @@ bool ArrayObject::setIndexedProperty(ExecutionState& state, const Value& propert
     return set(state, ObjectPropertyName(state, property), value, this);
 }
 
+static ALWAYS_INLINE void convertNumber(ExecutionState& state, const Value& v, double& dst)
+{
+    dst = LIKELY(v.isNumber()) ? v.asNumber() : v.toNumber(state);
+}
+
+static ALWAYS_INLINE void convertNumber(ExecutionState& state, const Value& v, int32_t& dst)
+{
+    dst = LIKELY(v.isInt32()) ? v.asInt32() : v.toInt32(state);
+}
+
+template <typename T>
+void ArrayObject::copyNumbersToImpl(ExecutionState& state, T* dst, size_t start, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        size_t idx = start + i;
+        // ToNumber can call user code which changes the array, so the mode is checked for every element
+        if (LIKELY(isFastModeArray() && idx < arrayLength(state))) {
+            Value v = m_fastModeData[idx];
+            if (LIKELY(!v.isEmpty())) {
+                convertNumber(state, v, dst[i]);
+                continue;
+            }
+        }
+        convertNumber(state, getIndexedProperty(state, Value(idx)).value(state, this), dst[i]);
+    }
+}
+
+template <typename T>
+void ArrayObject::copyNumbersFromImpl(ExecutionState& state, const T* src, size_t start, size_t length)
+{
+    if (UNLIKELY(start > SIZE_MAX - length)) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, ErrorObject::Messages::GlobalObject_InvalidArrayLength);
+    }
+
+    // indexes from InvalidArrayIndexValue on are plain property names, so such a range never takes the fast path
+    bool isIndexRange = length <= Value::InvalidArrayIndexValue && start <= Value::InvalidArrayIndexValue - length;
+    size_t end = start + length;
+    if (isIndexRange && isFastModeArray() && end > arrayLength(state) && isExtensible(state)) {
+        setArrayLength(state, (uint32_t)end);
+    }
+
+    if (LIKELY(isIndexRange && isFastModeArray() && end <= arrayLength(state))) {
+        for (size_t i = 0; i < length; i++) {
+            m_fastModeData[start + i] = Value(src[i]);
+        }
+    } else {
+        for (size_t i = 0; i < length; i++) {
+            setIndexedPropertyThrowsException(state, Value(start + i), Value(src[i]));
+        }
+    }
+}
+
+void ArrayObject::copyNumbersTo(ExecutionState& state, double* dst, size_t start, size_t length)
+{
+    copyNumbersToImpl(state, dst, start, length);
+}
+
+void ArrayObject::copyNumbersTo(ExecutionState& state, int32_t* dst, size_t start, size_t length)
+{
+    copyNumbersToImpl(state, dst, start, length);
+}
+
+void ArrayObject::copyNumbersFrom(ExecutionState& state, const double* src, size_t start, size_t length)
+{
+    copyNumbersFromImpl(state, src, start, length);
+}
+
+void ArrayObject::copyNumbersFrom(ExecutionState& state, const int32_t* src, size_t start, size_t length)
+{
+    copyNumbersFromImpl(state, src, start, length);
+}
+
 bool ArrayObject::preventExtensions(ExecutionState& state)
 {
     // first, convert to non-fast-mode.
@@ -39,6 +39,7 @@ class ArrayObject : public Object {
     friend Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget);
     friend void initializeCustomAllocators();
     friend int getValidValueInArrayObject(void* ptr, GC_mark_custom_result* arr);
+    friend class HeapSnapshot;
 
 public:
     explicit ArrayObject(ExecutionState& state);
@@ -90,7 +91,48 @@ public:
         }
     }
 
+    // element at idx of a fast mode array. an empty value is returned when the array is not in fast mode,
+    // idx is out of the length or the element is a hole. then [[HasProperty]] and [[Get]] should be used
+    ALWAYS_INLINE Value fastModeElement(ExecutionState& state, size_t idx)
+    {
+        if (LIKELY(isFastModeArray() && idx < arrayLength(state))) {
+            return m_fastModeData[idx];
+        }
+        return Value(Value::EmptyValue);
+    }
+
+    // CreateDataPropertyOrThrow(this, idx, value). a fast mode array is written directly
+    // and grows by one when idx is its length
+    void defineOwnIndexedPropertyThrowsException(ExecutionState& state, size_t idx, const Value& value)
+    {
+        if (LIKELY(isFastModeArray())) {
+            if (LIKELY(idx < arrayLength(state))) {
+                setFastModeArrayValueWithoutExpanding(state, idx, value);
+                return;
+            }
+            if (idx == arrayLength(state) && idx + 1 < Value::InvalidArrayIndexValue && isLengthPropertyWritable()
+                && setArrayLength(state, (uint32_t)(idx + 1)) && isFastModeArray()) {
+                setFastModeArrayValueWithoutExpanding(state, idx, value);
+                return;
+            }
+        }
+        defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(idx)), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
+    }
+
+    // bulk number access for the embedding API. elements are converted with ToNumber / ToInt32.
+    // a fast mode array is read and written directly. holes, accessors and non fast mode arrays take the generic path
+    void copyNumbersTo(ExecutionState& state, double* dst, size_t start, size_t length);
+    void copyNumbersTo(ExecutionState& state, int32_t* dst, size_t start, size_t length);
+    // the array grows when start + length is larger than its length
+    void copyNumbersFrom(ExecutionState& state, const double* src, size_t start, size_t length);
+    void copyNumbersFrom(ExecutionState& state, const int32_t* src, size_t start, size_t length);
+
 private:
+    template <typename T>
+    void copyNumbersToImpl(ExecutionState& state, T* dst, size_t start, size_t length);
+    template <typename T>
+    void copyNumbersFromImpl(ExecutionState& state, const T* src, size_t start, size_t length);
+
     ALWAYS_INLINE bool isFastModeArray()
     {
         if (UNLIKELY(hasRareData())) {
@@ -320,6 +320,10 @@ void AtomicString::init(AtomicStringMap* ec, String* name)
             } else {
                 name = new UTF16String((const char16_t*)buffer.buffer, buffer.length);
             }
+        } else if (RopeString::isUnflattenedRopeString(name)) {
+            // a rope is hashed and compared without being flattened for the lookup
+            // but an atomic string is compared often, so keep it flat
+            name->bufferAccessData();
         }
         ASSERT(!name->isStringView());
         ec->insert(name);
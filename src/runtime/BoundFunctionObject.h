@@ -25,6 +25,8 @@
 namespace Escargot {
 
 class BoundFunctionObject : public Object {
+    friend class HeapSnapshot;
+
 public:
     BoundFunctionObject(ExecutionState& state, Object* targetFunction, Value& boundThis, size_t boundArgc, Value* boundArgv, const Value& length, const Value& name);
 
@@ -27,6 +27,34 @@
 
 namespace Escargot {
 
+// strings are compressed in chunks of this many bytes, so a range is read by decompressing the chunks it covers
+// even, so that a chunk boundary never splits a 16bit character
+constexpr static const size_t g_compressChunkSize = 64 * 1024;
+
+static size_t chunkRangeByteSize(size_t firstChunk, size_t lastChunk, size_t byteLength)
+{
+    return std::min((lastChunk + 1) * g_compressChunkSize, byteLength) - firstChunk * g_compressChunkSize;
+}
+
+static bool isReferencedFromStack(VMInstance* vmInstance, void* callerSP, const void* buffer)
+{
+#if defined(STACK_GROWS_DOWN)
+    size_t* start = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
+    size_t* end = (size_t*)vmInstance->stackStartAddress();
+#else
+    size_t* start = (size_t*)vmInstance->stackStartAddress();
+    size_t* end = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
+#endif
+
+    while (start != end) {
+        if (UNLIKELY(*start == (size_t)buffer)) {
+            return true;
+        }
+        start++;
+    }
+    return false;
+}
+
 void* CompressibleString::operator new(size_t size)
 {
     static bool typeInited = false;
@@ -46,6 +74,8 @@ CompressibleString::CompressibleString(Context* context)
     , m_isCompressed(false)
     , m_context(context)
     , m_lastUsedTickcount(fastTickCount())
+    , m_queueIndex(SIZE_MAX)
+    , m_queuedTickcount(0)
 {
     m_bufferData.hasSpecialImpl = true;
 
@@ -53,14 +83,19 @@ CompressibleString::CompressibleString(Context* context)
     v.push_back(this);
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
         CompressibleString* self = (CompressibleString*)obj;
-        if (self->isCompressed()) {
-            self->m_compressedData.~CompressedDataVector();
-        } else {
+        size_t bufferSize = self->decomressedBufferSize();
+        if (!self->isCompressed()) {
             deallocateStringDataBuffer(const_cast<void*>(self->m_bufferData.buffer));
         }
+        for (size_t i = 0; i < self->m_decompressedChunks.size(); i++) {
+            deallocateStringDataBuffer(self->m_decompressedChunks[i].m_buffer);
+        }
+        self->m_compressedData.~CompressedDataVector();
+        self->m_decompressedChunks.~DecompressedChunksVector();
 
         if (!self->m_isOwnerMayFreed) {
-            self->m_context->vmInstance()->compressibleStringsUncomressedBufferSize() -= self->decomressedBufferSize();
+            self->m_context->vmInstance()->compressibleStringsUncomressedBufferSize() -= bufferSize;
+            self->m_context->vmInstance()->dequeueCompressibleString(self);
 
             auto& v = self->m_context->vmInstance()->compressibleStrings();
             v.erase(std::find(v.begin(), v.end(), self));
@@ -105,7 +140,62 @@ void CompressibleString::initBufferAccessData(void* data, size_t len, bool is8bi
     m_bufferData.length = len;
     m_bufferData.buffer = data;
 
-    m_context->vmInstance()->compressibleStringsUncomressedBufferSize() += decomressedBufferSize();
+    m_context->vmInstance()->compressibleStringsUncomressedBufferSize() += byteLength();
+    m_context->vmInstance()->queueCompressibleString(this);
+}
+
+size_t CompressibleString::decomressedBufferSize()
+{
+    size_t size = isCompressed() ? 0 : byteLength();
+    for (size_t i = 0; i < m_decompressedChunks.size(); i++) {
+        size += chunkRangeByteSize(m_decompressedChunks[i].m_firstChunk, m_decompressedChunks[i].m_lastChunk, byteLength());
+    }
+    return size;
+}
+
+StringBufferAccessData CompressibleString::rangeBufferAccessData(size_t start, size_t end)
+{
+    ASSERT(start <= end && end <= m_bufferData.length);
+    m_lastUsedTickcount = fastTickCount();
+
+    bool has8Bit = m_bufferData.has8BitContent;
+    size_t charSize = has8Bit ? sizeof(LChar) : sizeof(char16_t);
+    if (!isCompressed()) {
+        char* buffer = const_cast<char*>(m_bufferData.bufferAs8Bit);
+        return StringBufferAccessData(has8Bit, end - start, buffer + start * charSize, buffer);
+    }
+
+    size_t firstChunk = std::min(start * charSize / g_compressChunkSize, m_compressedData.size() - 1);
+    size_t lastChunk = end > start ? (end * charSize - 1) / g_compressChunkSize : firstChunk;
+
+    for (size_t i = 0; i < m_decompressedChunks.size(); i++) {
+        const DecompressedChunks& chunks = m_decompressedChunks[i];
+        if (chunks.m_firstChunk <= firstChunk && lastChunk <= chunks.m_lastChunk) {
+            char* buffer = chunks.m_buffer;
+            return StringBufferAccessData(has8Bit, end - start, buffer + start * charSize - chunks.m_firstChunk * g_compressChunkSize, buffer);
+        }
+    }
+
+    size_t byteSize = chunkRangeByteSize(firstChunk, lastChunk, byteLength());
+    VMInstance* vmInstance = m_context->vmInstance();
+    if (decomressedBufferSize() + byteSize >= byteLength()) {
+        // the ranges read so far would take as much memory as the whole string
+        decompress();
+        return rangeBufferAccessData(start, end);
+    }
+
+    uint64_t startTime = longTickCount();
+    char* buffer = (char*)allocateStringDataBuffer(byteSize);
+    decompressChunks(firstChunk, lastChunk, buffer);
+    m_decompressedChunks.push_back({ firstChunk, lastChunk, buffer });
+    vmInstance->compressibleStringsUncomressedBufferSize() += byteSize;
+
+    vmInstance->compressibleStringStatistics().m_decompressionCount++;
+    vmInstance->compressibleStringStatistics().m_decompressedBytes += byteSize;
+    vmInstance->compressibleStringStatistics().m_decompressionTime += longTickCount() - startTime;
+    vmInstance->queueCompressibleString(this);
+
+    return StringBufferAccessData(has8Bit, end - start, buffer + start * charSize - firstChunk * g_compressChunkSize, buffer);
 }
 
 UTF8StringDataNonGCStd CompressibleString::toNonGCUTF8StringData(int options) const
@@ -138,6 +228,11 @@ void* CompressibleString::allocateStringDataBuffer(size_t byteLength)
     return malloc(byteLength);
 }
 
+void* CompressibleString::reallocateStringDataBuffer(void* ptr, size_t byteLength)
+{
+    return realloc(ptr, byteLength);
+}
+
 void CompressibleString::deallocateStringDataBuffer(void* ptr)
 {
     free(ptr);
@@ -145,17 +240,44 @@ void CompressibleString::deallocateStringDataBuffer(void* ptr)
 
 bool CompressibleString::compress()
 {
-    ASSERT(!m_isCompressed);
+    bool released = releaseDecompressedChunks(currentStackPointer());
+    if (m_isCompressed) {
+        return released;
+    }
     if (UNLIKELY(!m_bufferData.length)) {
         return false;
     }
 
     bool has8Bit = m_bufferData.has8BitContent;
+    bool compressed;
     if (has8Bit) {
-        return compressWorker<LChar>(currentStackPointer());
+        compressed = compressWorker<LChar>(currentStackPointer());
     } else {
-        return compressWorker<char16_t>(currentStackPointer());
+        compressed = compressWorker<char16_t>(currentStackPointer());
     }
+    return compressed && released;
+}
+
+bool CompressibleString::releaseDecompressedChunks(void* callerSP)
+{
+    VMInstance* vmInstance = m_context->vmInstance();
+    size_t keptCount = 0;
+    for (size_t i = 0; i < m_decompressedChunks.size(); i++) {
+        DecompressedChunks chunks = m_decompressedChunks[i];
+        if (isReferencedFromStack(vmInstance, callerSP, chunks.m_buffer)) {
+            m_decompressedChunks[keptCount++] = chunks;
+            continue;
+        }
+        vmInstance->compressibleStringsUncomressedBufferSize() -= chunkRangeByteSize(chunks.m_firstChunk, chunks.m_lastChunk, byteLength());
+        deallocateStringDataBuffer(chunks.m_buffer);
+    }
+
+    if (keptCount) {
+        m_decompressedChunks.resize(keptCount);
+        return false;
+    }
+    DecompressedChunksVector().swap(m_decompressedChunks);
+    return true;
 }
 
 void CompressibleString::decompress()
@@ -163,16 +285,21 @@ void CompressibleString::decompress()
     ASSERT(m_isCompressed);
     ASSERT(m_bufferData.length);
 
+    uint64_t startTime = longTickCount();
     bool has8Bit = m_bufferData.has8BitContent;
     if (has8Bit) {
         decompressWorker<LChar>();
     } else {
         decompressWorker<char16_t>();
     }
-}
 
-constexpr static const size_t g_compressChunkSize = 1044465;
-static_assert(LZ4_COMPRESSBOUND(g_compressChunkSize) == 1024 * 1024, "");
+    VMInstance* vmInstance = m_context->vmInstance();
+    vmInstance->compressibleStringStatistics().m_decompressionCount++;
+    vmInstance->compressibleStringStatistics().m_decompressedBytes += byteLength();
+    vmInstance->compressibleStringStatistics().m_decompressionTime += longTickCount() - startTime;
+    // it can get cold again
+    vmInstance->queueCompressibleString(this);
+}
 
 template <typename StringType>
 bool CompressibleString::compressWorker(void* callerSP)
@@ -180,20 +307,9 @@ bool CompressibleString::compressWorker(void* callerSP)
     ASSERT(!m_isCompressed);
     ASSERT(m_bufferData.length > 0);
 
-#if defined(STACK_GROWS_DOWN)
-    size_t* start = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
-    size_t* end = (size_t*)m_context->vmInstance()->stackStartAddress();
-#else
-    size_t* start = (size_t*)m_context->vmInstance()->stackStartAddress();
-    size_t* end = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
-#endif
-
-    while (start != end) {
-        if (UNLIKELY(*start == (size_t)m_bufferData.buffer)) {
-            // if there is reference on stack, we cannot compress string.
-            return false;
-        }
-        start++;
+    if (isReferencedFromStack(m_context->vmInstance(), callerSP, m_bufferData.buffer)) {
+        // if there is reference on stack, we cannot compress string.
+        return false;
     }
 
     size_t originByteLength = m_bufferData.length * sizeof(StringType);
@@ -210,6 +326,7 @@ bool CompressibleString::compressWorker(void* callerSP)
         int compressedLength = LZ4::LZ4_compress_default(m_bufferData.bufferAs8Bit + srcIndex, (char*)compBuffer.get(), srcSize, boundLength);
         if (!compressedLength) {
             // compression fail
+            CompressedDataVector().swap(m_compressedData);
             return false;
         }
 
@@ -217,7 +334,7 @@ bool CompressibleString::compressWorker(void* callerSP)
         m_compressedData.push_back(std::vector<char>(compBuffer.get(), compBuffer.get() + compressedLength));
     }
 
-    m_context->vmInstance()->compressibleStringsUncomressedBufferSize() -= decomressedBufferSize();
+    m_context->vmInstance()->compressibleStringsUncomressedBufferSize() -= byteLength();
 
     // immediately free the original string after compression when there is no reference on stack
     deallocateStringDataBuffer(const_cast<void*>(m_bufferData.buffer));
@@ -236,26 +353,36 @@ void CompressibleString::decompressWorker()
     size_t originByteLength = m_bufferData.length * sizeof(StringType);
 
     char* dstBuffer = (char*)allocateStringDataBuffer(originByteLength);
-    int dstIndex = 0;
+    decompressChunks(0, m_compressedData.size() - 1, dstBuffer);
 
-    for (size_t srcIndex = 0, bufIndex = 0; srcIndex < originByteLength; srcIndex += g_compressChunkSize, bufIndex++) {
-        int srcSize = (int)std::min(g_compressChunkSize, originByteLength - srcIndex);
+    CompressedDataVector().swap(m_compressedData);
+
+    m_bufferData.bufferAs8Bit = const_cast<const char*>(dstBuffer);
+    m_isCompressed = false;
+
+    m_context->vmInstance()->compressibleStringsUncomressedBufferSize() += originByteLength;
+
+    // ranges are read from the whole buffer from now on. chunks still referenced from the stack go at the next compression
+    releaseDecompressedChunks(currentStackPointer());
+}
 
-        int decompressedLength = LZ4::LZ4_decompress_safe(m_compressedData[bufIndex].data(), dstBuffer + dstIndex, m_compressedData[bufIndex].size(), srcSize);
-        if (!decompressedLength) {
+void CompressibleString::decompressChunks(size_t firstChunk, size_t lastChunk, char* dstBuffer)
+{
+    ASSERT(m_isCompressed);
+    ASSERT(firstChunk <= lastChunk && lastChunk < m_compressedData.size());
+
+    size_t originByteLength = byteLength();
+    for (size_t bufIndex = firstChunk; bufIndex <= lastChunk; bufIndex++) {
+        int srcSize = (int)std::min(g_compressChunkSize, originByteLength - bufIndex * g_compressChunkSize);
+
+        int decompressedLength = LZ4::LZ4_decompress_safe(m_compressedData[bufIndex].data(), dstBuffer, m_compressedData[bufIndex].size(), srcSize);
+        if (decompressedLength != srcSize) {
             // decompress fail
             RELEASE_ASSERT_NOT_REACHED();
         }
 
-        dstIndex += srcSize;
+        dstBuffer += srcSize;
     }
-
-    CompressedDataVector().swap(m_compressedData);
-
-    m_bufferData.bufferAs8Bit = const_cast<const char*>(dstBuffer);
-    m_isCompressed = false;
-
-    m_context->vmInstance()->compressibleStringsUncomressedBufferSize() += decomressedBufferSize();
 }
 }
 
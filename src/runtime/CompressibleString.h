@@ -75,11 +75,17 @@ public:
         return m_isCompressed;
     }
 
+    // returns the characters of [start, end) only. while the string is compressed,
+    // just the chunks covering the range are decompressed and kept until the string gets cold again.
+    // extraData of the result is the buffer holding the characters, to keep it referenced from the stack
+    StringBufferAccessData rangeBufferAccessData(size_t start, size_t end);
+
     void* operator new(size_t);
     void* operator new[](size_t) = delete;
     void operator delete[](void*) = delete;
 
     static void* allocateStringDataBuffer(size_t byteLength);
+    static void* reallocateStringDataBuffer(void* ptr, size_t byteLength);
     static void deallocateStringDataBuffer(void* ptr);
 
     bool compress();
@@ -90,26 +96,39 @@ private:
 
     void initBufferAccessData(void* data, size_t len, bool is8bit);
 
-    size_t decomressedBufferSize()
+    size_t byteLength()
     {
-        if (isCompressed()) {
-            return 0;
-        } else {
-            return m_bufferData.length * (m_bufferData.has8BitContent ? 1 : 2);
-        }
+        return m_bufferData.length * (m_bufferData.has8BitContent ? 1 : 2);
     }
 
+    // the whole buffer unless compressed, and the chunks decompressed for ranges
+    size_t decomressedBufferSize();
+
     template <typename StringType>
     NEVER_INLINE bool compressWorker(void* callerSP);
     template <typename StringType>
     NEVER_INLINE void decompressWorker();
+    void decompressChunks(size_t firstChunk, size_t lastChunk, char* dstBuffer);
+    NEVER_INLINE bool releaseDecompressedChunks(void* callerSP);
 
     bool m_isOwnerMayFreed;
     bool m_isCompressed;
     Context* m_context;
     uint64_t m_lastUsedTickcount;
+    // position in VMInstance::m_compressibleStringQueue. SIZE_MAX if not queued
+    size_t m_queueIndex;
+    uint64_t m_queuedTickcount;
     typedef std::vector<std::vector<char>> CompressedDataVector;
     CompressedDataVector m_compressedData;
+
+    struct DecompressedChunks {
+        size_t m_firstChunk;
+        size_t m_lastChunk;
+        char* m_buffer;
+    };
+    typedef std::vector<DecompressedChunks> DecompressedChunksVector;
+    // chunks decompressed by rangeBufferAccessData while the string is compressed
+    DecompressedChunksVector m_decompressedChunks;
 };
 }
 
@@ -82,6 +82,8 @@ Context::Context(VMInstance* instance)
     , m_debugger(nullptr)
 #endif /* ESCARGOT_DEBUGGER */
 {
+    instance->registerContext(this);
+
     ExecutionState stateForInit(this);
     m_globalObjectProxy = m_globalObject = new GlobalObject(stateForInit);
     m_globalObject->installBuiltins(stateForInit);
@@ -86,24 +86,49 @@ class Context : public gc {
 
 public:
     struct RegExpStatus {
+        // RegExp.lastMatch, lastParen, leftContext, rightContext and $1-$9 are only created on access
+        // from the input and the capture offsets of the last successful match
+        static const unsigned NotMatched = std::numeric_limits<unsigned>::max();
+
         String* input; // RegExp.input ($_)
-        StringView lastMatch;
-        StringView lastParen;
-        StringView leftContext;
-        StringView rightContext;
+        String* matchedInput; // nullptr until something matches
         size_t dollarCount;
-        StringView dollars[9]; // RegExp.$1-$9
+        unsigned lastParen[2];
+        unsigned captures[10 * 2]; // start and end of the whole match followed by $1-$9
 
         RegExpStatus()
             : input(String::emptyString)
-            , lastMatch()
-            , lastParen()
-            , leftContext()
-            , rightContext()
+            , matchedInput(nullptr)
             , dollarCount(0)
         {
-            for (size_t i = 0; i < 9; i++) {
-                dollars[i] = StringView();
+            lastParen[0] = lastParen[1] = NotMatched;
+            for (size_t i = 0; i < 10 * 2; i++) {
+                captures[i] = NotMatched;
+            }
+        }
+
+        // records a match. output holds (start, end) pairs for the whole match and subpatternCount subpatterns
+        // a failed match changes nothing, RegExp.input included
+        void update(String* str, const unsigned* output, unsigned subpatternCount)
+        {
+            input = str;
+            matchedInput = str;
+            unsigned maxMatchedIndex = subpatternCount;
+            while (maxMatchedIndex > 0 && output[maxMatchedIndex * 2] == NotMatched) {
+                maxMatchedIndex--;
+            }
+            dollarCount = maxMatchedIndex;
+            // lastParen is only kept when the last subpattern participated in the match
+            if (subpatternCount && maxMatchedIndex == subpatternCount) {
+                lastParen[0] = output[maxMatchedIndex * 2];
+                lastParen[1] = output[maxMatchedIndex * 2 + 1];
+            } else {
+                lastParen[0] = lastParen[1] = NotMatched;
+            }
+            unsigned captureEnd = std::min(maxMatchedIndex, 9u);
+            for (unsigned i = 0; i <= captureEnd; i++) {
+                captures[i * 2] = output[i * 2];
+                captures[i * 2 + 1] = output[i * 2 + 1];
             }
         }
     };
@@ -130,7 +155,7 @@ public:
         return *m_scriptParser;
     }
 
-    RegExpCacheMap* regexpCache()
+    RegExpCache* regexpCache()
     {
         return m_regexpCache;
     }
@@ -303,7 +328,7 @@ private:
     GlobalVariableAccessCache* m_globalVariableAccessCache;
     LoadedModuleVector* m_loadedModules;
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
-    RegExpCacheMap* m_regexpCache;
+    RegExpCache* m_regexpCache;
 
     ObjectStructure* m_defaultStructureForObject;
     ObjectStructure* m_defaultStructureForFunctionObject;
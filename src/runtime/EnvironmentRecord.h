@@ -393,6 +393,8 @@ public:
 };
 
 class DeclarativeEnvironmentRecordIndexed : public DeclarativeEnvironmentRecord {
+    friend class HeapSnapshot;
+
 public:
     DeclarativeEnvironmentRecordIndexed(ExecutionState& state, InterpretedCodeBlock::BlockInfo* blockInfo)
         : DeclarativeEnvironmentRecord()
@@ -549,6 +551,7 @@ private:
 // NOTE
 // DeclarativeEnvironmentRecordNotIndexed record does not create binding self likes FunctionEnvironmentRecord
 class DeclarativeEnvironmentRecordNotIndexed : public DeclarativeEnvironmentRecord {
+    friend class HeapSnapshot;
 #ifdef ESCARGOT_DEBUGGER
     friend class Debugger;
 #endif /* ESCARGOT_DEBUGGER */
@@ -1107,6 +1110,7 @@ public:
 };
 
 class ModuleEnvironmentRecord : public DeclarativeEnvironmentRecord {
+    friend class HeapSnapshot;
 #ifdef ESCARGOT_DEBUGGER
     friend class Debugger;
 #endif /* ESCARGOT_DEBUGGER */
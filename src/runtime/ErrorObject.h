@@ -154,8 +154,10 @@ public:
         };
     };
     struct StackTraceNonGCData {
+        // SIZE_MAX means infoString is shown as it is, NativeFunctionFrame means infoString is the name of a native function
         size_t byteCodePosition;
     };
+    static const size_t NativeFunctionFrame = SIZE_MAX - 1;
     struct StackTraceData : public gc {
         TightVector<StackTraceGCData, GCUtil::gc_malloc_allocator<StackTraceGCData>> gcValues;
         TightVector<StackTraceNonGCData, GCUtil::gc_malloc_atomic_allocator<StackTraceNonGCData>> nonGCValues;
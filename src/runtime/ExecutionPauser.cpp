@@ -50,6 +50,7 @@ void* ExecutionPauser::operator new(size_t size)
         GC_set_bit(desc, GC_WORD_OFFSET(ExecutionPauser, m_promiseCapability.m_promise));
         GC_set_bit(desc, GC_WORD_OFFSET(ExecutionPauser, m_promiseCapability.m_resolveFunction));
         GC_set_bit(desc, GC_WORD_OFFSET(ExecutionPauser, m_promiseCapability.m_rejectFunction));
+        GC_set_bit(desc, GC_WORD_OFFSET(ExecutionPauser, m_pauseValue));
         descr = GC_make_descriptor(desc, GC_WORD_LEN(ExecutionPauser));
         typeInited = true;
     }
@@ -66,6 +67,8 @@ ExecutionPauser::ExecutionPauser(ExecutionState& state, Object* sourceObject, Ex
     , m_resumeByteCodePosition(SIZE_MAX)
     , m_resumeValueIndex(REGISTER_LIMIT)
     , m_resumeStateIndex(REGISTER_LIMIT)
+    , m_isPausing(false)
+    , m_pauseReason(PauseReason::Yield)
 {
 }
 
@@ -134,9 +137,11 @@ Value ExecutionPauser::start(ExecutionState& state, ExecutionPauser* self, Objec
     // https://www.ecma-international.org/ecma-262/10.0/index.html#sec-asyncgeneratorstart
 
     Value result;
+    bool isPaused = false;
     try {
         ExecutionState* es;
         size_t startPos = self->m_byteCodePosition;
+        bool needsReturn = false;
         if (startPos == SIZE_MAX) {
             // need to fresh start
             startPos = 0;
@@ -146,6 +151,18 @@ Value ExecutionPauser::start(ExecutionState& state, ExecutionPauser* self, Objec
             if (from == StartFrom::Async) {
                 self->m_promiseCapability = PromiseObject::newPromiseCapability(state, state.context()->globalObject()->promise());
             }
+        } else if (self->m_resumeByteCodePosition == SIZE_MAX) {
+            // resume directly. we paused outside of every recursive statement so the saved ExecutionState is the function's one
+            ASSERT(self->m_executionState == originalState);
+            es = self->m_executionState;
+            if (self->m_resumeStateIndex == REGISTER_LIMIT) {
+                // same as what ExecutionResume does
+                if (isAbruptReturn) {
+                    needsReturn = true;
+                } else if (isAbruptThrow) {
+                    es->throwException(resumeValue);
+                }
+            }
         } else {
             // resume
             startPos = self->m_extraDataByteCodePosition;
@@ -158,39 +175,31 @@ Value ExecutionPauser::start(ExecutionState& state, ExecutionPauser* self, Objec
                                                              );
             es = new ExecutionState(&state, env, false);
         }
-        result = ByteCodeInterpreter::interpret(es, self->m_byteCodeBlock, startPos, self->m_registerFile);
-        // normal return means execution end
-        if (from == StartFrom::Generator) {
-            source->asGeneratorObject()->m_generatorState = GeneratorObject::GeneratorState::CompletedReturn;
-            result = IteratorObject::createIterResultObject(state, result, true);
-        } else if (from == StartFrom::AsyncGenerator) {
-            source->asAsyncGeneratorObject()->m_asyncGeneratorState = AsyncGeneratorObject::Completed;
-            result = AsyncGeneratorObject::asyncGeneratorResolve(state, source->asAsyncGeneratorObject(), result, true);
+        if (UNLIKELY(needsReturn)) {
+            result = resumeValue;
         } else {
-            ASSERT(from == StartFrom::Async);
-            Value argv = result;
-            Object::call(state, self->m_promiseCapability.m_resolveFunction, Value(), 1, &argv);
-            result = self->m_promiseCapability.m_promise;
-        }
-        self->release();
-    } catch (PauseValue* exitValue) {
-        result = exitValue->m_value;
-        auto pauseReason = exitValue->m_pauseReason;
-        delete exitValue;
-
-        if (pauseReason == ExecutionPauser::PauseReason::GeneratorsInitialize) {
-            return result;
+            result = ByteCodeInterpreter::interpret(es, self->m_byteCodeBlock, startPos, self->m_registerFile);
         }
 
-        if (from == StartFrom::Generator) {
-            if (source->asGeneratorObject()->m_generatorState >= GeneratorObject::GeneratorState::CompletedReturn) {
-                return IteratorObject::createIterResultObject(state, result, true);
+        if (self->m_isPausing) {
+            // paused by yield or await
+            self->m_isPausing = false;
+            isPaused = true;
+        } else {
+            // normal return means execution end
+            if (from == StartFrom::Generator) {
+                source->asGeneratorObject()->m_generatorState = GeneratorObject::GeneratorState::CompletedReturn;
+                result = IteratorObject::createIterResultObject(state, result, true);
+            } else if (from == StartFrom::AsyncGenerator) {
+                source->asAsyncGeneratorObject()->m_asyncGeneratorState = AsyncGeneratorObject::Completed;
+                result = AsyncGeneratorObject::asyncGeneratorResolve(state, source->asAsyncGeneratorObject(), result, true);
+            } else {
+                ASSERT(from == StartFrom::Async);
+                Value argv = result;
+                Object::call(state, self->m_promiseCapability.m_resolveFunction, Value(), 1, &argv);
+                result = self->m_promiseCapability.m_promise;
             }
-            return result;
-        } else if (from == StartFrom::Async) {
-            // https://www.ecma-international.org/ecma-262/10.0/index.html#sec-async-functions-abstract-operations-async-function-start
-            // Return Completion { [[Type]]: return, [[Value]]: promiseCapability.[[Promise]], [[Target]]: empty }.
-            result = self->m_promiseCapability.m_promise;
+            self->release();
         }
     } catch (const Value& thrownValue) {
         auto promiseCapability = self->m_promiseCapability;
@@ -216,6 +225,26 @@ Value ExecutionPauser::start(ExecutionState& state, ExecutionPauser* self, Objec
         }
     }
 
+    if (isPaused) {
+        result = self->m_pauseValue;
+        self->m_pauseValue = EncodedValue();
+
+        if (self->m_pauseReason == ExecutionPauser::PauseReason::GeneratorsInitialize) {
+            return result;
+        }
+
+        if (from == StartFrom::Generator) {
+            if (source->asGeneratorObject()->m_generatorState >= GeneratorObject::GeneratorState::CompletedReturn) {
+                return IteratorObject::createIterResultObject(state, result, true);
+            }
+            return result;
+        } else if (from == StartFrom::Async) {
+            // https://www.ecma-international.org/ecma-262/10.0/index.html#sec-async-functions-abstract-operations-async-function-start
+            // Return Completion { [[Type]]: return, [[Value]]: promiseCapability.[[Promise]], [[Target]]: empty }.
+            result = self->m_promiseCapability.m_promise;
+        }
+    }
+
     return result;
 }
 
@@ -255,7 +284,10 @@ void ExecutionPauser::pause(ExecutionState& state, Value returnValue, size_t tai
     originalState->rareData()->m_parent = nullptr;
 
     // some case(async generator), the function execution ended before pause
-    if (self->m_byteCodeBlock) {
+    // if we are not in any recursive statement, start() can continue on the saved ExecutionState without ExecutionResume
+    // otherwise the interpret() frames of the recursive statements are gone once we return,
+    // so resume code rebuilding them is still appended to m_code here and ExecutionResume removes it again
+    if (self->m_byteCodeBlock && tailDataLength) {
         // read & fill recursive statement self
         char* start = (char*)(tailDataPosition);
         char* end = (char*)(start + tailDataLength);
@@ -323,12 +355,12 @@ void ExecutionPauser::pause(ExecutionState& state, Value returnValue, size_t tai
             self->m_byteCodeBlock->m_code.resizeWithUninitializedValues(pos + sizeof(size_t));
             new (self->m_byteCodeBlock->m_code.data() + pos) size_t(codeStartPositions[i]);
         }
+    } else {
+        self->m_resumeByteCodePosition = SIZE_MAX;
     }
 
-    PauseValue* exitValue = new PauseValue();
-    exitValue->m_value = returnValue;
-    exitValue->m_pauseReason = (ExecutionPauser::PauseReason)reason;
-
-    throw exitValue;
+    self->m_pauseValue = returnValue;
+    self->m_pauseReason = reason;
+    self->m_isPausing = true;
 }
 }
@@ -32,6 +32,7 @@ public:
     friend class GeneratorObject;
     friend class AsyncGeneratorObject;
     friend class ByteCodeInterpreter;
+    friend class HeapSnapshot;
 
     ExecutionPauser(ExecutionState& state, Object* sourceObject, ExecutionState* executionState, Value* registerFile, ByteCodeBlock* blk);
 
@@ -47,19 +48,6 @@ public:
         Return
     };
 
-    // yield is implemented throw this type of by this class
-    // we cannot use normal return logic because we must not modify ExecutionState(some statements(block,with..) needs modifying control flow data for exit function)
-    struct PauseValue : public gc {
-        PauseReason m_pauseReason;
-        Value m_value;
-
-        void* operator new(size_t size)
-        {
-            // we MUST use uncollectable malloc. bdwgc cannot track thrown value
-            return GC_MALLOC_UNCOLLECTABLE(size);
-        }
-    };
-
     void release()
     {
         m_executionState = nullptr;
@@ -88,6 +76,11 @@ public:
         return m_sourceObject;
     }
 
+    bool isPausing() const
+    {
+        return m_isPausing;
+    }
+
 private:
     ExecutionState* m_executionState;
     Object* m_sourceObject;
@@ -100,6 +93,12 @@ private:
     ByteCodeRegisterIndex m_resumeValueIndex;
     ByteCodeRegisterIndex m_resumeStateIndex;
     PromiseReaction::Capability m_promiseCapability; // async function needs this
+    // pause() leaves its result here and returns instead of throwing.
+    // every interpret() frame of the enclosing recursive statements(block, with, try..) returns without touching
+    // ExecutionState or control flow data while m_isPausing is set, and start() takes the result
+    bool m_isPausing;
+    PauseReason m_pauseReason;
+    EncodedValue m_pauseValue;
 };
 }
 
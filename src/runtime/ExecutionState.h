@@ -70,6 +70,8 @@ public:
         , m_inStrictMode(false)
         , m_inTryStatement(false)
         , m_isNativeFunctionObjectExecutionContext(false)
+        , m_mayPassPendingException(false)
+        , m_calleeMayPassPendingException(false)
         , m_argc(0)
         , m_argv(nullptr)
     {
@@ -93,6 +95,8 @@ public:
         , m_inStrictMode(inStrictMode)
         , m_inTryStatement(false)
         , m_isNativeFunctionObjectExecutionContext(false)
+        , m_mayPassPendingException(false)
+        , m_calleeMayPassPendingException(false)
         , m_argc(parent->argc())
         , m_argv(parent->argv())
     {
@@ -108,6 +112,8 @@ public:
         , m_inStrictMode(false)
         , m_inTryStatement(false)
         , m_isNativeFunctionObjectExecutionContext(false)
+        , m_mayPassPendingException(false)
+        , m_calleeMayPassPendingException(false)
         , m_argc(0)
         , m_argv(nullptr)
     {
@@ -123,6 +129,8 @@ public:
         , m_inStrictMode(inStrictMode)
         , m_inTryStatement(false)
         , m_isNativeFunctionObjectExecutionContext(false)
+        , m_mayPassPendingException(false)
+        , m_calleeMayPassPendingException(false)
         , m_argc(argc)
         , m_argv(argv)
     {
@@ -138,6 +146,8 @@ public:
         , m_inStrictMode(inStrictMode)
         , m_inTryStatement(false)
         , m_isNativeFunctionObjectExecutionContext(true)
+        , m_mayPassPendingException(false)
+        , m_calleeMayPassPendingException(false)
         , m_argc(argc)
         , m_argv(argv)
     {
@@ -156,6 +166,8 @@ public:
         , m_inStrictMode(inStrictMode)
         , m_inTryStatement(false)
         , m_isNativeFunctionObjectExecutionContext(false)
+        , m_mayPassPendingException(false)
+        , m_calleeMayPassPendingException(false)
         , m_argc(argc)
         , m_argv(argv)
     {
@@ -238,6 +250,11 @@ public:
         return m_inTryStatement;
     }
 
+    bool mayPassPendingException()
+    {
+        return m_mayPassPendingException;
+    }
+
     // callee is pauser && isNotInEvalCode
     bool inPauserScope();
 
@@ -297,10 +314,17 @@ private:
     bool m_inStrictMode : 1;
     bool m_inTryStatement : 1;
     bool m_isNativeFunctionObjectExecutionContext : 1;
+    // an exception thrown in this state can be set as pending exception of SandBox instead of a C++ exception,
+    // because every interpret() frame up to its handler returns right after it sees the pending exception.
+    // set by the try body of tryOperation, copied to block and with states,
+    // and given to a function called directly by a call opcode of such a state
+    bool m_mayPassPendingException : 1;
+    // set by a call opcode right before it calls a ScriptFunctionObject. processCall clears it on entry
+    bool m_calleeMayPassPendingException : 1;
 #ifdef ESCARGOT_32
-    size_t m_argc : 28;
+    size_t m_argc : 26;
 #else
-    size_t m_argc : 60;
+    size_t m_argc : 58;
 #endif
     Value* m_argv;
 };
@@ -141,6 +141,53 @@ protected:
 
     CodeBlock* m_codeBlock;
 };
+
+class ByteCodeBlock;
+
+// Calls one callee repeatedly from a native loop, e.g. the callbackfn of Array.prototype.map.
+// The callee is resolved on the first call. When it is a plain or arrow script function whose environment
+// is allocated on stack, every call reuses its ByteCodeBlock and one register file which already has the numeral literals.
+// Other callees and a nested call of the same PreparedFunctionCall go through Object::call.
+// This should be allocated on stack (it keeps GC pointers)
+class PreparedFunctionCall {
+public:
+    explicit PreparedFunctionCall(const Value& callee)
+        : m_callee(callee)
+        , m_function(nullptr)
+        , m_byteCodeBlock(nullptr)
+        , m_registerFile(nullptr)
+        , m_isPrepared(false)
+        , m_isArrowFunction(false)
+        , m_isRunning(false)
+    {
+    }
+
+    ~PreparedFunctionCall();
+
+    Value call(ExecutionState& state, const Value& thisValue, const size_t argc, NULLABLE Value* argv)
+    {
+        if (LIKELY(m_registerFile != nullptr && !m_isRunning)) {
+            return callPrepared(state, thisValue, argc, argv);
+        }
+        return callSlowCase(state, thisValue, argc, argv);
+    }
+
+private:
+    PreparedFunctionCall(const PreparedFunctionCall&) = delete;
+    PreparedFunctionCall& operator=(const PreparedFunctionCall&) = delete;
+
+    void prepare(ExecutionState& state);
+    Value callPrepared(ExecutionState& state, const Value& thisValue, const size_t argc, NULLABLE Value* argv);
+    Value callSlowCase(ExecutionState& state, const Value& thisValue, const size_t argc, NULLABLE Value* argv);
+
+    Value m_callee;
+    ScriptFunctionObject* m_function;
+    ByteCodeBlock* m_byteCodeBlock;
+    Value* m_registerFile;
+    bool m_isPrepared;
+    bool m_isArrowFunction;
+    bool m_isRunning;
+};
 }
 
 #endif
@@ -91,6 +91,11 @@ public:
     template <typename FunctionObjectType, bool isConstructCall, bool hasNewTargetOnEnvironment, bool canBindThisValueOnEnvironment, typename ThisValueBinder, typename NewTargetBinder, typename ReturnValueBinder>
     static ALWAYS_INLINE Value processCall(ExecutionState& state, FunctionObjectType* self, const Value& thisArgument, const size_t argc, Value* argv, Object* newTarget) // newTarget is null on [[call]]
     {
+        // the calling opcode returns right after the call if there is a pending exception.
+        // take it before anything here can call another function with the same state
+        bool mayPassPendingException = state.m_calleeMayPassPendingException;
+        state.m_calleeMayPassPendingException = false;
+
         volatile int sp;
         size_t currentStackBase = (size_t)&sp;
 #ifdef STACK_GROWS_DOWN
@@ -227,6 +232,10 @@ public:
             newState->setPauseSource(new ExecutionPauser(state, self, newState, registerFile, blk));
         } else {
             newState = new (alloca(sizeof(ExecutionState))) ExecutionState(ctx, &state, lexEnv, argc, argv, isStrict);
+            // only [[Call]] of a normal or arrow function returns the interpreter result as it is
+            if (!isConstructCall && (std::is_same<FunctionObjectType, ScriptFunctionObject>::value || std::is_same<FunctionObjectType, ScriptArrowFunctionObject>::value)) {
+                newState->m_mayPassPendingException = mayPassPendingException;
+            }
         }
 
         // prepare receiver(this variable)
@@ -253,6 +262,69 @@ public:
 
         return returnValue;
     }
+
+    // generates ByteCodeBlock of self if needed. used by PreparedFunctionCall
+    static ByteCodeBlock* ensureByteCodeBlock(ExecutionState& state, ScriptFunctionObject* self)
+    {
+        InterpretedCodeBlock* codeBlock = self->interpretedCodeBlock();
+        if (UNLIKELY(codeBlock->byteCodeBlock() == nullptr)) {
+            self->generateByteCodeBlock(state);
+        }
+        return codeBlock->byteCodeBlock();
+    }
+
+    // [[Call]] of PreparedFunctionCall. same as processCall of a non-constructor call whose environment is allocated on stack,
+    // except that registerFile is prepared by the caller and already has the numeral literals of blk
+    template <typename FunctionObjectType, typename ThisValueBinder>
+    static ALWAYS_INLINE Value processPreparedCall(ExecutionState& state, FunctionObjectType* self, ByteCodeBlock* blk, Value* registerFile, const Value& thisArgument, const size_t argc, Value* argv)
+    {
+        volatile int sp;
+        size_t currentStackBase = (size_t)&sp;
+#ifdef STACK_GROWS_DOWN
+        if (UNLIKELY(state.stackLimit() > currentStackBase)) {
+#else
+        if (UNLIKELY(state.stackLimit() < currentStackBase)) {
+#endif
+            ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, "Maximum call stack size exceeded");
+        }
+
+        InterpretedCodeBlock* codeBlock = self->interpretedCodeBlock();
+        ASSERT(codeBlock->canAllocateEnvironmentOnStack());
+        Context* ctx = codeBlock->context();
+        bool isStrict = codeBlock->isStrict();
+        size_t identifierOnStackCount = codeBlock->identifierOnStackCount();
+
+        FunctionEnvironmentRecord* record = new (alloca(sizeof(FunctionEnvironmentRecord))) FunctionEnvironmentRecordOnStack<false, false>(self);
+        LexicalEnvironment* lexEnv = new (alloca(sizeof(LexicalEnvironment))) LexicalEnvironment(record, self->outerEnvironment()
+#ifndef NDEBUG
+                                                                                                                   ,
+                                                                                                 false
+#endif
+                                                                                                 );
+
+        Value* stackStorage = registerFile + blk->m_requiredRegisterFileSizeInValueSize;
+
+        // binding function name
+        stackStorage[1] = self;
+
+        // initialize identifiers by undefined value
+        for (size_t i = 2; i < identifierOnStackCount; i++) {
+            stackStorage[i] = Value();
+        }
+
+        ExecutionState newState(ctx, &state, lexEnv, argc, argv, isStrict);
+
+        ThisValueBinder thisValueBinder;
+        stackStorage[0] = thisValueBinder(state, newState, self, thisArgument, isStrict);
+
+        const Value returnValue = ByteCodeInterpreter::interpret(&newState, blk, 0, registerFile);
+
+        if (UNLIKELY(blk->m_shouldClearStack)) {
+            clearStack<512>();
+        }
+
+        return returnValue;
+    }
 };
 }
 
@@ -79,6 +79,7 @@ private:
         GC_set_bit(desc, GC_WORD_OFFSET(GeneratorObject, m_executionPauser.m_registerFile));
         GC_set_bit(desc, GC_WORD_OFFSET(GeneratorObject, m_executionPauser.m_byteCodeBlock));
         GC_set_bit(desc, GC_WORD_OFFSET(GeneratorObject, m_executionPauser.m_resumeValue));
+        GC_set_bit(desc, GC_WORD_OFFSET(GeneratorObject, m_executionPauser.m_pauseValue));
     }
 
     GeneratorState m_generatorState;
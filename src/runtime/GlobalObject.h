@@ -68,23 +68,24 @@ class FunctionObject;
 #define GLOBALOBJECT_BUILTIN_DATE(F, NAME) \
     F(date, FunctionObject, NAME)          \
     F(datePrototype, Object, NAME)
-#define GLOBALOBJECT_BUILTIN_ERROR(F, NAME)  \
-    F(error, FunctionObject, NAME)           \
-    F(errorPrototype, Object, NAME)          \
-    F(referenceError, FunctionObject, NAME)  \
-    F(referenceErrorPrototype, Object, NAME) \
-    F(typeError, FunctionObject, NAME)       \
-    F(typeErrorPrototype, Object, NAME)      \
-    F(rangeError, FunctionObject, NAME)      \
-    F(rangeErrorPrototype, Object, NAME)     \
-    F(syntaxError, FunctionObject, NAME)     \
-    F(syntaxErrorPrototype, Object, NAME)    \
-    F(uriError, FunctionObject, NAME)        \
-    F(uriErrorPrototype, Object, NAME)       \
-    F(evalError, FunctionObject, NAME)       \
-    F(evalErrorPrototype, Object, NAME)      \
-    F(throwTypeError, FunctionObject, NAME)  \
-    F(throwerGetterSetterData, JSGetterSetter, NAME)
+#define GLOBALOBJECT_BUILTIN_ERROR(F, NAME)             \
+    F(error, FunctionObject, NAME)                      \
+    F(errorPrototype, Object, NAME)                     \
+    F(referenceError, FunctionObject, NAME)             \
+    F(referenceErrorPrototype, Object, NAME)            \
+    F(typeError, FunctionObject, NAME)                  \
+    F(typeErrorPrototype, Object, NAME)                 \
+    F(rangeError, FunctionObject, NAME)                 \
+    F(rangeErrorPrototype, Object, NAME)                \
+    F(syntaxError, FunctionObject, NAME)                \
+    F(syntaxErrorPrototype, Object, NAME)               \
+    F(uriError, FunctionObject, NAME)                   \
+    F(uriErrorPrototype, Object, NAME)                  \
+    F(evalError, FunctionObject, NAME)                  \
+    F(evalErrorPrototype, Object, NAME)                 \
+    F(throwTypeError, FunctionObject, NAME)             \
+    F(throwerGetterSetterData, JSGetterSetter, NAME)    \
+    F(errorStackGetterSetterData, JSGetterSetter, NAME)
 #define GLOBALOBJECT_BUILTIN_EVAL(F, NAME) \
     F(eval, FunctionObject, NAME)
 #define GLOBALOBJECT_BUILTIN_FUNCTION(F, NAME) \
@@ -139,6 +139,80 @@ static Object* arraySpeciesCreate(ExecutionState& state, Object* originalArray,
     return Object::construct(state, C, 1, argv);
 }
 
+// [[HasProperty]] and [[Get]] of O at k. fastO is O when O is an ArrayObject, otherwise nullptr.
+// elements of a fast mode array are read directly. callbacks may change O, so this is checked for every k
+static ALWAYS_INLINE bool getIndexedElement(ExecutionState& state, Object* O, ArrayObject* fastO, int64_t k, Value& result)
+{
+    if (LIKELY(fastO != nullptr)) {
+        result = fastO->fastModeElement(state, k);
+        if (LIKELY(!result.isEmpty())) {
+            return true;
+        }
+    }
+
+    ObjectHasPropertyResult kPresent = O->hasIndexedProperty(state, Value(k));
+    if (kPresent) {
+        result = kPresent.value(state, ObjectPropertyName(state, k), O);
+        return true;
+    }
+    return false;
+}
+
+// CreateDataPropertyOrThrow(A, k, value). a fast mode array A is written directly
+static ALWAYS_INLINE void createDataPropertyOrThrow(ExecutionState& state, Object* A, int64_t k, const Value& value)
+{
+    if (LIKELY(A->isArrayObject() && k < Value::InvalidArrayIndexValue)) {
+        A->asArrayObject()->defineOwnIndexedPropertyThrowsException(state, k, value);
+    } else {
+        A->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(k)), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
+    }
+}
+
+// search for indexOf (strict equality) and includes (SameValueZero) over the fast mode elements of arr from k.
+// comparing has no side effect, so the loop is specialized on the type of searchElement.
+// returns true when k is the found index. otherwise k is len or an index which should be examined in the generic way
+static bool searchFastModeArray(ExecutionState& state, ArrayObject* arr, const Value& searchElement, bool sameValueZero, int64_t& k, int64_t len)
+{
+    if (searchElement.isNumber()) {
+        double number = searchElement.asNumber();
+        bool searchNaN = sameValueZero && std::isnan(number);
+        for (; k < len; k++) {
+            Value element = arr->fastModeElement(state, k);
+            if (element.isEmpty()) {
+                return false;
+            }
+            if (element.isNumber()) {
+                double elementNumber = element.asNumber();
+                if (elementNumber == number || (searchNaN && std::isnan(elementNumber))) {
+                    return true;
+                }
+            }
+        }
+    } else if (searchElement.isString()) {
+        String* string = searchElement.asString();
+        for (; k < len; k++) {
+            Value element = arr->fastModeElement(state, k);
+            if (element.isEmpty()) {
+                return false;
+            }
+            if (element.isString() && element.asString()->equals(string)) {
+                return true;
+            }
+        }
+    } else {
+        for (; k < len; k++) {
+            Value element = arr->fastModeElement(state, k);
+            if (element.isEmpty()) {
+                return false;
+            }
+            if (sameValueZero ? element.equalsToByTheSameValueZeroAlgorithm(state, searchElement) : element.equalsTo(state, searchElement)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 // http://ecma-international.org/ecma-262/10.0/#sec-flattenintoarray
 // FlattenIntoArray(target, source, sourceLen, start, depth [ , mapperFunction, thisArg ])
 static int64_t flattenIntoArray(ExecutionState& state, Value target, Value source, int64_t sourceLen, int64_t start, double depth, Value mappedValue = Value(Value::EmptyValue), Value thisArg = Value(Value::EmptyValue))
@@ -510,7 +584,8 @@ static Value builtinArraySort(ExecutionState& state, Value thisValue, size_t arg
 
     int64_t len = thisObject->length(state);
 
-    thisObject->sort(state, len, [defaultSort, &cmpfn, &state](const Value& a, const Value& b) -> bool {
+    PreparedFunctionCall comparator(cmpfn);
+    thisObject->sort(state, len, [defaultSort, &comparator, &state](const Value& a, const Value& b) -> bool {
         if (a.isEmpty() && b.isUndefined())
             return false;
         if (a.isUndefined() && b.isEmpty())
@@ -525,7 +600,7 @@ static Value builtinArraySort(ExecutionState& state, Value thisValue, size_t arg
             String* valb = b.toString(state);
             return *vala < *valb;
         } else {
-            Value ret = Object::call(state, cmpfn, Value(), 2, arg);
+            Value ret = comparator.call(state, Value(), 2, arg);
             return (ret.toNumber(state) < 0);
         } });
     return thisObject;
@@ -731,12 +806,13 @@ static Value builtinArrayConcat(ExecutionState& state, Value thisValue, size_t a
                 // If n + len > 2^53 - 1, throw a TypeError exception.
                 CHECK_ARRAY_LENGTH(n + len > Value::maximumLength());
 
+                ArrayObject* fastArr = arr->isArrayObject() ? arr->asArrayObject() : nullptr;
                 // Repeat, while k < len
                 while (k < len) {
                     // Let exists be the result of calling the [[HasProperty]] internal method of E with P.
-                    ObjectHasPropertyResult exists = arr->hasIndexedProperty(state, Value(k));
-                    if (exists) {
-                        obj->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(n + k)), ObjectPropertyDescriptor(exists.value(state, ObjectPropertyName(state, k), arr), ObjectPropertyDescriptor::AllPresent));
+                    Value subElement;
+                    if (getIndexedElement(state, arr, fastArr, k, subElement)) {
+                        createDataPropertyOrThrow(state, obj, n + k, subElement);
                         k++;
                     } else {
                         int64_t result;
@@ -775,12 +851,12 @@ static Value builtinArraySlice(ExecutionState& state, Value thisValue, size_t ar
     int64_t n = 0;
     // Let count be max(final - k, 0).
     // Let A be ArraySpeciesCreate(O, count).
+    ArrayObject* fastO = thisObject->isArrayObject() ? thisObject->asArrayObject() : nullptr;
     Object* ArrayObject = arraySpeciesCreate(state, thisObject, std::max(((int64_t)finalEnd - (int64_t)k), (int64_t)0));
     while (k < finalEnd) {
-        ObjectHasPropertyResult exists = thisObject->hasIndexedProperty(state, Value(k));
-        if (exists) {
-            ArrayObject->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(n)),
-                                                          ObjectPropertyDescriptor(exists.value(state, ObjectPropertyName(state, k), thisObject), ObjectPropertyDescriptor::AllPresent));
+        Value kValue;
+        if (getIndexedElement(state, thisObject, fastO, k, kValue)) {
+            createDataPropertyOrThrow(state, ArrayObject, n, kValue);
             k++;
             n++;
         } else {
@@ -808,20 +884,20 @@ static Value builtinArrayForEach(ExecutionState& state, Value thisValue, size_t
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true,
                                        state.context()->staticStrings().forEach.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
     }
+    PreparedFunctionCall callback(callbackfn);
 
     // If thisArg was supplied, let T be thisArg; else let T be undefined.
     Value T;
     if (argc > 1)
         T = argv[1];
 
+    ArrayObject* fastO = thisObject->isArrayObject() ? thisObject->asArrayObject() : nullptr;
     int64_t k = 0;
     while (k < len) {
-        Value Pk = Value(k);
-        auto res = thisObject->hasProperty(state, ObjectPropertyName(state, Pk));
-        if (res) {
-            Value kValue = res.value(state, ObjectPropertyName(state, k), thisObject);
-            Value args[3] = { kValue, Pk, thisObject };
-            Object::call(state, callbackfn, T, 3, args);
+        Value kValue;
+        if (getIndexedElement(state, thisObject, fastO, k, kValue)) {
+            Value args[3] = { kValue, Value(k), thisObject };
+            callback.call(state, T, 3, args);
             k++;
         } else {
             int64_t result;
@@ -876,8 +952,17 @@ static Value builtinArrayIndexOf(ExecutionState& state, Value thisValue, size_t
     ASSERT(doubleK >= 0);
     int64_t k = doubleK;
 
+    ArrayObject* fastO = O->isArrayObject() ? O->asArrayObject() : nullptr;
     // Repeat, while k<len
     while (k < len) {
+        if (fastO) {
+            if (searchFastModeArray(state, fastO, argv[0], false, k, len)) {
+                return Value(k);
+            }
+            if (k >= len) {
+                break;
+            }
+        }
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
         auto kPresent = O->hasIndexedProperty(state, Value(k));
         // If kPresent is true, then
@@ -976,6 +1061,7 @@ static Value builtinArrayEvery(ExecutionState& state, Value thisValue, size_t ar
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true,
                                        state.context()->staticStrings().every.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
     }
+    PreparedFunctionCall callback(callbackfn);
 
     // If thisArg was supplied, let T be thisArg; else let T be undefined.
     Value T;
@@ -996,7 +1082,7 @@ static Value builtinArrayEvery(ExecutionState& state, Value thisValue, size_t ar
             Value kValue = kPresent.value(state, ObjectPropertyName(state, k), O);
             // Let testResult be the result of calling the [[Call]] internal method of callbackfn with T as the this value and argument list containing kValue, k, and O.
             Value args[] = { kValue, Value(k), O };
-            Value testResult = Object::call(state, callbackfn, T, 3, args);
+            Value testResult = callback.call(state, T, 3, args);
 
             if (!testResult.toBoolean(state)) {
                 return Value(false);
@@ -1062,6 +1148,7 @@ static Value builtinArrayFilter(ExecutionState& state, Value thisValue, size_t a
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true,
                                        state.context()->staticStrings().every.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
     }
+    PreparedFunctionCall callback(callbackfn);
 
     // If thisArg was supplied, let T be thisArg; else let T be undefined.
     Value T;
@@ -1075,25 +1162,24 @@ static Value builtinArrayFilter(ExecutionState& state, Value thisValue, size_t a
     int64_t k = 0;
     // Let to be 0.
     int64_t to = 0;
+    ArrayObject* fastO = O->isArrayObject() ? O->asArrayObject() : nullptr;
     // Repeat, while k < len
     while (k < len) {
         // Let Pk be ToString(k).
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
-        ObjectHasPropertyResult kPresent = O->hasIndexedProperty(state, Value(k));
         // If kPresent is true, then
-        if (kPresent) {
-            // Let kValue be the result of calling the [[Get]] internal method of O with argument Pk.
-            Value kValue = kPresent.value(state, ObjectPropertyName(state, k), O);
-
+        // Let kValue be the result of calling the [[Get]] internal method of O with argument Pk.
+        Value kValue;
+        if (getIndexedElement(state, O, fastO, k, kValue)) {
             // Let selected be the result of calling the [[Call]] internal method of callbackfn with T as the this value and argument list containing kValue, k, and O.
             Value v[] = { kValue, Value(k), O };
-            Value selected = Object::call(state, callbackfn, T, 3, v);
+            Value selected = callback.call(state, T, 3, v);
 
             // If ToBoolean(selected) is true, then
             if (selected.toBoolean(state)) {
                 // Let status be CreateDataPropertyOrThrow (A, ToString(to), kValue).
                 ASSERT(A != nullptr);
-                A->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(to)), ObjectPropertyDescriptor(kValue, ObjectPropertyDescriptor::AllPresent));
+                createDataPropertyOrThrow(state, A, to, kValue);
                 // Increase to by 1
                 to++;
             }
@@ -1125,6 +1211,7 @@ static Value builtinArrayMap(ExecutionState& state, Value thisValue, size_t argc
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true,
                                        state.context()->staticStrings().every.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
     }
+    PreparedFunctionCall callback(callbackfn);
     // If thisArg was supplied, let T be thisArg; else let T be undefined.
     Value T;
     if (argc > 1)
@@ -1135,22 +1222,21 @@ static Value builtinArrayMap(ExecutionState& state, Value thisValue, size_t argc
 
     // Let k be 0.
     int64_t k = 0;
+    ArrayObject* fastO = O->isArrayObject() ? O->asArrayObject() : nullptr;
 
     // Repeat, while k < len
     while (k < len) {
         // Let Pk be ToString(k).
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
-        auto kPresent = O->hasIndexedProperty(state, Value(k));
         // If kPresent is true, then
-        if (kPresent) {
-            // Let kValue be the result of calling the [[Get]] internal method of O with argument Pk.
-            auto Pk = ObjectPropertyName(state, k);
-            Value kValue = kPresent.value(state, Pk, O);
+        // Let kValue be the result of calling the [[Get]] internal method of O with argument Pk.
+        Value kValue;
+        if (getIndexedElement(state, O, fastO, k, kValue)) {
             // Let mappedValue be the result of calling the [[Call]] internal method of callbackfn with T as the this value and argument list containing kValue, k, and O.
             Value v[] = { kValue, Value(k), O };
-            Value mappedValue = Object::call(state, callbackfn, T, 3, v);
+            Value mappedValue = callback.call(state, T, 3, v);
             // Let status be CreateDataPropertyOrThrow (A, Pk, mappedValue).
-            A->defineOwnPropertyThrowsException(state, Pk, ObjectPropertyDescriptor(mappedValue, ObjectPropertyDescriptor::AllPresent));
+            createDataPropertyOrThrow(state, A, k, mappedValue);
             k++;
         } else {
             int64_t result;
@@ -1177,6 +1263,7 @@ static Value builtinArraySome(ExecutionState& state, Value thisValue, size_t arg
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true,
                                        state.context()->staticStrings().some.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
     }
+    PreparedFunctionCall callback(callbackfn);
     Value T;
     // If thisArg was supplied, let T be thisArg; else let T be undefined.
     if (argc > 1) {
@@ -1197,7 +1284,7 @@ static Value builtinArraySome(ExecutionState& state, Value thisValue, size_t arg
             Value kValue = kPresent.value(state, Pk, O);
             // Let testResult be the result of calling the [[Call]] internal method of callbackfn with T as the this value and argument list containing kValue, k, and O.
             Value argv[] = { kValue, Value(k), O };
-            Value testResult = Object::call(state, callbackfn, T, 3, argv);
+            Value testResult = callback.call(state, T, 3, argv);
             // If ToBoolean(testResult) is true, return true.
             if (testResult.toBoolean(state)) {
                 return Value(true);
@@ -1248,17 +1335,30 @@ static Value builtinArrayIncludes(ExecutionState& state, Value thisValue, size_t
     }
 
     ASSERT(doubleK >= 0);
+    if (doubleK >= len) {
+        return Value(false);
+    }
+    int64_t k = doubleK;
 
+    ArrayObject* fastO = O->isArrayObject() ? O->asArrayObject() : nullptr;
     // Repeat, while k < len
-    while (doubleK < len) {
+    while (k < len) {
+        if (fastO) {
+            if (searchFastModeArray(state, fastO, searchElement, true, k, len)) {
+                return Value(true);
+            }
+            if (k >= len) {
+                break;
+            }
+        }
         // Let elementK be the result of ? Get(O, ! ToString(k)).
-        Value elementK = O->get(state, ObjectPropertyName(state, Value(doubleK))).value(state, O);
+        Value elementK = O->getIndexedProperty(state, Value(k)).value(state, O);
         // If SameValueZero(searchElement, elementK) is true, return true.
         if (elementK.equalsToByTheSameValueZeroAlgorithm(state, searchElement)) {
             return Value(true);
         }
         // Increase k by 1.
-        doubleK++;
+        k++;
     }
 
     // Return false.
@@ -1332,33 +1432,31 @@ static Value builtinArrayReduce(ExecutionState& state, Value thisValue, size_t a
 
     if (!callbackfn.isCallable()) // 4
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true, state.context()->staticStrings().reduce.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
+    PreparedFunctionCall callback(callbackfn);
 
     if (len == 0 && (initialValue.isUndefined() || initialValue.isEmpty())) // 5
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true, state.context()->staticStrings().reduce.string(), ErrorObject::Messages::GlobalObject_ReduceError);
 
+    ArrayObject* fastO = O->isArrayObject() ? O->asArrayObject() : nullptr;
     int64_t k = 0; // 6
     Value accumulator;
     if (!initialValue.isEmpty()) { // 7
         accumulator = initialValue;
     } else { // 8
-        ObjectHasPropertyResult kPresent; // 8.a
+        bool kPresent = false; // 8.a
         while (!kPresent && k < len) { // 8.b
-            kPresent = O->hasIndexedProperty(state, Value(k)); // 8.b.ii
-            if (kPresent) {
-                accumulator = kPresent.value(state, ObjectPropertyName(state, k), O);
-            }
+            kPresent = getIndexedElement(state, O, fastO, k, accumulator); // 8.b.ii
             k++; // 8.b.iv
         }
         if (!kPresent)
             ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true, state.context()->staticStrings().reduce.string(), ErrorObject::Messages::GlobalObject_ReduceError);
     }
     while (k < len) { // 9
-        ObjectHasPropertyResult kPresent = O->hasIndexedProperty(state, Value(k)); // 9.b
-        if (kPresent) { // 9.c
-            Value kValue = kPresent.value(state, ObjectPropertyName(state, k), O); // 9.c.i
+        Value kValue;
+        if (getIndexedElement(state, O, fastO, k, kValue)) { // 9.b - 9.c.i
             const int fnargc = 4;
             Value fnargs[] = { accumulator, kValue, Value(k), O };
-            accumulator = Object::call(state, callbackfn, Value(), fnargc, fnargs);
+            accumulator = callback.call(state, Value(), fnargc, fnargs);
             k++;
         } else {
             int64_t result;
@@ -1384,6 +1482,7 @@ static Value builtinArrayReduceRight(ExecutionState& state, Value thisValue, siz
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true,
                                        state.context()->staticStrings().reduceRight.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
     }
+    PreparedFunctionCall callback(callbackfn);
 
     // If len is 0 and initialValue is not present, throw a TypeError exception.
     if (len == 0 && argc < 2) {
@@ -1439,7 +1538,7 @@ static Value builtinArrayReduceRight(ExecutionState& state, Value thisValue, siz
 
             // Let accumulator be the result of calling the [[Call]] internal method of callbackfn with undefined as the this value and argument list containing accumulator, kValue, k, and O.
             Value v[] = { accumulator, kValue, Value(k), O };
-            accumulator = Object::call(state, callbackfn, Value(), 4, v);
+            accumulator = callback.call(state, Value(), 4, v);
         }
 
         // Decrease k by 1.
@@ -1698,6 +1797,7 @@ static Value builtinArrayFind(ExecutionState& state, Value thisValue, size_t arg
     if (!argv[0].isCallable()) {
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true, state.context()->staticStrings().find.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
     }
+    PreparedFunctionCall callback(argv[0]);
     Value T;
     // If thisArg was supplied, let T be thisArg; else let T be undefined.
     if (argc >= 2) {
@@ -1712,7 +1812,7 @@ static Value builtinArrayFind(ExecutionState& state, Value thisValue, size_t arg
         Value kValue = O->get(state, ObjectPropertyName(state, Value(k))).value(state, O);
         // Let testResult be ToBoolean(? Call(predicate, T, « kValue, k, O »)).
         Value v[] = { kValue, Value(k), O };
-        bool testResult = Object::call(state, argv[0], T, 3, v).toBoolean(state);
+        bool testResult = callback.call(state, T, 3, v).toBoolean(state);
         // If testResult is true, return kValue.
         if (testResult) {
             return kValue;
@@ -1735,6 +1835,7 @@ static Value builtinArrayFindIndex(ExecutionState& state, Value thisValue, size_
     if (!argv[0].isCallable()) {
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, state.context()->staticStrings().Array.string(), true, state.context()->staticStrings().findIndex.string(), ErrorObject::Messages::GlobalObject_CallbackNotCallable);
     }
+    PreparedFunctionCall callback(argv[0]);
     Value T;
     // If thisArg was supplied, let T be thisArg; else let T be undefined.
     if (argc >= 2) {
@@ -1749,7 +1850,7 @@ static Value builtinArrayFindIndex(ExecutionState& state, Value thisValue, size_
         Value kValue = O->get(state, ObjectPropertyName(state, Value(k))).value(state, O);
         // Let testResult be ToBoolean(? Call(predicate, T, « kValue, k, O »)).
         Value v[] = { kValue, Value(k), O };
-        bool testResult = Object::call(state, argv[0], T, 3, v).toBoolean(state);
+        bool testResult = callback.call(state, T, 3, v).toBoolean(state);
         // If testResult is true, return k.
         if (testResult) {
             return Value(k);
@@ -76,6 +76,23 @@ static Value builtinErrorThrowTypeError(ExecutionState& state, Value thisValue,
     return Value();
 }
 
+static Value builtinErrorObjectStackInfo(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    if (!(LIKELY(thisValue.isPointerValue() && thisValue.asPointerValue()->isErrorObject()))) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "get Error.prototype.stack called on incompatible receiver");
+    }
+
+    ErrorObject* obj = thisValue.asObject()->asErrorObject();
+    if (obj->stackTraceData() == nullptr) {
+        return String::emptyString;
+    }
+
+    auto stackTraceData = obj->stackTraceData();
+    StringBuilder builder;
+    stackTraceData->buildStackTrace(state.context(), builder);
+    return builder.finalize();
+}
+
 static Value builtinErrorToString(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
     if (!thisValue.isObject())
@@ -149,6 +166,11 @@ void GlobalObject::installError(ExecutionState& state)
 
     m_throwerGetterSetterData = new JSGetterSetter(m_throwTypeError, m_throwTypeError);
 
+    // every caught error shares this getter. the trace string is built only when it is called
+    m_errorStackGetterSetterData = new JSGetterSetter(
+        new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().stack, builtinErrorObjectStackInfo, 0, NativeFunctionInfo::Strict)),
+        Value(Value::EmptyValue));
+
 #define DEFINE_ERROR(errorname, bname)                                                                                                                                                                                                                                                                                                  \
     m_##errorname##Error = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().bname##Error, builtin##bname##ErrorConstructor, 1), NativeFunctionObject::__ForBuiltinConstructor__);                                                                                                                    \
     m_##errorname##Error->setPrototype(state, m_error);                                                                                                                                                                                                                                                                                 \
@@ -26,6 +26,7 @@
 #include "TypedArrayObject.h"
 #include "BooleanObject.h"
 #include "NativeFunctionObject.h"
+#include "util/Transcoder.h"
 
 #define RAPIDJSON_PARSE_DEFAULT_FLAGS kParseFullPrecisionFlag
 #define RAPIDJSON_ERROR_CHARTYPE char
@@ -201,10 +202,7 @@ static Value builtinJSONParse(ExecutionState& state, Value thisValue, size_t arg
         size_t len = JText->length();
         char16_t* char16Buf = new char16_t[len];
         std::unique_ptr<char16_t[]> buf(char16Buf);
-        const LChar* srcBuf = JText->characters8();
-        for (size_t i = 0; i < len; i++) {
-            char16Buf[i] = srcBuf[i];
-        }
+        Transcoder::widenLatin1ToUTF16(JText->characters8(), len, char16Buf);
         unfiltered = parseJSON<char16_t, rapidjson::UTF16<char16_t>>(state, buf.get(), JText->length());
     } else {
         unfiltered = parseJSON<char16_t, rapidjson::UTF16<char16_t>>(state, JText->characters16(), JText->length());
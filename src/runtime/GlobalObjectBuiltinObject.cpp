@@ -333,6 +333,10 @@ static Value builtinObjectFreeze(ExecutionState& state, Value thisValue, size_t
 
     Object* O = argv[0].asObject();
 
+    if (O->setIntegrityLevelWithStructure(state, ObjectStructure::Frozen)) {
+        return O;
+    }
+
     // For each named own property name P of O,
     ObjectStructurePropertyVector descriptors;
     O->enumeration(state, [](ExecutionState& state, Object* self, const ObjectPropertyName& P, const ObjectStructurePropertyDescriptor& desc, void* data) -> bool {
@@ -578,6 +582,10 @@ static Value builtinObjectSeal(ExecutionState& state, Value thisValue, size_t ar
     }
     Object* O = argv[0].asObject();
 
+    if (O->setIntegrityLevelWithStructure(state, ObjectStructure::Sealed)) {
+        return O;
+    }
+
     // For each named own property name P of O,
     ObjectStructurePropertyVector descriptors;
     O->enumeration(state, [](ExecutionState& state, Object* self, const ObjectPropertyName& P, const ObjectStructurePropertyDescriptor& desc, void* data) -> bool {
@@ -625,6 +633,9 @@ static Value builtinObjectAssign(ExecutionState& state, Value thisValue, size_t
         if (!nextSource.isUndefinedOrNull()) {
             // Let from be ! ToObject(nextSource).
             from = nextSource.toObject(state);
+            if (to->copyOwnPropertiesWithStructure(state, from, true)) {
+                continue;
+            }
             // Let keys be ? from.[[OwnPropertyKeys]]().
             keys = from->ownPropertyKeys(state);
         }
@@ -425,6 +425,7 @@ static Value builtinRegExpReplace(ExecutionState& state, Value thisValue, size_t
     }
 
     size_t resultSize = results.size();
+    PreparedFunctionCall replacer(replaceValue);
     for (uint i = 0; i < resultSize; i++) {
         Object* result = results[i].toObject(state);
         size_t nCaptures = result->get(state, ObjectPropertyName(state.context()->staticStrings().length)).value(state, result).toLength(state) - 1;
@@ -473,7 +474,7 @@ static Value builtinRegExpReplace(ExecutionState& state, Value thisValue, size_t
             replacerArgs[nCaptures + 1] = Value((size_t)position);
             replacerArgs[nCaptures + 2] = Value(str);
 
-            replacement = Object::call(state, replaceValue, Value(), replacerArgsSize, replacerArgs).toString(state);
+            replacement = replacer.call(state, Value(), replacerArgsSize, replacerArgs).toString(state);
         } else {
             replacement = replacement->getSubstitution(state, matched, str, position, captures, namedCaptures, replaceValue.toString(state));
         }
@@ -654,24 +655,39 @@ static Value builtinRegExpInputSetter(ExecutionState& state, Value thisValue, si
     return Value();
 }
 
+static Value regExpStatusSubString(Context::RegExpStatus& status, unsigned start, unsigned end)
+{
+    if (!status.matchedInput || start == Context::RegExpStatus::NotMatched) {
+        return Value(String::emptyString);
+    }
+    return Value(new StringView(status.matchedInput, start, end));
+}
+
 static Value builtinRegExpLastMatchGetter(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
-    return Value(new StringView(state.resolveCallee()->codeBlock()->context()->regexpStatus().lastMatch));
+    auto& status = state.resolveCallee()->codeBlock()->context()->regexpStatus();
+    return regExpStatusSubString(status, status.captures[0], status.captures[1]);
 }
 
 static Value builtinRegExpLastParenGetter(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
-    return Value(new StringView(state.resolveCallee()->codeBlock()->context()->regexpStatus().lastParen));
+    auto& status = state.resolveCallee()->codeBlock()->context()->regexpStatus();
+    return regExpStatusSubString(status, status.lastParen[0], status.lastParen[1]);
 }
 
 static Value builtinRegExpLeftContextGetter(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
-    return Value(new StringView(state.resolveCallee()->codeBlock()->context()->regexpStatus().leftContext));
+    auto& status = state.resolveCallee()->codeBlock()->context()->regexpStatus();
+    return regExpStatusSubString(status, 0, status.captures[0]);
 }
 
 static Value builtinRegExpRightContextGetter(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
-    return Value(new StringView(state.resolveCallee()->codeBlock()->context()->regexpStatus().rightContext));
+    auto& status = state.resolveCallee()->codeBlock()->context()->regexpStatus();
+    if (!status.matchedInput) {
+        return Value(String::emptyString);
+    }
+    return regExpStatusSubString(status, status.captures[1], status.matchedInput->length());
 }
 
 static Value builtinRegExpStringIteratorNext(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
@@ -690,7 +706,7 @@ static Value builtinRegExpStringIteratorNext(ExecutionState& state, Value thisVa
         if (status.dollarCount < number) {                                                                                                          \
             return Value(String::emptyString);                                                                                                      \
         }                                                                                                                                           \
-        return Value(new StringView(status.dollars[number - 1]));                                                                                   \
+        return regExpStatusSubString(status, status.captures[number * 2], status.captures[number * 2 + 1]);                                         \
     }
 
 DEFINE_GETTER(1)
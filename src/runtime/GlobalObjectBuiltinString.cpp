@@ -391,12 +391,7 @@ static Value builtinStringReplace(ExecutionState& state, Value thisValue, size_t
         } else {
             size_t idx = string->find(searchString);
             if (idx != (size_t)-1) {
-                std::vector<RegexMatchResult::RegexMatchResultPiece> piece;
-                RegexMatchResult::RegexMatchResultPiece p;
-                p.m_start = idx;
-                p.m_end = idx + searchString->length();
-                piece.push_back(std::move(p));
-                result.m_matchResults.push_back(std::move(piece));
+                result.m_matchResults.append(idx, idx + searchString->length());
             }
         }
 
@@ -412,7 +407,7 @@ static Value builtinStringReplace(ExecutionState& state, Value thisValue, size_t
 
         if (functionalReplace) {
             uint32_t matchCount = result.m_matchResults.size();
-            Value callee = replaceValue;
+            PreparedFunctionCall callee(replaceValue);
 
             StringBuilder builer;
             builer.appendSubString(string, 0, result.m_matchResults[0][0].m_start);
@@ -433,7 +428,7 @@ static Value builtinStringReplace(ExecutionState& state, Value thisValue, size_t
                 arguments[subLen] = Value((int)result.m_matchResults[i][0].m_start);
                 arguments[subLen + 1] = string;
                 // 21.1.3.14 (11) it should be called with this as undefined
-                String* res = Object::call(state, callee, Value(), subLen + 2, arguments).toString(state);
+                String* res = callee.call(state, Value(), subLen + 2, arguments).toString(state);
                 builer.appendSubString(res, 0, res->length());
 
                 if (i < matchCount - 1) {
@@ -1167,16 +1162,7 @@ static Value builtinStringStartsWith(ExecutionState& state, Value thisValue, siz
     }
     // If the sequence of elements of S starting at start of length searchLength is the same as the full element sequence of searchStr, return true.
     // Otherwise, return false.
-    const auto& srcData = S->bufferAccessData();
-    const auto& src2Data = searchStr->bufferAccessData();
-
-    for (size_t i = 0; i < src2Data.length; i++) {
-        if (srcData.charAt(i + start) != src2Data.charAt(i)) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(S->matchesAt(start, searchStr));
 }
 
 static Value builtinStringEndsWith(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
@@ -1214,15 +1200,7 @@ static Value builtinStringEndsWith(ExecutionState& state, Value thisValue, size_
         return Value(false);
     }
     // If the sequence of elements of S starting at start of length searchLength is the same as the full element sequence of searchStr, return true.
-    const auto& srcData = S->bufferAccessData();
-    const auto& src2Data = searchStr->bufferAccessData();
-    for (size_t i = 0; i < searchLength; i++) {
-        if (srcData.charAt(i + start) != src2Data.charAt(i)) {
-            return Value(false);
-        }
-    }
-
-    return Value(true);
+    return Value(S->matchesAt(start, searchStr));
 }
 
 // ( template, ...substitutions )
@@ -78,7 +78,7 @@ ObjectStructurePropertyName ObjectPropertyName::toObjectStructurePropertyNameUin
         return ObjectStructurePropertyName(state.context()->staticStrings().numbers[uint]);
     }
 
-    return ObjectStructurePropertyName(state, String::fromDouble(uint));
+    return ObjectStructurePropertyName(state, state.context()->staticStrings().dtoa(uint));
 }
 
 ObjectRareData::ObjectRareData(Object* obj)
@@ -834,6 +834,83 @@ void Object::enumeration(ExecutionState& state, bool (*callback)(ExecutionState&
     }
 }
 
+// these objects have own properties outside of the structure or watch redefinition of their properties
+static bool hasOwnPropertiesOnlyInStructure(Object* object)
+{
+    return object->isInlineCacheable() && !object->isTypedArrayObject() && !object->isStringObject() && !object->isRegExpObject();
+}
+
+bool Object::setIntegrityLevelWithStructure(ExecutionState& state, ObjectStructure::IntegrityLevel level)
+{
+    if (!hasOwnPropertiesOnlyInStructure(this)) {
+        return false;
+    }
+
+    ObjectStructure* newStructure = m_structure->convertToIntegrityLevel(level);
+    if (!newStructure) {
+        return false;
+    }
+
+    m_structure = newStructure;
+    preventExtensions(state);
+    return true;
+}
+
+bool Object::copyOwnPropertiesWithStructure(ExecutionState& state, Object* source, bool isSet)
+{
+    ObjectStructure* sourceStructure = source->structure();
+    size_t propertyCount = sourceStructure->propertyCount();
+    // structures not in transition mode are owned by one object
+    if (!propertyCount || !sourceStructure->inTransitionMode() || m_structure->propertyCount()) {
+        return false;
+    }
+
+    if (!hasOwnPropertiesOnlyInStructure(this) || !hasOwnPropertiesOnlyInStructure(source) || !isExtensible(state)) {
+        return false;
+    }
+
+    const ObjectStructureItem* properties = sourceStructure->properties();
+    for (size_t i = 0; i < propertyCount; i++) {
+        if (properties[i].m_descriptor != ObjectStructurePropertyDescriptor::createDataDescriptor()) {
+            return false;
+        }
+    }
+
+    if (isSet) {
+        // a setter or a non-writable property on the prototype chain changes the result of Set()
+        Object* proto = getPrototypeObject(state);
+        while (proto) {
+            if (!hasOwnPropertiesOnlyInStructure(proto)) {
+                return false;
+            }
+            ObjectStructure* protoStructure = proto->structure();
+            for (size_t i = 0; i < propertyCount; i++) {
+                auto findResult = protoStructure->findProperty(properties[i].m_propertyName);
+                if (findResult.first != SIZE_MAX) {
+                    const auto& desc = findResult.second.value()->m_descriptor;
+                    if (!desc.isPlainDataProperty() || !desc.isWritable()) {
+                        return false;
+                    }
+                }
+            }
+            proto = proto->getPrototypeObject(state);
+        }
+    }
+
+    // index properties on a prototype turn arrays inheriting from it out of fast mode, as in defineOwnProperty
+    if (UNLIKELY(isEverSetAsPrototypeObject() && !state.context()->vmInstance()->didSomePrototypeObjectDefineIndexedProperty() && sourceStructure->hasIndexPropertyName())) {
+        state.context()->vmInstance()->somePrototypeObjectDefineIndexedProperty(state);
+    }
+
+    // values are converted one by one because ObjectPropertyValue of a double should not be shared
+    m_values.resizeWithUninitializedValues(0, propertyCount);
+    for (size_t i = 0; i < propertyCount; i++) {
+        m_values[i] = ObjectPropertyValue(Value(source->m_values[i]));
+    }
+    m_structure = sourceStructure;
+    return true;
+}
+
 ObjectHasPropertyResult Object::hasProperty(ExecutionState& state, const ObjectPropertyName& propertyName)
 {
     // https://www.ecma-international.org/ecma-262/6.0/#sec-ordinary-object-internal-methods-and-internal-slots-hasproperty-p
@@ -721,6 +721,7 @@ class Object : public PointerValue {
     friend class EnumerateObjectWithIteration;
     friend struct ObjectRareData;
     friend class ObjectTemplate;
+    friend class HeapSnapshot;
 
 public:
     explicit Object(ExecutionState& state);
@@ -919,6 +920,16 @@ public:
         m_structure = m_structure->convertToNonTransitionStructure();
     }
 
+    // SetIntegrityLevel through one structure transition instead of [[DefineOwnProperty]] per property.
+    // returns false without any change when own properties of this object are not only in its structure
+    bool setIntegrityLevelWithStructure(ExecutionState& state, ObjectStructure::IntegrityLevel level);
+
+    // copies every own property of source at once by sharing its structure, when this object has no own property
+    // and source has only writable, enumerable and configurable plain data properties.
+    // with isSet, properties are copied only if Set() on this object would create them too (Object.assign)
+    // returns false without any change when the properties should be copied one by one
+    bool copyOwnPropertiesWithStructure(ExecutionState& state, Object* source, bool isSet);
+
     static void nextIndexForward(ExecutionState& state, Object* obj, const int64_t cur, const int64_t len, int64_t& nextIndex);
     static void nextIndexBackward(ExecutionState& state, Object* obj, const int64_t cur, const int64_t end, int64_t& nextIndex);
 
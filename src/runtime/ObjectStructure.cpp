@@ -22,6 +22,52 @@
 
 namespace Escargot {
 
+static bool hasNativeAccessorProperty(const ObjectStructureItem* properties, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        if (properties[i].m_descriptor.isNativeAccessorProperty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool isInIntegrityLevel(const ObjectStructureItem* properties, size_t size, ObjectStructure::IntegrityLevel level)
+{
+    for (size_t i = 0; i < size; i++) {
+        const auto& desc = properties[i].m_descriptor;
+        if (desc.isConfigurable()) {
+            return false;
+        }
+        if (level == ObjectStructure::Frozen && desc.isDataProperty() && desc.isWritable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static ObjectStructurePropertyDescriptor descriptorInIntegrityLevel(const ObjectStructurePropertyDescriptor& desc, ObjectStructure::IntegrityLevel level)
+{
+    ASSERT(!desc.isNativeAccessorProperty());
+    size_t attributes = desc.descriptorData().presentAttributes();
+    if (desc.isAccessorProperty()) {
+        // writable flag of accessor is recomputed from HasJSSetter
+        attributes &= (ObjectStructurePropertyDescriptor::EnumerablePresent | ObjectStructurePropertyDescriptor::HasJSGetter | ObjectStructurePropertyDescriptor::HasJSSetter);
+        return ObjectStructurePropertyDescriptor::createAccessorDescriptor((ObjectStructurePropertyDescriptor::PresentAttribute)attributes);
+    }
+
+    attributes &= (level == ObjectStructure::Frozen) ? ObjectStructurePropertyDescriptor::EnumerablePresent : (ObjectStructurePropertyDescriptor::WritablePresent | ObjectStructurePropertyDescriptor::EnumerablePresent);
+    return ObjectStructurePropertyDescriptor::createDataDescriptor((ObjectStructurePropertyDescriptor::PresentAttribute)attributes);
+}
+
+template <typename PropertyVector>
+static void convertDescriptorsToIntegrityLevel(PropertyVector& properties, ObjectStructure::IntegrityLevel level)
+{
+    for (size_t i = 0; i < properties.size(); i++) {
+        properties[i].m_descriptor = descriptorInIntegrityLevel(properties[i].m_descriptor, level);
+    }
+}
+
 void* ObjectStructureItemVector::operator new(size_t size)
 {
     static bool typeInited = false;
@@ -141,6 +187,18 @@ ObjectStructure* ObjectStructureWithoutTransition::replacePropertyDescriptor(siz
     return newStructure;
 }
 
+ObjectStructure* ObjectStructureWithoutTransition::convertToIntegrityLevel(IntegrityLevel level)
+{
+    if (hasNativeAccessorProperty(m_properties->data(), m_properties->size())) {
+        return nullptr;
+    }
+
+    convertDescriptorsToIntegrityLevel(*m_properties, level);
+    auto newStructure = new ObjectStructureWithoutTransition(m_properties, m_hasIndexPropertyName, m_hasNonAtomicPropertyName);
+    m_properties = nullptr;
+    return newStructure;
+}
+
 ObjectStructure* ObjectStructureWithoutTransition::convertToNonTransitionStructure()
 {
     return this;
@@ -154,6 +212,7 @@ void* ObjectStructureWithTransition::operator new(size_t size)
         GC_word obj_bitmap[GC_BITMAP_SIZE(ObjectStructureWithTransition)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithTransition, m_properties));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithTransition, m_transitionTableVectorBuffer));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithTransition, m_integrityLevelTransition));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ObjectStructureWithTransition));
         typeInited = true;
     }
@@ -298,6 +357,30 @@ ObjectStructure* ObjectStructureWithTransition::replacePropertyDescriptor(size_t
     return new ObjectStructureWithoutTransition(newProperties, m_hasIndexPropertyName, m_hasNonAtomicPropertyName);
 }
 
+ObjectStructure* ObjectStructureWithTransition::convertToIntegrityLevel(IntegrityLevel level)
+{
+    if (hasNativeAccessorProperty(m_properties.data(), m_properties.size())) {
+        return nullptr;
+    }
+
+    ObjectStructureWithTransition* structure = this;
+    while (!isInIntegrityLevel(structure->m_properties.data(), structure->m_properties.size(), level)) {
+        structure = structure->integrityLevelTransition();
+    }
+    return structure;
+}
+
+ObjectStructureWithTransition* ObjectStructureWithTransition::integrityLevelTransition()
+{
+    if (!m_integrityLevelTransition) {
+        IntegrityLevel level = isInIntegrityLevel(m_properties.data(), m_properties.size(), Sealed) ? Frozen : Sealed;
+        ObjectStructureItemTightVector newProperties(m_properties);
+        convertDescriptorsToIntegrityLevel(newProperties, level);
+        m_integrityLevelTransition = new ObjectStructureWithTransition(std::move(newProperties), m_hasIndexPropertyName, m_hasNonAtomicPropertyName);
+    }
+    return m_integrityLevelTransition;
+}
+
 ObjectStructure* ObjectStructureWithTransition::convertToNonTransitionStructure()
 {
     ObjectStructureItemVector* newProperties = new ObjectStructureItemVector(m_properties);
@@ -388,6 +471,19 @@ ObjectStructure* ObjectStructureWithMap::replacePropertyDescriptor(size_t idx, c
     return newStructure;
 }
 
+ObjectStructure* ObjectStructureWithMap::convertToIntegrityLevel(IntegrityLevel level)
+{
+    if (hasNativeAccessorProperty(m_properties->data(), m_properties->size())) {
+        return nullptr;
+    }
+
+    convertDescriptorsToIntegrityLevel(*m_properties, level);
+    ObjectStructure* newStructure = new ObjectStructureWithMap(m_properties, m_propertyNameMap, m_hasIndexPropertyName);
+    m_properties = nullptr;
+    m_propertyNameMap = nullptr;
+    return newStructure;
+}
+
 ObjectStructure* ObjectStructureWithMap::convertToNonTransitionStructure()
 {
     return this;
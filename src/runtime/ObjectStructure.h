@@ -106,6 +106,11 @@ public:
 
 class ObjectStructure : public gc {
 public:
+    enum IntegrityLevel {
+        Sealed, // every property is non-configurable
+        Frozen, // every property is non-configurable and every data property is non-writable
+    };
+
     virtual ~ObjectStructure() {}
     std::pair<size_t, Optional<const ObjectStructureItem*>> findProperty(ExecutionState& state, String* propertyName)
     {
@@ -126,6 +131,9 @@ public:
     virtual ObjectStructure* addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc) = 0;
     virtual ObjectStructure* removeProperty(size_t pIndex) = 0;
     virtual ObjectStructure* replacePropertyDescriptor(size_t idx, const ObjectStructurePropertyDescriptor& newDesc) = 0;
+    // rewrites every descriptor for the level at once.
+    // returns nullptr if there is a native accessor property. it should be redefined through its owner object
+    virtual ObjectStructure* convertToIntegrityLevel(IntegrityLevel level) = 0;
 
     virtual ObjectStructure* convertToNonTransitionStructure() = 0;
 
@@ -149,6 +157,7 @@ public:
     virtual ObjectStructure* addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc) override;
     virtual ObjectStructure* removeProperty(size_t pIndex) override;
     virtual ObjectStructure* replacePropertyDescriptor(size_t idx, const ObjectStructurePropertyDescriptor& newDesc) override;
+    virtual ObjectStructure* convertToIntegrityLevel(IntegrityLevel level) override;
     virtual ObjectStructure* convertToNonTransitionStructure() override;
 
     virtual bool inTransitionMode() override
@@ -180,6 +189,7 @@ public:
         , m_transitionTableVectorBufferSize(0)
         , m_transitionTableVectorBufferCapacity(0)
         , m_transitionTableVectorBuffer(nullptr)
+        , m_integrityLevelTransition(nullptr)
     {
     }
 
@@ -190,6 +200,7 @@ public:
     virtual ObjectStructure* addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc) override;
     virtual ObjectStructure* removeProperty(size_t pIndex) override;
     virtual ObjectStructure* replacePropertyDescriptor(size_t idx, const ObjectStructurePropertyDescriptor& newDesc) override;
+    virtual ObjectStructure* convertToIntegrityLevel(IntegrityLevel level) override;
     virtual ObjectStructure* convertToNonTransitionStructure() override;
 
     virtual bool inTransitionMode() override
@@ -215,6 +226,8 @@ private:
         return 1 << (base + 1);
     }
 
+    ObjectStructureWithTransition* integrityLevelTransition();
+
     ObjectStructureItemTightVector m_properties;
 
     bool m_doesTransitionTableUseMap : 1;
@@ -227,10 +240,15 @@ private:
         ObjectStructureTransitionVectorItem* m_transitionTableVectorBuffer;
         ObjectStructureTransitionTableMap* m_transitionTableMap;
     };
+
+    // the sealed structure of a structure which is not sealed,
+    // or the frozen structure of a sealed structure which is not frozen.
+    // so objects of the same shape share their sealed and frozen structures
+    ObjectStructureWithTransition* m_integrityLevelTransition;
 };
 
 COMPILE_ASSERT(ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_MIN_SIZE <= 32, "");
-COMPILE_ASSERT(sizeof(ObjectStructureWithTransition) == sizeof(size_t) * 5, "");
+COMPILE_ASSERT(sizeof(ObjectStructureWithTransition) == sizeof(size_t) * 6, "");
 
 class ObjectStructureWithMap : public ObjectStructure {
 public:
@@ -279,6 +297,7 @@ public:
     virtual ObjectStructure* addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc) override;
     virtual ObjectStructure* removeProperty(size_t pIndex) override;
     virtual ObjectStructure* replacePropertyDescriptor(size_t idx, const ObjectStructurePropertyDescriptor& newDesc) override;
+    virtual ObjectStructure* convertToIntegrityLevel(IntegrityLevel level) override;
     virtual ObjectStructure* convertToNonTransitionStructure() override;
 
     virtual bool inTransitionMode() override
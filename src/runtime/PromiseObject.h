@@ -74,6 +74,8 @@ public:
 };
 
 class PromiseObject : public Object {
+    friend class HeapSnapshot;
+
 public:
     enum PromiseState {
         Pending,
@@ -0,0 +1,1132 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "RegExpJIT.h"
+
+#if defined(ENABLE_REGEXP_JIT)
+
+#include "RegExpPrefilter.h"
+
+#include "WTFBridge.h"
+#include "Yarr.h"
+#include "YarrPattern.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Escargot {
+
+using JSC::Yarr::YarrPattern;
+using JSC::Yarr::PatternDisjunction;
+using JSC::Yarr::PatternAlternative;
+using JSC::Yarr::PatternTerm;
+using JSC::Yarr::CharacterClass;
+using JSC::Yarr::CharacterRange;
+
+// bail out of patterns which would produce unreasonably large code
+#define REGEXP_JIT_CODE_SIZE_MAX (1024 * 256)
+#define REGEXP_JIT_NESTING_DEPTH_MAX 32
+#define REGEXP_JIT_CLASS_COMPARE_MAX 64
+
+class RegExpJITAssembler {
+public:
+    enum Register {
+        rax,
+        rcx,
+        rdx,
+        rbx,
+        rsp,
+        rbp,
+        rsi,
+        rdi,
+        r8,
+        r9,
+        r10,
+        r11,
+    };
+
+    enum Condition {
+        Below = 0x2,
+        AboveOrEqual = 0x3,
+        Equal = 0x4,
+        NotEqual = 0x5,
+        BelowOrEqual = 0x6,
+        Above = 0x7,
+    };
+
+    typedef size_t Label;
+
+    Label newLabel()
+    {
+        m_labels.push_back(SIZE_MAX);
+        return m_labels.size() - 1;
+    }
+
+    void bind(Label label)
+    {
+        ASSERT(m_labels[label] == SIZE_MAX);
+        m_labels[label] = m_buffer.size();
+    }
+
+    // 256-bit tables are placed after the code and addressed rip-relatively
+    Label newTable(const uint32_t* bits)
+    {
+        Label label = newLabel();
+        m_tables.push_back(std::make_pair(label, std::vector<uint32_t>(bits, bits + 8)));
+        return label;
+    }
+
+    size_t offset() const
+    {
+        return m_buffer.size();
+    }
+
+    void jmp(Label target)
+    {
+        emit8(0xE9);
+        emitJumpTarget(target);
+    }
+
+    void jcc(Condition cond, Label target)
+    {
+        emit8(0x0F);
+        emit8(0x80 | cond);
+        emitJumpTarget(target);
+    }
+
+    void ret()
+    {
+        emit8(0xC3);
+    }
+
+    void mov64(Register dst, Register src)
+    {
+        rex(true, src, 0, dst);
+        emit8(0x89);
+        modrmReg(src, dst);
+    }
+
+    void mov32(Register dst, Register src)
+    {
+        rex(false, src, 0, dst);
+        emit8(0x89);
+        modrmReg(src, dst);
+    }
+
+    // zero extends to 64 bits
+    void mov32(Register dst, int32_t imm)
+    {
+        rex(false, 0, 0, dst);
+        emit8(0xB8 | (dst & 7));
+        emit32(imm);
+    }
+
+    void load64(Register dst, Register base, int32_t disp)
+    {
+        rex(true, dst, 0, base);
+        emit8(0x8B);
+        modrmMem(dst, base, disp);
+    }
+
+    void store64(Register base, int32_t disp, Register src)
+    {
+        rex(true, src, 0, base);
+        emit8(0x89);
+        modrmMem(src, base, disp);
+    }
+
+    // sign extends imm to 64 bits
+    void store64(Register base, int32_t disp, int32_t imm)
+    {
+        rex(true, 0, 0, base);
+        emit8(0xC7);
+        modrmMem(0, base, disp);
+        emit32(imm);
+    }
+
+    void store32(Register base, int32_t disp, Register src)
+    {
+        rex(false, src, 0, base);
+        emit8(0x89);
+        modrmMem(src, base, disp);
+    }
+
+    void store32(Register base, int32_t disp, int32_t imm)
+    {
+        rex(false, 0, 0, base);
+        emit8(0xC7);
+        modrmMem(0, base, disp);
+        emit32(imm);
+    }
+
+    // movzx dst, byte/word [base + index * charSize + disp]
+    void loadChar(Register dst, Register base, Register index, int32_t disp, bool is16Bit)
+    {
+        rex(false, dst, index, base);
+        emit8(0x0F);
+        emit8(is16Bit ? 0xB7 : 0xB6);
+        emit8(0x84 | ((dst & 7) << 3));
+        emit8(((is16Bit ? 1 : 0) << 6) | ((index & 7) << 3) | (base & 7));
+        emit32(disp);
+    }
+
+    void add64(Register dst, int32_t imm)
+    {
+        alu(true, 0, dst, imm);
+    }
+
+    void sub64(Register dst, int32_t imm)
+    {
+        alu(true, 5, dst, imm);
+    }
+
+    void cmp64(Register dst, int32_t imm)
+    {
+        alu(true, 7, dst, imm);
+    }
+
+    void sub32(Register dst, int32_t imm)
+    {
+        alu(false, 5, dst, imm);
+    }
+
+    void or32(Register dst, int32_t imm)
+    {
+        alu(false, 1, dst, imm);
+    }
+
+    void cmp32(Register dst, int32_t imm)
+    {
+        alu(false, 7, dst, imm);
+    }
+
+    // flags of (a - b)
+    void cmp64(Register a, Register b)
+    {
+        rex(true, b, 0, a);
+        emit8(0x39);
+        modrmReg(b, a);
+    }
+
+    // flags of (a - [base + disp])
+    void cmp64(Register a, Register base, int32_t disp)
+    {
+        rex(true, a, 0, base);
+        emit8(0x3B);
+        modrmMem(a, base, disp);
+    }
+
+    void sub64(Register base, int32_t disp, int32_t imm)
+    {
+        rex(true, 0, 0, base);
+        emit8(0x81);
+        modrmMem(5, base, disp);
+        emit32(imm);
+    }
+
+    void sub64(Register dst, Register base, int32_t disp)
+    {
+        rex(true, dst, 0, base);
+        emit8(0x2B);
+        modrmMem(dst, base, disp);
+    }
+
+    void cmova64(Register dst, Register src)
+    {
+        rex(true, dst, 0, src);
+        emit8(0x0F);
+        emit8(0x47);
+        modrmReg(dst, src);
+    }
+
+    void leaTable(Register dst, Label table)
+    {
+        rex(true, dst, 0, 0);
+        emit8(0x8D);
+        emit8(0x05 | ((dst & 7) << 3));
+        emitJumpTarget(table);
+    }
+
+    // bt dword [base], bit
+    void bitTest(Register base, Register bit)
+    {
+        rex(false, bit, 0, base);
+        emit8(0x0F);
+        emit8(0xA3);
+        modrmMem(bit, base, 0);
+    }
+
+    // CF is set by bitTest
+    void jumpIfCarry(Label target)
+    {
+        jcc(Below, target);
+    }
+
+    void patch32(size_t at, int32_t value)
+    {
+        memcpy(&m_buffer[at], &value, sizeof(value));
+    }
+
+    bool finalize()
+    {
+        for (size_t i = 0; i < m_tables.size(); i++) {
+            while (m_buffer.size() % 4) {
+                emit8(0xCC);
+            }
+            bind(m_tables[i].first);
+            const std::vector<uint32_t>& bits = m_tables[i].second;
+            for (size_t j = 0; j < bits.size(); j++) {
+                emit32(bits[j]);
+            }
+        }
+        for (size_t i = 0; i < m_jumps.size(); i++) {
+            size_t target = m_labels[m_jumps[i].second];
+            if (target == SIZE_MAX) {
+                return false;
+            }
+            patch32(m_jumps[i].first, static_cast<int32_t>(target - (m_jumps[i].first + 4)));
+        }
+        m_jumps.clear();
+        m_tables.clear();
+        return true;
+    }
+
+    const std::vector<uint8_t>& buffer() const
+    {
+        return m_buffer;
+    }
+
+private:
+    void emit8(uint8_t value)
+    {
+        m_buffer.push_back(value);
+    }
+
+    void emit32(int32_t value)
+    {
+        uint8_t bytes[4];
+        memcpy(bytes, &value, sizeof(value));
+        m_buffer.insert(m_buffer.end(), bytes, bytes + 4);
+    }
+
+    void emitJumpTarget(Label target)
+    {
+        m_jumps.push_back(std::make_pair(m_buffer.size(), target));
+        emit32(0);
+    }
+
+    void rex(bool w, int reg, int index, int base)
+    {
+        uint8_t prefix = 0x40 | (w ? 8 : 0) | ((reg & 8) >> 1) | ((index & 8) >> 2) | ((base & 8) >> 3);
+        if (prefix != 0x40) {
+            emit8(prefix);
+        }
+    }
+
+    void modrmReg(int reg, int rm)
+    {
+        emit8(0xC0 | ((reg & 7) << 3) | (rm & 7));
+    }
+
+    void modrmMem(int reg, int base, int32_t disp)
+    {
+        emit8(0x80 | ((reg & 7) << 3) | (base & 7));
+        if ((base & 7) == rsp) {
+            emit8(0x24);
+        }
+        emit32(disp);
+    }
+
+    void alu(bool w, int ext, Register dst, int32_t imm)
+    {
+        rex(w, 0, 0, dst);
+        emit8(0x81);
+        modrmReg(ext, dst);
+        emit32(imm);
+    }
+
+    std::vector<uint8_t> m_buffer;
+    std::vector<size_t> m_labels;
+    std::vector<std::pair<size_t, Label>> m_jumps;
+    std::vector<std::pair<Label, std::vector<uint32_t>>> m_tables;
+};
+
+/*
+ * Backtracking code generator.
+ *
+ * Every term gets forward code which falls through on success and jumps to the backtrack label
+ * of the previous term on failure. Terms which can match in more than one way also get a
+ * backtrack entry that tries the next way and then continues right after the term.
+ * A backtrack entry never relies on the current position; it reloads what it needs from its
+ * own frame slots. Groups are never repeated, so every term owns a fixed set of slots.
+ *
+ * Every backtrack entry spends one step of a budget kept in the frame, so patterns with
+ * exponential backtracking give up instead of running forever.
+ *
+ * Registers: rdi input, rsi length, rcx output, r8 position, r9 start of the current attempt.
+ * rax holds the character being tested, rdx / r10 / r11 are scratch.
+ */
+class RegExpJITCompiler {
+    typedef RegExpJITAssembler Asm;
+    typedef Asm::Label Label;
+
+public:
+    RegExpJITCompiler(YarrPattern& pattern, const RegExpPrefilter* prefilter, bool is16Bit)
+        : m_pattern(pattern)
+        , m_prefilter(prefilter)
+        , m_is16Bit(is16Bit)
+        , m_failed(false)
+        , m_depth(0)
+        , m_frameSlots(0)
+        , m_budgetSlot(0)
+        , m_hitLimit(0)
+    {
+    }
+
+    bool generate(Asm& masm)
+    {
+        m_masm = &masm;
+        generateMatchFunction();
+        patchFrameSize();
+        return !m_failed && masm.offset() < REGEXP_JIT_CODE_SIZE_MAX;
+    }
+
+private:
+    static const int32_t NoOffset = -1;
+
+    int32_t charSize() const
+    {
+        return m_is16Bit ? 2 : 1;
+    }
+
+    int32_t allocateSlot()
+    {
+        return 8 * (m_frameSlots++);
+    }
+
+    unsigned maxCharacter() const
+    {
+        return m_is16Bit ? 0xFFFF : 0xFF;
+    }
+
+    void generateBacktrackStep()
+    {
+        m_masm->sub64(Asm::rsp, m_budgetSlot, 1);
+        m_masm->jcc(Asm::Equal, m_hitLimit);
+    }
+
+    void loadCharacter(Asm::Register index, int32_t charOffset)
+    {
+        m_masm->loadChar(Asm::rax, Asm::rdi, index, charOffset * charSize(), m_is16Bit);
+    }
+
+    // jumps to noMatch unless eax is ch
+    void generateCharacterTest(UChar32 ch, Label noMatch)
+    {
+        if (static_cast<unsigned>(ch) > maxCharacter()) {
+            m_masm->jmp(noMatch);
+            return;
+        }
+        if (m_pattern.ignoreCase() && isASCIIAlpha(ch)) {
+            m_masm->or32(Asm::rax, 0x20);
+            m_masm->cmp32(Asm::rax, toASCIILower(ch));
+        } else {
+            m_masm->cmp32(Asm::rax, ch);
+        }
+        m_masm->jcc(Asm::NotEqual, noMatch);
+    }
+
+    // jumps to noMatch unless eax is (or, with invert, isn't) in the class
+    void generateClassTest(CharacterClass* characterClass, bool invert, Label noMatch)
+    {
+        if (characterClass->m_anyCharacter) {
+            if (invert) {
+                m_masm->jmp(noMatch);
+            }
+            return;
+        }
+
+        uint32_t latin1[8] = { 0 };
+        std::vector<CharacterRange> wide;
+        auto addRange = [&](UChar32 begin, UChar32 end) {
+            for (UChar32 ch = begin; ch <= end && ch <= 0xFF; ch++) {
+                latin1[ch >> 5] |= 1u << (ch & 31);
+            }
+            if (end > 0xFF && m_is16Bit) {
+                UChar32 wideBegin = std::max<UChar32>(begin, 0x100);
+                UChar32 wideEnd = std::min<UChar32>(end, 0xFFFF);
+                if (wideBegin <= wideEnd) {
+                    wide.push_back(CharacterRange(wideBegin, wideEnd));
+                }
+            }
+        };
+        for (size_t i = 0; i < characterClass->m_matches.size(); i++) {
+            addRange(characterClass->m_matches[i], characterClass->m_matches[i]);
+        }
+        for (size_t i = 0; i < characterClass->m_ranges.size(); i++) {
+            addRange(characterClass->m_ranges[i].begin, characterClass->m_ranges[i].end);
+        }
+        for (size_t i = 0; i < characterClass->m_matchesUnicode.size(); i++) {
+            addRange(characterClass->m_matchesUnicode[i], characterClass->m_matchesUnicode[i]);
+        }
+        for (size_t i = 0; i < characterClass->m_rangesUnicode.size(); i++) {
+            addRange(characterClass->m_rangesUnicode[i].begin, characterClass->m_rangesUnicode[i].end);
+        }
+        if (wide.size() > REGEXP_JIT_CLASS_COMPARE_MAX) {
+            m_failed = true;
+            return;
+        }
+
+        Label matched = m_masm->newLabel();
+        Label notMatched = m_masm->newLabel();
+        Label narrow = m_masm->newLabel();
+
+        if (m_is16Bit) {
+            m_masm->cmp32(Asm::rax, 0xFF);
+            m_masm->jcc(Asm::BelowOrEqual, narrow);
+            for (size_t i = 0; i < wide.size(); i++) {
+                if (wide[i].begin == wide[i].end) {
+                    m_masm->cmp32(Asm::rax, wide[i].begin);
+                    m_masm->jcc(Asm::Equal, matched);
+                } else {
+                    m_masm->mov32(Asm::rdx, Asm::rax);
+                    m_masm->sub32(Asm::rdx, wide[i].begin);
+                    m_masm->cmp32(Asm::rdx, wide[i].end - wide[i].begin);
+                    m_masm->jcc(Asm::BelowOrEqual, matched);
+                }
+            }
+            m_masm->jmp(notMatched);
+        }
+
+        m_masm->bind(narrow);
+        m_masm->leaTable(Asm::r10, m_masm->newTable(latin1));
+        m_masm->bitTest(Asm::r10, Asm::rax);
+        m_masm->jumpIfCarry(matched);
+
+        m_masm->bind(notMatched);
+        if (invert) {
+            Label done = m_masm->newLabel();
+            m_masm->jmp(done);
+            m_masm->bind(matched);
+            m_masm->jmp(noMatch);
+            m_masm->bind(done);
+        } else {
+            m_masm->jmp(noMatch);
+            m_masm->bind(matched);
+        }
+    }
+
+    void generateAtomTest(PatternTerm& term, Label noMatch)
+    {
+        if (term.type == PatternTerm::TypePatternCharacter) {
+            generateCharacterTest(term.patternCharacter, noMatch);
+        } else {
+            generateClassTest(term.characterClass, term.invert(), noMatch);
+        }
+    }
+
+    // falls through when the character before r8 (or at r8 with charOffset 0) is a line terminator
+    void generateNewlineTest(int32_t charOffset, Label noMatch)
+    {
+        loadCharacter(Asm::r8, charOffset);
+        generateClassTest(m_pattern.newlineCharacterClass(), false, noMatch);
+    }
+
+    Label generateAssertionBOL(Label fail)
+    {
+        m_masm->cmp64(Asm::r8, 0);
+        if (!m_pattern.multiline()) {
+            m_masm->jcc(Asm::NotEqual, fail);
+            return fail;
+        }
+        Label done = m_masm->newLabel();
+        m_masm->jcc(Asm::Equal, done);
+        generateNewlineTest(-1, fail);
+        m_masm->bind(done);
+        return fail;
+    }
+
+    Label generateAssertionEOL(Label fail)
+    {
+        m_masm->cmp64(Asm::r8, Asm::rsi);
+        if (!m_pattern.multiline()) {
+            m_masm->jcc(Asm::NotEqual, fail);
+            return fail;
+        }
+        Label done = m_masm->newLabel();
+        m_masm->jcc(Asm::Equal, done);
+        generateNewlineTest(0, fail);
+        m_masm->bind(done);
+        return fail;
+    }
+
+    Label generateAssertionWordBoundary(PatternTerm& term, Label fail)
+    {
+        CharacterClass* wordchar = m_pattern.wordcharCharacterClass();
+        Label done = m_masm->newLabel();
+        Label boundary = term.invert() ? fail : done;
+        Label noBoundary = term.invert() ? done : fail;
+        Label prevIsNotWord = m_masm->newLabel();
+
+        m_masm->cmp64(Asm::r8, 0);
+        m_masm->jcc(Asm::Equal, prevIsNotWord);
+        loadCharacter(Asm::r8, -1);
+        generateClassTest(wordchar, false, prevIsNotWord);
+
+        // the previous character is a word character
+        {
+            Label nextIsNotWord = m_masm->newLabel();
+            m_masm->cmp64(Asm::r8, Asm::rsi);
+            m_masm->jcc(Asm::AboveOrEqual, nextIsNotWord);
+            loadCharacter(Asm::r8, 0);
+            generateClassTest(wordchar, false, nextIsNotWord);
+            m_masm->jmp(noBoundary);
+            m_masm->bind(nextIsNotWord);
+            m_masm->jmp(boundary);
+        }
+
+        m_masm->bind(prevIsNotWord);
+        {
+            Label nextIsNotWord = m_masm->newLabel();
+            m_masm->cmp64(Asm::r8, Asm::rsi);
+            m_masm->jcc(Asm::AboveOrEqual, nextIsNotWord);
+            loadCharacter(Asm::r8, 0);
+            generateClassTest(wordchar, false, nextIsNotWord);
+            m_masm->jmp(boundary);
+            m_masm->bind(nextIsNotWord);
+            m_masm->jmp(noBoundary);
+        }
+
+        m_masm->bind(done);
+        return fail;
+    }
+
+    Label generateFixedAtom(PatternTerm& term, unsigned count, Label fail)
+    {
+        if (!count) {
+            return fail;
+        }
+        if (count == 1) {
+            m_masm->cmp64(Asm::r8, Asm::rsi);
+            m_masm->jcc(Asm::AboveOrEqual, fail);
+            loadCharacter(Asm::r8, 0);
+            generateAtomTest(term, fail);
+            m_masm->add64(Asm::r8, 1);
+            return fail;
+        }
+
+        m_masm->mov64(Asm::r11, Asm::r8);
+        m_masm->add64(Asm::r11, count);
+        m_masm->cmp64(Asm::r11, Asm::rsi);
+        m_masm->jcc(Asm::Above, fail);
+        if (count <= 8) {
+            for (unsigned i = 0; i < count; i++) {
+                loadCharacter(Asm::r8, i);
+                generateAtomTest(term, fail);
+            }
+            m_masm->add64(Asm::r8, count);
+        } else {
+            Label loop = m_masm->newLabel();
+            m_masm->mov32(Asm::r11, count);
+            m_masm->bind(loop);
+            loadCharacter(Asm::r8, 0);
+            generateAtomTest(term, fail);
+            m_masm->add64(Asm::r8, 1);
+            m_masm->sub64(Asm::r11, 1);
+            m_masm->jcc(Asm::NotEqual, loop);
+        }
+        return fail;
+    }
+
+    Label generateGreedyAtom(PatternTerm& term, unsigned min, unsigned max, Label fail)
+    {
+        int32_t beginSlot = allocateSlot();
+        int32_t endSlot = allocateSlot();
+        Label loop = m_masm->newLabel();
+        Label loopDone = m_masm->newLabel();
+        Label next = m_masm->newLabel();
+        Label backtrack = m_masm->newLabel();
+
+        m_masm->store64(Asm::rsp, beginSlot, Asm::r8);
+        // r11 = min(position + max, length)
+        Asm::Register limit = Asm::rsi;
+        if (max != JSC::Yarr::quantifyInfinite) {
+            limit = Asm::r11;
+            m_masm->mov64(Asm::r11, Asm::r8);
+            m_masm->add64(Asm::r11, max);
+            m_masm->cmp64(Asm::r11, Asm::rsi);
+            m_masm->cmova64(Asm::r11, Asm::rsi);
+        }
+        m_masm->bind(loop);
+        m_masm->cmp64(Asm::r8, limit);
+        m_masm->jcc(Asm::AboveOrEqual, loopDone);
+        loadCharacter(Asm::r8, 0);
+        generateAtomTest(term, loopDone);
+        m_masm->add64(Asm::r8, 1);
+        m_masm->jmp(loop);
+
+        m_masm->bind(loopDone);
+        if (min) {
+            m_masm->mov64(Asm::r11, Asm::r8);
+            m_masm->sub64(Asm::r11, Asm::rsp, beginSlot);
+            m_masm->cmp64(Asm::r11, min);
+            m_masm->jcc(Asm::Below, fail);
+        }
+        m_masm->store64(Asm::rsp, endSlot, Asm::r8);
+        m_masm->jmp(next);
+
+        // give back one character
+        m_masm->bind(backtrack);
+        generateBacktrackStep();
+        m_masm->load64(Asm::r8, Asm::rsp, endSlot);
+        m_masm->mov64(Asm::r11, Asm::r8);
+        m_masm->sub64(Asm::r11, Asm::rsp, beginSlot);
+        m_masm->cmp64(Asm::r11, min);
+        m_masm->jcc(Asm::BelowOrEqual, fail);
+        m_masm->sub64(Asm::r8, 1);
+        m_masm->store64(Asm::rsp, endSlot, Asm::r8);
+
+        m_masm->bind(next);
+        return backtrack;
+    }
+
+    Label generateNonGreedyAtom(PatternTerm& term, unsigned min, unsigned max, Label fail)
+    {
+        int32_t beginSlot = allocateSlot();
+        int32_t endSlot = allocateSlot();
+        Label next = m_masm->newLabel();
+        Label backtrack = m_masm->newLabel();
+
+        m_masm->store64(Asm::rsp, beginSlot, Asm::r8);
+        generateFixedAtom(term, min, fail);
+        m_masm->store64(Asm::rsp, endSlot, Asm::r8);
+        m_masm->jmp(next);
+
+        // take one more character
+        m_masm->bind(backtrack);
+        generateBacktrackStep();
+        m_masm->load64(Asm::r8, Asm::rsp, endSlot);
+        if (max != JSC::Yarr::quantifyInfinite) {
+            m_masm->mov64(Asm::r11, Asm::r8);
+            m_masm->sub64(Asm::r11, Asm::rsp, beginSlot);
+            m_masm->cmp64(Asm::r11, max);
+            m_masm->jcc(Asm::AboveOrEqual, fail);
+        }
+        m_masm->cmp64(Asm::r8, Asm::rsi);
+        m_masm->jcc(Asm::AboveOrEqual, fail);
+        loadCharacter(Asm::r8, 0);
+        generateAtomTest(term, fail);
+        m_masm->add64(Asm::r8, 1);
+        m_masm->store64(Asm::rsp, endSlot, Asm::r8);
+
+        m_masm->bind(next);
+        return backtrack;
+    }
+
+    Label generateAtom(PatternTerm& term, Label fail)
+    {
+        if (term.type == PatternTerm::TypePatternCharacter && m_pattern.ignoreCase() && !isASCII(term.patternCharacter)) {
+            // the interpreter folds these with ICU case mappings
+            m_failed = true;
+            return fail;
+        }
+
+        unsigned min = term.quantityMinCount.unsafeGet();
+        unsigned max = term.quantityMaxCount.unsafeGet();
+        switch (term.quantityType) {
+        case JSC::Yarr::QuantifierFixedCount:
+            return generateFixedAtom(term, max, fail);
+        case JSC::Yarr::QuantifierGreedy:
+            return generateGreedyAtom(term, min, max, fail);
+        case JSC::Yarr::QuantifierNonGreedy:
+            return generateNonGreedyAtom(term, min, max, fail);
+        }
+        m_failed = true;
+        return fail;
+    }
+
+    void storeCapture(unsigned subpatternId, int32_t beginSlot)
+    {
+        m_masm->load64(Asm::r11, Asm::rsp, beginSlot);
+        m_masm->store32(Asm::rcx, subpatternId * 8, Asm::r11);
+        m_masm->store32(Asm::rcx, subpatternId * 8 + 4, Asm::r8);
+    }
+
+    void clearCapture(unsigned subpatternId)
+    {
+        m_masm->store32(Asm::rcx, subpatternId * 8, NoOffset);
+        m_masm->store32(Asm::rcx, subpatternId * 8 + 4, NoOffset);
+    }
+
+    // emits every alternative of the group. returns the label which re-enters the last matched alternative
+    Label generateAlternatives(PatternDisjunction* disjunction, int32_t beginSlot, int32_t alternativeSlot, Label matched, Label exhausted)
+    {
+        std::vector<Label> alternativeBacktracks;
+        for (size_t i = 0; i < disjunction->m_alternatives.size(); i++) {
+            Label alternativeFail = m_masm->newLabel();
+            m_masm->store64(Asm::rsp, alternativeSlot, static_cast<int32_t>(i));
+            alternativeBacktracks.push_back(generateTerms(disjunction->m_alternatives[i].get(), alternativeFail));
+            m_masm->jmp(matched);
+            m_masm->bind(alternativeFail);
+            m_masm->load64(Asm::r8, Asm::rsp, beginSlot);
+        }
+        m_masm->jmp(exhausted);
+
+        Label backtrack = m_masm->newLabel();
+        m_masm->bind(backtrack);
+        generateBacktrackStep();
+        m_masm->load64(Asm::r11, Asm::rsp, alternativeSlot);
+        for (size_t i = 0; i + 1 < alternativeBacktracks.size(); i++) {
+            m_masm->cmp64(Asm::r11, static_cast<int32_t>(i));
+            m_masm->jcc(Asm::Equal, alternativeBacktracks[i]);
+        }
+        m_masm->jmp(alternativeBacktracks.back());
+        return backtrack;
+    }
+
+    Label generateParentheses(PatternTerm& term, Label fail)
+    {
+        unsigned min = term.quantityMinCount.unsafeGet();
+        unsigned max = term.quantityMaxCount.unsafeGet();
+        if (max != 1 || min > 1 || !term.parentheses.disjunction->m_alternatives.size()) {
+            m_failed = true;
+            return fail;
+        }
+
+        int32_t beginSlot = allocateSlot();
+        int32_t alternativeSlot = allocateSlot();
+        bool capture = term.capture();
+        unsigned subpatternId = term.parentheses.subpatternId;
+
+        Label matched = m_masm->newLabel();
+        Label exhausted = m_masm->newLabel();
+
+        if (min == 1) {
+            m_masm->store64(Asm::rsp, beginSlot, Asm::r8);
+            Label alternativesBacktrack = generateAlternatives(term.parentheses.disjunction, beginSlot, alternativeSlot, matched, exhausted);
+
+            m_masm->bind(exhausted);
+            if (capture) {
+                clearCapture(subpatternId);
+            }
+            m_masm->jmp(fail);
+
+            m_masm->bind(matched);
+            if (capture) {
+                storeCapture(subpatternId, beginSlot);
+            }
+            return alternativesBacktrack;
+        }
+
+        // (...)? and (...)?? : alternativeSlot is -1 while the group is skipped.
+        // an iteration which matches the empty string is rejected as the spec's RepeatMatcher does
+        Label next = m_masm->newLabel();
+        Label backtrack = m_masm->newLabel();
+        Label enter = m_masm->newLabel();
+        Label skip = m_masm->newLabel();
+        m_masm->store64(Asm::rsp, beginSlot, Asm::r8);
+        if (term.quantityType == JSC::Yarr::QuantifierNonGreedy) {
+            m_masm->jmp(skip);
+        }
+
+        m_masm->bind(enter);
+        m_masm->load64(Asm::r8, Asm::rsp, beginSlot);
+        Label alternativesBacktrack = generateAlternatives(term.parentheses.disjunction, beginSlot, alternativeSlot, matched, exhausted);
+
+        m_masm->bind(exhausted);
+        if (capture) {
+            clearCapture(subpatternId);
+        }
+        if (term.quantityType == JSC::Yarr::QuantifierNonGreedy) {
+            m_masm->jmp(fail);
+        } else {
+            m_masm->bind(skip);
+            m_masm->load64(Asm::r8, Asm::rsp, beginSlot);
+            m_masm->store64(Asm::rsp, alternativeSlot, NoOffset);
+            m_masm->jmp(next);
+        }
+        if (term.quantityType == JSC::Yarr::QuantifierNonGreedy) {
+            m_masm->bind(skip);
+            m_masm->store64(Asm::rsp, alternativeSlot, NoOffset);
+            m_masm->jmp(next);
+        }
+
+        m_masm->bind(backtrack);
+        generateBacktrackStep();
+        m_masm->load64(Asm::r11, Asm::rsp, alternativeSlot);
+        m_masm->cmp64(Asm::r11, NoOffset);
+        m_masm->jcc(Asm::NotEqual, alternativesBacktrack);
+        if (term.quantityType == JSC::Yarr::QuantifierNonGreedy) {
+            m_masm->jmp(enter);
+        } else {
+            m_masm->jmp(fail);
+        }
+
+        m_masm->bind(matched);
+        m_masm->cmp64(Asm::r8, Asm::rsp, beginSlot);
+        m_masm->jcc(Asm::Equal, alternativesBacktrack);
+        if (capture) {
+            storeCapture(subpatternId, beginSlot);
+        }
+        m_masm->bind(next);
+        return backtrack;
+    }
+
+    Label generateTerm(PatternTerm& term, Label fail)
+    {
+        switch (term.type) {
+        case PatternTerm::TypeAssertionBOL:
+            return generateAssertionBOL(fail);
+        case PatternTerm::TypeAssertionEOL:
+            return generateAssertionEOL(fail);
+        case PatternTerm::TypeAssertionWordBoundary:
+            return generateAssertionWordBoundary(term, fail);
+        case PatternTerm::TypePatternCharacter:
+        case PatternTerm::TypeCharacterClass:
+            return generateAtom(term, fail);
+        case PatternTerm::TypeParenthesesSubpattern:
+            return generateParentheses(term, fail);
+        case PatternTerm::TypeForwardReference:
+            // always matches the empty string
+            return fail;
+        default:
+            m_failed = true;
+            return fail;
+        }
+    }
+
+    Label generateTerms(PatternAlternative* alternative, Label fail)
+    {
+        if (++m_depth > REGEXP_JIT_NESTING_DEPTH_MAX) {
+            m_failed = true;
+        }
+        Label backtrack = fail;
+        for (size_t i = 0; i < alternative->m_terms.size() && !m_failed; i++) {
+            backtrack = generateTerm(alternative->m_terms[i], backtrack);
+        }
+        m_depth--;
+        return backtrack;
+    }
+
+    // skip start positions with the prefilter's first-character set
+    void generateStartScan(Label tryMatch, Label noMatch)
+    {
+        if (!m_prefilter || m_pattern.sticky()) {
+            return;
+        }
+
+        Label scan = m_masm->newLabel();
+        Label skip = m_masm->newLabel();
+        m_masm->bind(scan);
+        if (m_prefilter->startIsCandidate()) {
+            m_masm->cmp64(Asm::r9, 0);
+            m_masm->jcc(Asm::Equal, tryMatch);
+        }
+        if (m_prefilter->onlyAtStart()) {
+            m_masm->jmp(noMatch);
+            return;
+        }
+        m_masm->cmp64(Asm::r9, Asm::rsi);
+        m_masm->jcc(Asm::AboveOrEqual, noMatch);
+        loadCharacter(Asm::r9, 0);
+        if (m_is16Bit) {
+            m_masm->cmp32(Asm::rax, 0xFF);
+            m_masm->jcc(Asm::Above, m_prefilter->mayStartWithNonLatin1() ? tryMatch : skip);
+        }
+        m_masm->leaTable(Asm::r10, m_masm->newTable(m_prefilter->firstCharacters()));
+        m_masm->bitTest(Asm::r10, Asm::rax);
+        m_masm->jumpIfCarry(tryMatch);
+        m_masm->bind(skip);
+        m_masm->add64(Asm::r9, 1);
+        m_masm->jmp(scan);
+    }
+
+    void generateMatchFunction()
+    {
+        PatternDisjunction* body = m_pattern.m_body;
+        if (m_pattern.unicode() || !body || !body->m_alternatives.size()) {
+            m_failed = true;
+            return;
+        }
+
+        // the frame size is patched into "sub rsp, imm32" once every slot is known
+        m_masm->sub64(Asm::rsp, 0);
+        m_frameSizeOffset = m_masm->offset() - 4;
+        int32_t initialStartSlot = allocateSlot();
+        m_budgetSlot = allocateSlot();
+        m_hitLimit = m_masm->newLabel();
+
+        Label attempt = m_masm->newLabel();
+        Label tryMatch = m_masm->newLabel();
+        Label matched = m_masm->newLabel();
+        Label exhausted = m_masm->newLabel();
+        Label noMatch = m_masm->newLabel();
+
+        m_masm->mov32(Asm::rsi, Asm::rsi);
+        m_masm->mov32(Asm::r9, Asm::rdx);
+        m_masm->store64(Asm::rsp, initialStartSlot, Asm::r9);
+        // one budget for the whole call, like remainingMatchCount of the interpreter
+        m_masm->store64(Asm::rsp, m_budgetSlot, static_cast<int32_t>(JSC::Yarr::matchLimit));
+        for (unsigned i = 0; i <= m_pattern.m_numSubpatterns; i++) {
+            clearCapture(i);
+        }
+
+        m_masm->bind(attempt);
+        m_masm->cmp64(Asm::r9, Asm::rsi);
+        m_masm->jcc(Asm::Above, noMatch);
+        generateStartScan(tryMatch, noMatch);
+        m_masm->bind(tryMatch);
+        m_masm->mov64(Asm::r8, Asm::r9);
+
+        for (size_t i = 0; i < body->m_alternatives.size() && !m_failed; i++) {
+            PatternAlternative* alternative = body->m_alternatives[i].get();
+            Label alternativeFail = m_masm->newLabel();
+            if (alternative->onceThrough()) {
+                m_masm->cmp64(Asm::r9, Asm::rsp, initialStartSlot);
+                m_masm->jcc(Asm::NotEqual, alternativeFail);
+            }
+            generateTerms(alternative, alternativeFail);
+            m_masm->jmp(matched);
+            m_masm->bind(alternativeFail);
+            m_masm->mov64(Asm::r8, Asm::r9);
+        }
+
+        m_masm->bind(exhausted);
+        if (!m_pattern.sticky()) {
+            m_masm->add64(Asm::r9, 1);
+            m_masm->jmp(attempt);
+        }
+
+        m_masm->bind(noMatch);
+        m_masm->bind(m_hitLimit);
+        m_masm->mov32(Asm::rax, NoOffset);
+        generateEpilogue();
+
+        m_masm->bind(matched);
+        m_masm->store32(Asm::rcx, 0, Asm::r9);
+        m_masm->store32(Asm::rcx, 4, Asm::r8);
+        m_masm->mov32(Asm::rax, Asm::r9);
+        generateEpilogue();
+    }
+
+    void generateEpilogue()
+    {
+        m_masm->add64(Asm::rsp, 0);
+        m_epilogues.push_back(m_masm->offset() - 4);
+        m_masm->ret();
+    }
+
+    void patchFrameSize()
+    {
+        // keep rsp 16-byte aligned like any other frame
+        int32_t frameSize = 8 * m_frameSlots;
+        if (frameSize % 16 == 0) {
+            frameSize += 8;
+        }
+        m_masm->patch32(m_frameSizeOffset, frameSize);
+        for (size_t i = 0; i < m_epilogues.size(); i++) {
+            m_masm->patch32(m_epilogues[i], frameSize);
+        }
+    }
+
+    YarrPattern& m_pattern;
+    const RegExpPrefilter* m_prefilter;
+    Asm* m_masm;
+    bool m_is16Bit;
+    bool m_failed;
+    unsigned m_depth;
+    unsigned m_frameSlots;
+    int32_t m_budgetSlot;
+    Label m_hitLimit;
+    size_t m_frameSizeOffset;
+    std::vector<size_t> m_epilogues;
+};
+
+RegExpJITCode::RegExpJITCode(void* memory, size_t memorySize, size_t codeSize, size_t entry16Offset)
+    : m_memory(memory)
+    , m_memorySize(memorySize)
+    , m_codeSize(codeSize)
+    , m_entry16Offset(entry16Offset)
+{
+    GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void* cd) {
+        RegExpJITCode* code = (RegExpJITCode*)obj;
+        code->release();
+    },
+                                   NULL, NULL, NULL);
+}
+
+unsigned RegExpJITCode::execute(const LChar* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter) const
+{
+    if (prefilter) {
+        start = prefilter->nextCandidate(input, length, start);
+        if (start == RegExpPrefilter::NoCandidate) {
+            return JSC::Yarr::offsetNoMatch;
+        }
+    }
+    return reinterpret_cast<MatchFunction8>(m_memory)(input, length, start, output);
+}
+
+unsigned RegExpJITCode::execute(const char16_t* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter) const
+{
+    if (prefilter) {
+        start = prefilter->nextCandidate(input, length, start);
+        if (start == RegExpPrefilter::NoCandidate) {
+            return JSC::Yarr::offsetNoMatch;
+        }
+    }
+    return reinterpret_cast<MatchFunction16>(static_cast<char*>(m_memory) + m_entry16Offset)(input, length, start, output);
+}
+
+void RegExpJITCode::release()
+{
+    if (m_memory) {
+        munmap(m_memory, m_memorySize);
+        m_memory = nullptr;
+    }
+}
+
+RegExpJITCode* RegExpJITCode::compile(JSC::Yarr::YarrPattern& pattern, const RegExpPrefilter* prefilter)
+{
+    RegExpJITAssembler masm;
+    if (!RegExpJITCompiler(pattern, prefilter, false).generate(masm)) {
+        return nullptr;
+    }
+    size_t entry16Offset = masm.offset();
+    if (!RegExpJITCompiler(pattern, prefilter, true).generate(masm) || !masm.finalize()) {
+        return nullptr;
+    }
+
+    const std::vector<uint8_t>& code = masm.buffer();
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t memorySize = (code.size() + pageSize - 1) & ~(pageSize - 1);
+    void* memory = mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, memorySize, PROT_READ | PROT_EXEC)) {
+        munmap(memory, memorySize);
+        return nullptr;
+    }
+    return new RegExpJITCode(memory, memorySize, code.size(), entry16Offset);
+}
+} // namespace Escargot
+
+#endif
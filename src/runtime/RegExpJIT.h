@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotRegExpJIT__
+#define __EscargotRegExpJIT__
+
+#if defined(ENABLE_REGEXP_JIT)
+
+namespace JSC {
+namespace Yarr {
+struct YarrPattern;
+}
+}
+
+namespace Escargot {
+
+class RegExpPrefilter;
+
+/*
+ * Native x86-64 matcher for a subset of Yarr patterns.
+ *
+ * Supported: pattern characters, character classes, alternatives, greedy / non-greedy / fixed
+ * quantifiers on single characters, capturing and non-capturing groups which are matched once
+ * or optionally (?, ??), and the ^ $ \b \B assertions.
+ * Anything else (unicode patterns, back references, lookaheads, repeated groups...) makes compile()
+ * return nullptr and the caller keeps using the bytecode interpreter.
+ *
+ * The generated functions follow JSC::Yarr::interpret: they return the match start or offsetNoMatch
+ * and fill output with (start, end) pairs for the whole match and every subpattern.
+ * A call may backtrack JSC::Yarr::matchLimit times over all start positions. Past that it gives
+ * up with offsetNoMatch, which is what the interpreter returns when it hits its own limit.
+ */
+class RegExpJITCode : public gc {
+public:
+    static RegExpJITCode* compile(JSC::Yarr::YarrPattern& pattern, const RegExpPrefilter* prefilter);
+
+    // prefilter is used to find the first start position like JSC::Yarr::interpret does (nullptr for sticky)
+    unsigned execute(const LChar* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter) const;
+    unsigned execute(const char16_t* input, unsigned length, unsigned start, unsigned* output, const RegExpPrefilter* prefilter) const;
+
+    size_t codeSize() const
+    {
+        return m_codeSize;
+    }
+
+    void* operator new(size_t size)
+    {
+        return GC_MALLOC_ATOMIC(size);
+    }
+    void* operator new[](size_t size) = delete;
+
+private:
+    typedef unsigned (*MatchFunction8)(const LChar*, unsigned, unsigned, unsigned*);
+    typedef unsigned (*MatchFunction16)(const char16_t*, unsigned, unsigned, unsigned*);
+
+    RegExpJITCode(void* memory, size_t memorySize, size_t codeSize, size_t entry16Offset);
+    void release();
+
+    void* m_memory;
+    size_t m_memorySize;
+    size_t m_codeSize;
+    size_t m_entry16Offset;
+};
+} // namespace Escargot
+
+#endif
+
+#endif
@@ -22,6 +22,8 @@
 #include "Context.h"
 #include "ArrayObject.h"
 #include "VMInstance.h"
+#include "RegExpPrefilter.h"
+#include "RegExpJIT.h"
 
 #include "WTFBridge.h"
 #include "Yarr.h"
@@ -59,6 +61,10 @@ RegExpObject::RegExpObject(ExecutionState& state, Object* proto, bool hasLastInd
     , m_option(None)
     , m_yarrPattern(NULL)
     , m_bytecodePattern(NULL)
+    , m_prefilter(NULL)
+#if defined(ENABLE_REGEXP_JIT)
+    , m_jitCode(NULL)
+#endif
     , m_lastIndex(Value(0))
     , m_lastExecutedString(NULL)
 {
@@ -91,6 +97,10 @@ void* RegExpObject::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_optionString));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_yarrPattern));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_bytecodePattern));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_prefilter));
+#if defined(ENABLE_REGEXP_JIT)
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_jitCode));
+#endif
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_lastIndex));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_lastExecutedString));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(RegExpObject));
@@ -177,6 +187,10 @@ void RegExpObject::internalInit(ExecutionState& state, String* source, String* o
     setLastIndex(state, Value(0));
     m_yarrPattern = entry.m_yarrPattern;
     m_bytecodePattern = entry.m_bytecodePattern;
+    m_prefilter = entry.m_prefilter;
+#if defined(ENABLE_REGEXP_JIT)
+    m_jitCode = entry.m_jitCode;
+#endif
 }
 
 void RegExpObject::init(ExecutionState& state, String* source, String* option)
@@ -266,16 +280,37 @@ void RegExpObject::setOption(const Option& option)
         || ((m_option & Option::IgnoreCase) != (option & Option::IgnoreCase))) {
         ASSERT(!m_yarrPattern);
         m_bytecodePattern = NULL;
+        m_prefilter = NULL;
+#if defined(ENABLE_REGEXP_JIT)
+        m_jitCode = NULL;
+#endif
     }
     m_option = option;
 }
 
+static size_t regExpCacheEntrySize(String* source, const RegExpObject::RegExpCacheEntry& entry)
+{
+    size_t size = sizeof(RegExpObject::RegExpCacheEntry) + source->length() * (source->has8BitContent() ? 1 : 2);
+    if (entry.m_bytecodePattern) {
+        size += entry.m_bytecodePattern->estimatedSizeInBytes();
+    }
+    if (entry.m_prefilter) {
+        size += sizeof(RegExpPrefilter);
+    }
+#if defined(ENABLE_REGEXP_JIT)
+    if (entry.m_jitCode) {
+        size += entry.m_jitCode->codeSize();
+    }
+#endif
+    return size;
+}
+
 RegExpObject::RegExpCacheEntry& RegExpObject::getCacheEntryAndCompileIfNeeded(ExecutionState& state, String* source, const Option& option)
 {
     auto cache = state.context()->regexpCache();
-    auto it = cache->find(RegExpCacheKey(source, option));
-    if (it != cache->end()) {
-        return it->second;
+    RegExpCacheEntry* cached = cache->find(RegExpCacheKey(source, option));
+    if (cached) {
+        return *cached;
     } else {
         const char* yarrError = nullptr;
         JSC::Yarr::YarrPattern* yarrPattern = nullptr;
@@ -286,7 +321,8 @@ RegExpObject::RegExpCacheEntry& RegExpObject::getCacheEntryAndCompileIfNeeded(Ex
         } catch (const std::bad_alloc& e) {
             ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "got too complicated RegExp pattern to process");
         }
-        return cache->insert(std::make_pair(RegExpCacheKey(source, option), RegExpCacheEntry(yarrError, yarrPattern))).first->second;
+        RegExpCacheEntry entry(yarrError, yarrPattern);
+        return cache->insert(RegExpCacheKey(source, option), entry, regExpCacheEntrySize(source, entry));
     }
 }
 
@@ -302,7 +338,6 @@ bool RegExpObject::matchNonGlobally(ExecutionState& state, String* str, RegexMat
 bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& matchResult, bool testOnly, size_t startIndex)
 {
     Context::RegExpStatus& globalRegExpStatus = state.context()->regexpStatus();
-    globalRegExpStatus.input = str;
 
     m_lastExecutedString = str;
 
@@ -317,11 +352,21 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
         if (entry.m_bytecodePattern) {
             m_bytecodePattern = entry.m_bytecodePattern;
         } else {
+            entry.m_prefilter = RegExpPrefilter::create(*m_yarrPattern);
+#if defined(ENABLE_REGEXP_JIT)
+            // byteCompile takes over the character classes of m_yarrPattern, so the native code is generated first
+            entry.m_jitCode = RegExpJITCode::compile(*m_yarrPattern, entry.m_prefilter);
+#endif
             WTF::BumpPointerAllocator* bumpAlloc = state.context()->bumpPointerAllocator();
             std::unique_ptr<JSC::Yarr::BytecodePattern> ownedBytecode = JSC::Yarr::byteCompile(*m_yarrPattern, bumpAlloc);
             m_bytecodePattern = ownedBytecode.release();
             entry.m_bytecodePattern = m_bytecodePattern;
+            state.context()->regexpCache()->updateByteSize(entry, regExpCacheEntrySize(m_source, entry));
         }
+        m_prefilter = entry.m_prefilter;
+#if defined(ENABLE_REGEXP_JIT)
+        m_jitCode = entry.m_jitCode;
+#endif
     }
 
     unsigned subPatternNum = m_bytecodePattern->m_body->m_numSubpatterns;
@@ -331,6 +376,8 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
     unsigned result = 0;
     bool isGlobal = option() & RegExpObject::Option::Global;
     bool isSticky = option() & RegExpObject::Option::Sticky;
+    // a sticky match may only begin at start
+    const RegExpPrefilter* prefilter = isSticky ? nullptr : m_prefilter;
     bool gotResult = false;
     bool reachToEnd = false;
     unsigned* outputBuf = ALLOCA(sizeof(unsigned) * 2 * (subPatternNum + 1), unsigned int, state);
@@ -341,70 +388,34 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
         if (start > length) {
             break;
         }
-        if (LIKELY(str->has8BitContent()))
-            result = JSC::Yarr::interpret(m_bytecodePattern, str->characters8(), length, start, outputBuf);
-        else
-            result = JSC::Yarr::interpret(m_bytecodePattern, (const UChar*)str->characters16(), length, start, outputBuf);
+#if defined(ENABLE_REGEXP_JIT)
+        if (m_jitCode) {
+            if (LIKELY(str->has8BitContent()))
+                result = m_jitCode->execute(str->characters8(), length, start, outputBuf, prefilter);
+            else
+                result = m_jitCode->execute(str->characters16(), length, start, outputBuf, prefilter);
+        } else
+#endif
+        {
+            if (LIKELY(str->has8BitContent()))
+                result = JSC::Yarr::interpret(m_bytecodePattern, str->characters8(), length, start, outputBuf, prefilter);
+            else
+                result = JSC::Yarr::interpret(m_bytecodePattern, (const UChar*)str->characters16(), length, start, outputBuf, prefilter);
+        }
 
         if (result != JSC::Yarr::offsetNoMatch) {
             gotResult = true;
-            unsigned maxMatchedIndex = subPatternNum;
-
-            bool lastParenInvalid = false;
-            for (; maxMatchedIndex > 0; maxMatchedIndex--) {
-                if (outputBuf[maxMatchedIndex * 2] != std::numeric_limits<unsigned>::max()) {
-                    break;
-                } else {
-                    lastParenInvalid = true;
-                }
-            }
-
-            // Details:{3, 10, 3, 10, 3, 6, 7, 10, 1684872, 806200}
-            globalRegExpStatus.dollarCount = maxMatchedIndex;
-            unsigned dollarEnd = std::min(maxMatchedIndex, (unsigned)9);
-            for (unsigned i = 1; i <= dollarEnd; i++) {
-                if (outputBuf[i * 2] == std::numeric_limits<unsigned>::max()) {
-                    globalRegExpStatus.dollars[i - 1] = StringView();
-                } else {
-                    globalRegExpStatus.dollars[i - 1] = StringView(str, outputBuf[i * 2], outputBuf[i * 2 + 1]);
-                }
-            }
-
             if (UNLIKELY(testOnly)) {
                 // outputBuf[1] should be set to lastIndex
                 if (isGlobal || isSticky) {
                     setLastIndex(state, Value(outputBuf[1]));
                 }
-                if (!lastParenInvalid && subPatternNum) {
-                    globalRegExpStatus.lastParen = StringView(str, outputBuf[maxMatchedIndex * 2], outputBuf[maxMatchedIndex * 2 + 1]);
-                } else {
-                    globalRegExpStatus.lastParen = StringView();
-                }
-                globalRegExpStatus.lastMatch = StringView(str, outputBuf[0], outputBuf[1]);
-                globalRegExpStatus.leftContext = StringView(str, 0, outputBuf[0]);
-                globalRegExpStatus.rightContext = StringView(str, outputBuf[1], length);
+                globalRegExpStatus.update(str, outputBuf, subPatternNum);
                 return true;
             }
-            std::vector<RegexMatchResult::RegexMatchResultPiece> piece;
-            piece.resize(subPatternNum + 1);
-
-            for (unsigned i = 0; i < subPatternNum + 1; i++) {
-                RegexMatchResult::RegexMatchResultPiece p;
-                p.m_start = outputBuf[i * 2];
-                p.m_end = outputBuf[i * 2 + 1];
-                piece[i] = p;
-            }
-
-            if (!lastParenInvalid && subPatternNum) {
-                globalRegExpStatus.lastParen = StringView(str, piece[maxMatchedIndex].m_start, piece[maxMatchedIndex].m_end);
-            } else {
-                globalRegExpStatus.lastParen = StringView();
-            }
 
-            globalRegExpStatus.leftContext = StringView(str, 0, piece[0].m_start);
-            globalRegExpStatus.rightContext = StringView(str, piece[maxMatchedIndex].m_end, length);
-            globalRegExpStatus.lastMatch = StringView(str, piece[0].m_start, piece[0].m_end);
-            matchResult.m_matchResults.push_back(std::vector<RegexMatchResult::RegexMatchResultPiece>(std::move(piece)));
+            RegexMatchResult::RegexMatchResultPiece* pieces = matchResult.m_matchResults.append(subPatternNum + 1);
+            memcpy(pieces, outputBuf, sizeof(unsigned) * 2 * (subPatternNum + 1));
             if (!isGlobal)
                 break;
             if (start == outputBuf[1]) {
@@ -421,20 +432,22 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
         }
     } while (result != JSC::Yarr::offsetNoMatch);
 
-    if (!gotResult && ((option() & (RegExpObject::Option::Global | RegExpObject::Option::Sticky)))) {
+    if (gotResult) {
+        // only the last match is visible through the legacy RegExp properties
+        RegexMatchResult::MatchResults::Match lastMatch = matchResult.m_matchResults.back();
+        globalRegExpStatus.update(str, &lastMatch[0].m_start, subPatternNum);
+    } else if (option() & (RegExpObject::Option::Global | RegExpObject::Option::Sticky)) {
         setLastIndex(state, Value(0));
     }
 
-    return matchResult.m_matchResults.size();
+    return gotResult;
 }
 
 void RegExpObject::createRegexMatchResult(ExecutionState& state, String* str, RegexMatchResult& result)
 {
     size_t len = 0, previousLastIndex = 0;
     bool testResult;
-    RegexMatchResult temp;
-    temp.m_matchResults.push_back(result.m_matchResults[0]);
-    result.m_matchResults.clear();
+    ASSERT(result.m_matchResults.size() == 1);
     do {
         const size_t maximumReasonableMatchSize = 1000000000;
         if (len > maximumReasonableMatchSize) {
@@ -447,17 +460,14 @@ void RegExpObject::createRegexMatchResult(ExecutionState& state, String* str, Re
             previousLastIndex = lastIndex().toIndex(state);
         }
 
-        size_t end = temp.m_matchResults[0][0].m_end;
-        size_t length = end - temp.m_matchResults[0][0].m_start;
+        size_t end = result.m_matchResults.back()[0].m_end;
+        size_t length = end - result.m_matchResults.back()[0].m_start;
         if (!length) {
             ++end;
         }
-        for (size_t i = 0; i < temp.m_matchResults.size(); i++) {
-            result.m_matchResults.push_back(temp.m_matchResults[i]);
-        }
         len++;
-        temp.m_matchResults.clear();
-        testResult = matchNonGlobally(state, str, temp, false, end);
+        // appends the next match to result
+        testResult = matchNonGlobally(state, str, result, false, end);
     } while (testResult);
 }
 
@@ -533,6 +543,57 @@ void RegExpObject::pushBackToRegExpMatchedArray(ExecutionState& state, ArrayObje
     }
 }
 
+RegExpCache::Entry* RegExpCache::find(const Key& key)
+{
+    auto it = m_map.find(key);
+    if (it == m_map.end()) {
+        m_missCount++;
+        return nullptr;
+    }
+    m_hitCount++;
+    m_items.splice(m_items.begin(), m_items, it->second);
+    return &it->second->second;
+}
+
+RegExpCache::Entry& RegExpCache::insert(const Key& key, const Entry& entry, size_t byteSize)
+{
+    ASSERT(m_map.find(key) == m_map.end());
+    m_items.push_front(std::make_pair(key, entry));
+    m_map.insert(std::make_pair(key, m_items.begin()));
+
+    Entry& inserted = m_items.front().second;
+    inserted.m_byteSize = byteSize;
+    m_byteSize += byteSize;
+    evictIfNeeded();
+    return inserted;
+}
+
+void RegExpCache::updateByteSize(Entry& entry, size_t byteSize)
+{
+    m_byteSize = m_byteSize - entry.m_byteSize + byteSize;
+    entry.m_byteSize = byteSize;
+    evictIfNeeded();
+}
+
+void RegExpCache::evictIfNeeded()
+{
+    // the most recently used entry is always kept, since the caller is still using it
+    while (m_byteSize > REGEXP_CACHE_BYTE_SIZE_MAX && m_items.size() > 1) {
+        Item& victim = m_items.back();
+        m_byteSize -= victim.second.m_byteSize;
+        m_map.erase(victim.first);
+        m_items.pop_back();
+        m_evictionCount++;
+    }
+}
+
+void RegExpCache::clear()
+{
+    m_map.clear();
+    m_items.clear();
+    m_byteSize = 0;
+}
+
 RegExpStringIteratorObject::RegExpStringIteratorObject(ExecutionState& state, bool global, bool unicode, RegExpObject* regexp, String* string)
     : IteratorObject(state, state.context()->globalObject()->regexpStringIteratorPrototype())
     , m_isGlobal(global)
@@ -34,13 +34,99 @@ struct BytecodePattern;
 
 namespace Escargot {
 
+class RegExpPrefilter;
+class RegExpJITCode;
+
 struct RegexMatchResult {
     struct RegexMatchResultPiece {
         unsigned m_start, m_end;
     };
     COMPILE_ASSERT((sizeof(RegexMatchResultPiece)) == (sizeof(unsigned) * 2), sizeof_RegexMatchResultPiece_wrong);
+
+    // pieces of every match are kept back to back in one buffer: the whole match followed by each subpattern.
+    // a global scan only grows this buffer instead of allocating a vector per match
+    class MatchResults {
+    public:
+        class Match {
+        public:
+            Match(const RegexMatchResultPiece* pieces, size_t size)
+                : m_pieces(pieces)
+                , m_size(size)
+            {
+            }
+
+            size_t size() const
+            {
+                return m_size;
+            }
+
+            const RegexMatchResultPiece& operator[](size_t idx) const
+            {
+                ASSERT(idx < m_size);
+                return m_pieces[idx];
+            }
+
+        private:
+            const RegexMatchResultPiece* m_pieces;
+            size_t m_size;
+        };
+
+        MatchResults()
+            : m_piecesPerMatch(0)
+        {
+        }
+
+        size_t size() const
+        {
+            return m_piecesPerMatch ? m_pieces.size() / m_piecesPerMatch : 0;
+        }
+
+        Match operator[](size_t idx) const
+        {
+            ASSERT(idx < size());
+            return Match(m_pieces.data() + idx * m_piecesPerMatch, m_piecesPerMatch);
+        }
+
+        Match back() const
+        {
+            return operator[](size() - 1);
+        }
+
+        // returns storage for the pieceCount pieces of a new match. every match has the same number of pieces
+        RegexMatchResultPiece* append(size_t pieceCount)
+        {
+            ASSERT(!m_piecesPerMatch || m_piecesPerMatch == pieceCount);
+            m_piecesPerMatch = pieceCount;
+            size_t oldSize = m_pieces.size();
+            m_pieces.resize(oldSize + pieceCount);
+            return m_pieces.data() + oldSize;
+        }
+
+        void append(unsigned start, unsigned end)
+        {
+            RegexMatchResultPiece* piece = append(1);
+            piece->m_start = start;
+            piece->m_end = end;
+        }
+
+        void clear()
+        {
+            m_pieces.clear();
+            m_piecesPerMatch = 0;
+        }
+
+    private:
+        size_t m_piecesPerMatch;
+        std::vector<RegexMatchResultPiece> m_pieces;
+    };
+
+    RegexMatchResult()
+        : m_subPatternNum(0)
+    {
+    }
+
     int m_subPatternNum;
-    std::vector<std::vector<RegexMatchResultPiece>> m_matchResults;
+    MatchResults m_matchResults;
 };
 
 class RegExpObject : public Object {
@@ -60,18 +146,20 @@ public:
     struct RegExpCacheKey {
         RegExpCacheKey(const String* body, Option option)
             : m_body(body)
-            , m_multiline(option & RegExpObject::Option::MultiLine)
-            , m_ignoreCase(option & RegExpObject::Option::IgnoreCase)
+            , m_flags(option & CompileFlagsMask)
         {
         }
 
         bool operator==(const RegExpCacheKey& otherKey) const
         {
-            return (m_body == otherKey.m_body) && (m_multiline == otherKey.m_multiline) && (m_ignoreCase == otherKey.m_ignoreCase);
+            return (m_flags == otherKey.m_flags) && m_body->equals(otherKey.m_body);
         }
+
+        // every flag except global changes the compiled pattern
+        static const int CompileFlagsMask = IgnoreCase | MultiLine | Sticky | Unicode | DotAll;
+
         const String* m_body;
-        const bool m_multiline : 1;
-        const bool m_ignoreCase : 1;
+        int m_flags;
     };
 
     struct RegExpCacheEntry {
@@ -79,12 +167,26 @@ public:
             : m_yarrError(yarrError)
             , m_yarrPattern(yarrPattern)
             , m_bytecodePattern(bytecodePattern)
+            , m_prefilter(nullptr)
+#if defined(ENABLE_REGEXP_JIT)
+            , m_jitCode(nullptr)
+#endif
+            , m_byteSize(0)
         {
         }
 
         const char* m_yarrError;
         JSC::Yarr::YarrPattern* m_yarrPattern;
         JSC::Yarr::BytecodePattern* m_bytecodePattern;
+        // computed together with m_bytecodePattern. nullptr when the pattern has no usable first-character set
+        RegExpPrefilter* m_prefilter;
+#if defined(ENABLE_REGEXP_JIT)
+        // native code for the pattern. nullptr when the pattern is not supported by RegExpJITCode
+        // the executable memory is released with the RegExpJITCode object once no entry or RegExpObject refers to it
+        RegExpJITCode* m_jitCode;
+#endif
+        // estimated memory of the entry. maintained by RegExpCache
+        size_t m_byteSize;
     };
 
     RegExpObject(ExecutionState& state, String* source, String* option);
@@ -172,6 +274,10 @@ private:
     Option m_option;
     JSC::Yarr::YarrPattern* m_yarrPattern;
     JSC::Yarr::BytecodePattern* m_bytecodePattern;
+    RegExpPrefilter* m_prefilter;
+#if defined(ENABLE_REGEXP_JIT)
+    RegExpJITCode* m_jitCode;
+#endif
     EncodedValue m_lastIndex;
     const String* m_lastExecutedString;
 };
@@ -202,10 +308,6 @@ private:
     String* m_string;
 };
 
-typedef std::unordered_map<RegExpObject::RegExpCacheKey, RegExpObject::RegExpCacheEntry,
-                           std::hash<RegExpObject::RegExpCacheKey>, std::equal_to<RegExpObject::RegExpCacheKey>,
-                           GCUtil::gc_malloc_allocator<std::pair<const RegExpObject::RegExpCacheKey, RegExpObject::RegExpCacheEntry>>>
-    RegExpCacheMap;
 }
 
 namespace std {
@@ -214,7 +316,7 @@ template <>
 struct hash<Escargot::RegExpObject::RegExpCacheKey> {
     size_t operator()(Escargot::RegExpObject::RegExpCacheKey const& x) const
     {
-        return x.m_body->hashValue();
+        return x.m_body->hashValue() ^ (static_cast<size_t>(x.m_flags) << 24);
     }
 };
 
@@ -227,4 +329,73 @@ struct equal_to<Escargot::RegExpObject::RegExpCacheKey> {
 };
 }
 
+namespace Escargot {
+
+// Compiled patterns keyed on (source, flags), shared by every Context of a VMInstance.
+// Entries are accounted by their estimated memory, and the least recently used ones are
+// evicted one at a time once the total goes over REGEXP_CACHE_BYTE_SIZE_MAX.
+// RegExpObjects keep their own references, so eviction never invalidates a live RegExp.
+class RegExpCache : public gc {
+public:
+    typedef RegExpObject::RegExpCacheKey Key;
+    typedef RegExpObject::RegExpCacheEntry Entry;
+
+    RegExpCache()
+        : m_byteSize(0)
+        , m_hitCount(0)
+        , m_missCount(0)
+        , m_evictionCount(0)
+    {
+    }
+
+    // returns nullptr on a miss. a found entry becomes the most recently used one
+    Entry* find(const Key& key);
+    Entry& insert(const Key& key, const Entry& entry, size_t byteSize);
+    // called when more code is compiled into a cached entry
+    void updateByteSize(Entry& entry, size_t byteSize);
+    void clear();
+
+    size_t size() const
+    {
+        return m_map.size();
+    }
+
+    size_t byteSize() const
+    {
+        return m_byteSize;
+    }
+
+    size_t hitCount() const
+    {
+        return m_hitCount;
+    }
+
+    size_t missCount() const
+    {
+        return m_missCount;
+    }
+
+    size_t evictionCount() const
+    {
+        return m_evictionCount;
+    }
+
+private:
+    void evictIfNeeded();
+
+    typedef std::pair<Key, Entry> Item;
+    typedef std::list<Item, GCUtil::gc_malloc_allocator<Item>> ItemList;
+    typedef std::unordered_map<Key, ItemList::iterator, std::hash<Key>, std::equal_to<Key>,
+                               GCUtil::gc_malloc_allocator<std::pair<const Key, ItemList::iterator>>>
+        ItemMap;
+
+    ItemList m_items; // most recently used first
+    ItemMap m_map;
+    size_t m_byteSize;
+    size_t m_hitCount;
+    size_t m_missCount;
+    size_t m_evictionCount;
+};
+}
+
 #endif
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "RegExpPrefilter.h"
+
+#include "WTFBridge.h"
+#include "YarrPattern.h"
+
+namespace Escargot {
+
+using JSC::Yarr::YarrPattern;
+using JSC::Yarr::PatternDisjunction;
+using JSC::Yarr::PatternAlternative;
+using JSC::Yarr::PatternTerm;
+using JSC::Yarr::CharacterClass;
+using JSC::Yarr::CharacterRange;
+
+class RegExpPrefilterBuilder {
+public:
+    enum ScanResult {
+        // every path through the terms consumes a character which was added to the set
+        Consumes,
+        // there is a path which consumes nothing
+        MayBeEmpty,
+        // a match can begin with a character we cannot predict
+        Unknown,
+    };
+
+    RegExpPrefilterBuilder(YarrPattern& pattern, RegExpPrefilter* filter)
+        : m_pattern(pattern)
+        , m_filter(filter)
+    {
+    }
+
+    ScanResult scanDisjunction(PatternDisjunction* disjunction)
+    {
+        ScanResult result = Consumes;
+        for (size_t i = 0; i < disjunction->m_alternatives.size(); i++) {
+            ScanResult r = scanAlternative(disjunction->m_alternatives[i].get(), 0);
+            if (r == Unknown) {
+                return Unknown;
+            }
+            if (r == MayBeEmpty) {
+                result = MayBeEmpty;
+            }
+        }
+        return result;
+    }
+
+    ScanResult scanAlternative(PatternAlternative* alternative, size_t from)
+    {
+        for (size_t i = from; i < alternative->m_terms.size(); i++) {
+            PatternTerm& term = alternative->m_terms[i];
+            bool mayBeSkipped = !term.quantityMinCount.unsafeGet();
+
+            switch (term.type) {
+            case PatternTerm::TypeAssertionBOL:
+            case PatternTerm::TypeAssertionEOL:
+            case PatternTerm::TypeAssertionWordBoundary:
+            case PatternTerm::TypeParentheticalAssertion:
+            case PatternTerm::TypeForwardReference:
+                // zero-width terms. the first character comes from the following terms
+                continue;
+            case PatternTerm::TypePatternCharacter:
+                // ByteCompiler may fold non-ASCII characters with case mappings we don't track here
+                if (m_pattern.ignoreCase() && !isASCII(term.patternCharacter)) {
+                    return Unknown;
+                }
+                addCharacter(term.patternCharacter);
+                break;
+            case PatternTerm::TypeCharacterClass:
+                if (term.invert() || !addCharacterClass(term.characterClass)) {
+                    return Unknown;
+                }
+                break;
+            case PatternTerm::TypeParenthesesSubpattern: {
+                ScanResult r = scanDisjunction(term.parentheses.disjunction);
+                if (r == Unknown) {
+                    return Unknown;
+                }
+                if (r == MayBeEmpty) {
+                    mayBeSkipped = true;
+                }
+                break;
+            }
+            case PatternTerm::TypeBackReference:
+            case PatternTerm::TypeDotStarEnclosure:
+            default:
+                return Unknown;
+            }
+
+            if (!mayBeSkipped) {
+                return Consumes;
+            }
+        }
+        return MayBeEmpty;
+    }
+
+    void computePrefix(PatternAlternative* alternative)
+    {
+        unsigned length = 0;
+        for (size_t i = 0; i < alternative->m_terms.size(); i++) {
+            PatternTerm& term = alternative->m_terms[i];
+            if (term.type != PatternTerm::TypePatternCharacter || term.quantityType != JSC::Yarr::QuantifierFixedCount
+                || term.patternCharacter > 0xFFFF) {
+                break;
+            }
+            unsigned count = term.quantityMinCount.unsafeGet();
+            if (!count || count != term.quantityMaxCount.unsafeGet()) {
+                break;
+            }
+            for (unsigned j = 0; j < count && length < RegExpPrefilter::MaxPrefixLength; j++) {
+                m_filter->m_prefix[length++] = term.patternCharacter;
+            }
+            if (length == RegExpPrefilter::MaxPrefixLength) {
+                break;
+            }
+        }
+        m_filter->m_prefixLength = length;
+    }
+
+    void finalize()
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < 256 / 32; i++) {
+            count += __builtin_popcount(m_filter->m_firstCharacters[i]);
+        }
+        if (count == 0 && !m_filter->m_mayStartWithNonLatin1) {
+            m_filter->m_onlyAtStart = true;
+        } else if (count == 1 && !m_filter->m_mayStartWithNonLatin1) {
+            for (unsigned ch = 0; ch < 256; ch++) {
+                if (m_filter->isFirstCharacter(ch)) {
+                    m_filter->m_hasSingleCharacter = true;
+                    m_filter->m_singleCharacter = ch;
+                    break;
+                }
+            }
+        }
+    }
+
+    bool acceptsEverything()
+    {
+        if (!m_filter->m_mayStartWithNonLatin1) {
+            return false;
+        }
+        for (size_t i = 0; i < 256 / 32; i++) {
+            if (m_filter->m_firstCharacters[i] != 0xFFFFFFFF) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    void setBit(UChar32 ch)
+    {
+        ASSERT(ch <= 0xFF);
+        m_filter->m_firstCharacters[ch >> 5] |= 1u << (ch & 31);
+    }
+
+    void addCharacter(UChar32 ch)
+    {
+        if (ch > 0xFF) {
+            m_filter->m_mayStartWithNonLatin1 = true;
+            return;
+        }
+        setBit(ch);
+        if (m_pattern.ignoreCase() && isASCIIAlpha(ch)) {
+            setBit(toASCIILower(ch));
+            setBit(toASCIIUpper(ch));
+            if (m_pattern.unicode()) {
+                // simple case folding maps U+212A KELVIN SIGN to k and U+017F LATIN SMALL LETTER LONG S to s
+                m_filter->m_mayStartWithNonLatin1 = true;
+            }
+        }
+    }
+
+    void addRange(const CharacterRange& range)
+    {
+        for (UChar32 ch = range.begin; ch <= range.end && ch <= 0xFF; ch++) {
+            setBit(ch);
+        }
+        if (range.end > 0xFF) {
+            m_filter->m_mayStartWithNonLatin1 = true;
+        }
+    }
+
+    bool addCharacterClass(CharacterClass* characterClass)
+    {
+        if (characterClass->m_anyCharacter) {
+            return false;
+        }
+        // m_table is only a lookup accelerator. matches and ranges always hold the whole set
+        for (size_t i = 0; i < characterClass->m_matches.size(); i++) {
+            addCharacter(characterClass->m_matches[i]);
+        }
+        for (size_t i = 0; i < characterClass->m_ranges.size(); i++) {
+            addRange(characterClass->m_ranges[i]);
+        }
+        for (size_t i = 0; i < characterClass->m_matchesUnicode.size(); i++) {
+            addCharacter(characterClass->m_matchesUnicode[i]);
+        }
+        for (size_t i = 0; i < characterClass->m_rangesUnicode.size(); i++) {
+            addRange(characterClass->m_rangesUnicode[i]);
+        }
+        if (characterClass->m_hasNonBMPCharacters) {
+            m_filter->m_mayStartWithNonLatin1 = true;
+        }
+        return true;
+    }
+
+    YarrPattern& m_pattern;
+    RegExpPrefilter* m_filter;
+};
+
+RegExpPrefilter::RegExpPrefilter()
+    : m_startIsCandidate(false)
+    , m_mayStartWithNonLatin1(false)
+    , m_onlyAtStart(false)
+    , m_hasSingleCharacter(false)
+    , m_singleCharacter(0)
+    , m_prefixLength(0)
+{
+    memset(m_prefix, 0, sizeof(m_prefix));
+    memset(m_firstCharacters, 0, sizeof(m_firstCharacters));
+}
+
+RegExpPrefilter* RegExpPrefilter::create(JSC::Yarr::YarrPattern& pattern)
+{
+    PatternDisjunction* body = pattern.m_body;
+    if (!body || !body->m_alternatives.size()) {
+        return nullptr;
+    }
+
+    RegExpPrefilter* filter = new RegExpPrefilter();
+    RegExpPrefilterBuilder builder(pattern, filter);
+
+    for (size_t i = 0; i < body->m_alternatives.size(); i++) {
+        PatternAlternative* alternative = body->m_alternatives[i].get();
+        // without multiline, ^ only matches at 0 (optimizeBOL keeps the anchored alternatives in front)
+        if (alternative->m_startsWithBOL && !pattern.multiline()) {
+            filter->m_startIsCandidate = true;
+            continue;
+        }
+        if (builder.scanAlternative(alternative, 0) != RegExpPrefilterBuilder::Consumes) {
+            return nullptr;
+        }
+    }
+
+    if (builder.acceptsEverything()) {
+        return nullptr;
+    }
+
+    if (body->m_alternatives.size() == 1 && !filter->m_startIsCandidate && !pattern.ignoreCase()) {
+        builder.computePrefix(body->m_alternatives[0].get());
+    }
+    builder.finalize();
+
+    return filter;
+}
+
+static ALWAYS_INLINE unsigned findCharacter(const LChar* chars, unsigned length, unsigned start, char16_t ch)
+{
+    if (ch > 0xFF || start >= length) {
+        return RegExpPrefilter::NoCandidate;
+    }
+    const void* found = memchr(chars + start, ch, length - start);
+    return found ? static_cast<const LChar*>(found) - chars : RegExpPrefilter::NoCandidate;
+}
+
+static ALWAYS_INLINE unsigned findCharacter(const char16_t* chars, unsigned length, unsigned start, char16_t ch)
+{
+    for (unsigned i = start; i < length; i++) {
+        if (chars[i] == ch) {
+            return i;
+        }
+    }
+    return RegExpPrefilter::NoCandidate;
+}
+
+template <typename CharType>
+unsigned RegExpPrefilter::scan(const CharType* chars, unsigned length, unsigned start) const
+{
+    if (start == 0 && m_startIsCandidate) {
+        return 0;
+    }
+    if (m_onlyAtStart) {
+        return NoCandidate;
+    }
+
+    if (m_prefixLength) {
+        unsigned pos = start;
+        while (true) {
+            pos = findCharacter(chars, length, pos, m_prefix[0]);
+            if (pos == NoCandidate || length - pos < m_prefixLength) {
+                return NoCandidate;
+            }
+            unsigned i = 1;
+            while (i < m_prefixLength && chars[pos + i] == m_prefix[i]) {
+                i++;
+            }
+            if (i == m_prefixLength) {
+                return pos;
+            }
+            pos++;
+        }
+    }
+
+    if (m_hasSingleCharacter) {
+        return findCharacter(chars, length, start, m_singleCharacter);
+    }
+
+    for (unsigned pos = start; pos < length; pos++) {
+        if (isFirstCharacter(chars[pos])) {
+            return pos;
+        }
+    }
+    return NoCandidate;
+}
+
+unsigned RegExpPrefilter::nextCandidate(const LChar* chars, unsigned length, unsigned start) const
+{
+    return scan(chars, length, start);
+}
+
+unsigned RegExpPrefilter::nextCandidate(const char16_t* chars, unsigned length, unsigned start) const
+{
+    return scan(chars, length, start);
+}
+} // namespace Escargot
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotRegExpPrefilter__
+#define __EscargotRegExpPrefilter__
+
+namespace JSC {
+namespace Yarr {
+struct YarrPattern;
+}
+}
+
+namespace Escargot {
+
+/*
+ * Summary of the characters a match of a compiled pattern can begin with.
+ * The Yarr interpreter tries every start position one by one, so this is used to jump
+ * over positions which cannot start a match before running the bytecode.
+ * The candidate set is always a superset of real match positions; sticky patterns should not use it.
+ */
+class RegExpPrefilter : public gc {
+public:
+    static const unsigned NoCandidate = static_cast<unsigned>(-1);
+    static const unsigned MaxPrefixLength = 16;
+
+    // returns nullptr when a match can begin with any character (or with no character at all)
+    static RegExpPrefilter* create(JSC::Yarr::YarrPattern& pattern);
+
+    // returns the first position in [start, length) where a match can begin, or NoCandidate
+    unsigned nextCandidate(const LChar* chars, unsigned length, unsigned start) const;
+    unsigned nextCandidate(const char16_t* chars, unsigned length, unsigned start) const;
+
+    bool startIsCandidate() const
+    {
+        return m_startIsCandidate;
+    }
+
+    bool onlyAtStart() const
+    {
+        return m_onlyAtStart;
+    }
+
+    bool mayStartWithNonLatin1() const
+    {
+        return m_mayStartWithNonLatin1;
+    }
+
+    // 256-bit set of the Latin-1 characters a match can begin with
+    const uint32_t* firstCharacters() const
+    {
+        return m_firstCharacters;
+    }
+
+    void* operator new(size_t size)
+    {
+        return GC_MALLOC_ATOMIC(size);
+    }
+    void* operator new[](size_t size) = delete;
+
+private:
+    RegExpPrefilter();
+
+    bool isFirstCharacter(char16_t ch) const
+    {
+        if (ch > 0xFF) {
+            return m_mayStartWithNonLatin1;
+        }
+        return m_firstCharacters[ch >> 5] & (1u << (ch & 31));
+    }
+
+    template <typename CharType>
+    unsigned scan(const CharType* chars, unsigned length, unsigned start) const;
+
+    friend class RegExpPrefilterBuilder;
+
+    // some alternative starts with ^ (non-multiline), so position 0 is always a candidate
+    bool m_startIsCandidate : 1;
+    bool m_mayStartWithNonLatin1 : 1;
+    // every alternative is anchored to ^, so nothing but position 0 can match
+    bool m_onlyAtStart : 1;
+    // set when m_firstCharacters holds exactly one Latin-1 character (m_singleCharacter)
+    bool m_hasSingleCharacter : 1;
+    LChar m_singleCharacter;
+    // literal every match starts with. only available for single alternative, case-sensitive patterns
+    unsigned m_prefixLength;
+    char16_t m_prefix[MaxPrefixLength];
+    uint32_t m_firstCharacters[256 / 32];
+};
+} // namespace Escargot
+
+#endif
@@ -21,6 +21,7 @@
 #include "RopeString.h"
 #include "StringBuilder.h"
 #include "ErrorObject.h"
+#include "util/Transcoder.h"
 
 namespace Escargot {
 
@@ -82,67 +83,165 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
         ErrorObject::throwBuiltinError(*state, ErrorObject::RangeError, ErrorObject::Messages::String_InvalidStringLength);
     }
 
+    RopeString* rope = createNode(lstr, rstr);
+    if (UNLIKELY(rope->m_depth > ROPE_STRING_BALANCE_DEPTH)) {
+        return balance(rope);
+    }
+    return rope;
+}
+
+RopeString* RopeString::createNode(String* lstr, String* rstr)
+{
     RopeString* rope = new RopeString();
-    rope->m_bufferData.length = llen + rlen;
+    rope->m_bufferData.length = lstr->length() + rstr->length();
     rope->m_left = lstr;
     rope->m_bufferData.buffer = rstr;
+    rope->m_bufferData.has8BitContent = lstr->has8BitContent() & rstr->has8BitContent();
+    rope->m_depth = std::max(depthOf(lstr), depthOf(rstr)) + 1;
+    return rope;
+}
 
-    bool l8bit;
-    if (lstr->isRopeString()) {
-        l8bit = ((RopeString*)lstr)->m_bufferData.has8BitContent;
-    } else {
-        l8bit = lstr->has8BitContent();
+// balancing follows "Ropes: an Alternative to Strings" (Boehm, Atkinson and Plass).
+// a rope of depth n is balanced when its length is at least fibonacci(n + 2)
+static const size_t ropeStringFibonacciCount = 64;
+
+static uint64_t fibonacci(size_t n)
+{
+    struct FibonacciTable {
+        FibonacciTable()
+        {
+            m_numbers[0] = 0;
+            m_numbers[1] = 1;
+            for (size_t i = 2; i < ropeStringFibonacciCount; i++) {
+                m_numbers[i] = m_numbers[i - 1] + m_numbers[i - 2];
+            }
+        }
+        uint64_t m_numbers[ropeStringFibonacciCount];
+    };
+    static const FibonacciTable table;
+    ASSERT(n < ropeStringFibonacciCount);
+    return table.m_numbers[n];
+}
+
+bool RopeString::isBalanced(String* str)
+{
+    size_t depth = depthOf(str);
+    return depth + 2 < ropeStringFibonacciCount && str->length() >= fibonacci(depth + 2);
+}
+
+String* RopeString::concatForBalance(String* lstr, String* rstr)
+{
+    if (!lstr) {
+        return rstr;
+    }
+    if (!rstr) {
+        return lstr;
     }
+    return createNode(lstr, rstr);
+}
 
-    bool r8bit;
-    if (rstr->isRopeString()) {
-        r8bit = ((RopeString*)rstr)->m_bufferData.has8BitContent;
-    } else {
-        r8bit = rstr->has8BitContent();
+// forest[i] is empty or holds a balanced rope whose length is in [fibonacci(i + 2), fibonacci(i + 3))
+// ropes are inserted from left to right, so a lower slot always holds a part which comes later
+void RopeString::insertToBalanceForest(String** forest, String* str)
+{
+    String* prefix = nullptr;
+    size_t i = 0;
+    for (; str->length() >= fibonacci(i + 3); i++) {
+        if (forest[i]) {
+            prefix = concatForBalance(forest[i], prefix);
+            forest[i] = nullptr;
+        }
     }
 
-    rope->m_bufferData.has8BitContent = l8bit & r8bit;
-    return rope;
+    str = concatForBalance(prefix, str);
+    while (true) {
+        if (forest[i]) {
+            str = concatForBalance(forest[i], str);
+            forest[i] = nullptr;
+        }
+        if (str->length() < fibonacci(i + 3)) {
+            break;
+        }
+        i++;
+    }
+    forest[i] = str;
 }
 
-template <typename ResultType>
-void RopeString::flattenRopeStringWorker()
+void RopeString::addToBalanceForest(String** forest, String* str)
 {
-    ResultType* result = (ResultType*)GC_MALLOC_ATOMIC(sizeof(ResultType) * m_bufferData.length);
-    std::vector<String*> queue;
-    queue.push_back(m_left);
-    queue.push_back((String*)m_bufferData.buffer);
-    size_t pos = m_bufferData.length;
-    size_t k = 0;
-    while (!queue.empty()) {
-        String* cur = queue.back();
-        queue.pop_back();
-        if (cur->isRopeString()) {
-            RopeString* cur2 = (RopeString*)cur;
-            if (cur2->m_bufferData.hasSpecialImpl) {
-                queue.push_back(cur2->m_left);
-                queue.push_back((String*)cur2->m_bufferData.buffer);
-                continue;
-            }
+    // a balanced subtree is reused as it is, so rebalancing a rope grown by appending
+    // only visits the nodes added since the last rebalancing
+    if (!isUnflattenedRopeString(str) || isBalanced(str)) {
+        insertToBalanceForest(forest, str);
+        return;
+    }
+
+    RopeString* rope = (RopeString*)str;
+    addToBalanceForest(forest, rope->m_left);
+    addToBalanceForest(forest, rope->right());
+}
+
+String* RopeString::balance(RopeString* rope)
+{
+    if (isBalanced(rope)) {
+        return rope;
+    }
+
+    String* forest[ropeStringFibonacciCount - 3] = {};
+    addToBalanceForest(forest, rope);
+
+    String* result = nullptr;
+    for (size_t i = 0; i < ropeStringFibonacciCount - 3; i++) {
+        if (forest[i]) {
+            result = concatForBalance(forest[i], result);
         }
-        String* sub = cur;
-        const auto& data = sub->bufferAccessData();
+    }
+    ASSERT(result->length() == rope->length());
+    return result;
+}
 
-        pos -= data.length;
-        size_t subLength = data.length;
+char16_t RopeString::charAt(const size_t idx) const
+{
+    if (!m_bufferData.hasSpecialImpl || ++m_charAccessCount > ROPE_STRING_CHAR_ACCESS_MAX) {
+        return bufferAccessData().charAt(idx);
+    }
 
-        if (data.has8BitContent) {
-            auto ptr = (const LChar*)data.buffer;
-            for (size_t i = 0; i < subLength; i++) {
-                result[i + pos] = ptr[i];
-            }
+    const RopeString* rope = this;
+    size_t position = idx;
+    while (true) {
+        String* child;
+        size_t leftLength = rope->m_left->length();
+        if (position < leftLength) {
+            child = rope->m_left;
         } else {
-            auto ptr = (const char16_t*)data.buffer;
-            for (size_t i = 0; i < subLength; i++) {
-                result[i + pos] = ptr[i];
-            }
+            position -= leftLength;
+            child = rope->right();
+        }
+
+        if (!isUnflattenedRopeString(child)) {
+            return child->charAt(position);
         }
+        rope = (RopeString*)child;
     }
+}
+
+template <typename ResultType>
+void RopeString::flattenRopeStringWorker()
+{
+    ResultType* result = (ResultType*)GC_MALLOC_ATOMIC(sizeof(ResultType) * m_bufferData.length);
+    ResultType* dst = result;
+    forEachLeaf(this, 0, m_bufferData.length, [&dst](const StringBufferAccessData& data, size_t from, size_t to) -> bool {
+        size_t subLength = to - from;
+        if (data.has8BitContent == (sizeof(ResultType) == 1)) {
+            memcpy(dst, (const ResultType*)data.buffer + from, sizeof(ResultType) * subLength);
+        } else {
+            ASSERT(data.has8BitContent);
+            Transcoder::widenLatin1ToUTF16((const LChar*)data.buffer + from, subLength, (char16_t*)dst);
+        }
+        dst += subLength;
+        return true;
+    });
+    ASSERT(dst == result + m_bufferData.length);
 
     m_bufferData.hasSpecialImpl = false;
     m_bufferData.buffer = result;
@@ -160,28 +259,140 @@ void RopeString::flattenRopeString()
     }
 }
 
+// writes UTF-8 of the leaves of a rope one by one. a surrogate pair can be split between two leaves,
+// so a lead surrogate at the end of a leaf is held back until the next leaf is seen
+class RopeStringUTF8Encoder {
+public:
+    // dst can be nullptr to compute the length only
+    RopeStringUTF8Encoder(char* dst, bool replaceInvalidUtf8)
+        : m_dst(dst)
+        , m_length(0)
+        , m_pendingLead(0)
+        , m_replaceInvalidUtf8(replaceInvalidUtf8)
+    {
+    }
+
+    bool append(const StringBufferAccessData& data, size_t from, size_t to)
+    {
+        if (data.has8BitContent) {
+            flushPendingLead();
+            const LChar* src = (const LChar*)data.buffer + from;
+            if (m_dst) {
+                m_length += Transcoder::encodeLatin1ToUTF8(src, to - from, m_dst + m_length);
+            } else {
+                m_length += Transcoder::utf8LengthOfLatin1(src, to - from);
+            }
+            return true;
+        }
+
+        const char16_t* src = data.bufferAs16Bit + from;
+        size_t len = to - from;
+        if (m_pendingLead) {
+            if (U16_IS_TRAIL(src[0])) {
+                char16_t pair[2] = { m_pendingLead, src[0] };
+                m_pendingLead = 0;
+                appendUTF16(pair, 2);
+                src++;
+                len--;
+            } else {
+                flushPendingLead();
+            }
+        }
+
+        if (len && U16_IS_LEAD(src[len - 1])) {
+            appendUTF16(src, len - 1);
+            m_pendingLead = src[len - 1];
+        } else {
+            appendUTF16(src, len);
+        }
+        return true;
+    }
+
+    size_t finish()
+    {
+        flushPendingLead();
+        return m_length;
+    }
+
+private:
+    void appendUTF16(const char16_t* src, size_t len)
+    {
+        if (m_dst) {
+            m_length += Transcoder::encodeUTF16ToUTF8(src, len, m_dst + m_length, m_replaceInvalidUtf8);
+        } else {
+            m_length += Transcoder::utf8LengthOfUTF16(src, len);
+        }
+    }
+
+    void flushPendingLead()
+    {
+        if (m_pendingLead) {
+            char16_t lead = m_pendingLead;
+            m_pendingLead = 0;
+            appendUTF16(&lead, 1);
+        }
+    }
+
+    char* m_dst;
+    size_t m_length;
+    char16_t m_pendingLead;
+    bool m_replaceInvalidUtf8;
+};
+
+template <typename OutputType>
+static OutputType ropeStringToUTF8(String* rope, bool replaceInvalidUtf8)
+{
+    auto encode = [](String* rope, char* dst, bool replaceInvalidUtf8) -> size_t {
+        RopeStringUTF8Encoder encoder(dst, replaceInvalidUtf8);
+        RopeString::forEachLeaf(rope, 0, rope->length(), [&encoder](const StringBufferAccessData& data, size_t from, size_t to) -> bool {
+            return encoder.append(data, from, to);
+        });
+        return encoder.finish();
+    };
+
+    size_t len = encode(rope, nullptr, replaceInvalidUtf8);
+    char inlineBuffer[128];
+    std::unique_ptr<char[]> heapBuffer;
+    char* buffer = inlineBuffer;
+    if (len > sizeof(inlineBuffer)) {
+        heapBuffer.reset(new char[len]);
+        buffer = heapBuffer.get();
+    }
+    size_t written = encode(rope, buffer, replaceInvalidUtf8);
+    ASSERT(written == len);
+    return OutputType(buffer, written);
+}
+
 UTF8StringDataNonGCStd RopeString::toNonGCUTF8StringData(int options) const
 {
-    return bufferAccessData().toUTF8String<UTF8StringDataNonGCStd>();
+    if (!m_bufferData.hasSpecialImpl) {
+        return bufferAccessData().toUTF8String<UTF8StringDataNonGCStd>(options);
+    }
+    return ropeStringToUTF8<UTF8StringDataNonGCStd>(const_cast<RopeString*>(this), options == StringWriteOption::ReplaceInvalidUtf8);
 }
 
 UTF8StringData RopeString::toUTF8StringData() const
 {
-    return bufferAccessData().toUTF8String<UTF8StringData>();
+    if (!m_bufferData.hasSpecialImpl) {
+        return bufferAccessData().toUTF8String<UTF8StringData>();
+    }
+    return ropeStringToUTF8<UTF8StringData>(const_cast<RopeString*>(this), false);
 }
 
 UTF16StringData RopeString::toUTF16StringData() const
 {
-    auto data = bufferAccessData();
-    if (data.has8BitContent) {
-        UTF16StringData ret;
-        ret.resizeWithUninitializedValues(data.length);
-        for (size_t i = 0; i < data.length; i++) {
-            ret[i] = data.uncheckedCharAtFor8Bit(i);
+    UTF16StringData ret;
+    ret.resizeWithUninitializedValues(length());
+    char16_t* dst = ret.data();
+    forEachLeaf(const_cast<RopeString*>(this), 0, length(), [&dst](const StringBufferAccessData& data, size_t from, size_t to) -> bool {
+        if (data.has8BitContent) {
+            Transcoder::widenLatin1ToUTF16((const LChar*)data.buffer + from, to - from, dst);
+        } else {
+            memcpy(dst, data.bufferAs16Bit + from, (to - from) * sizeof(char16_t));
         }
-        return ret;
-    } else {
-        return UTF16StringData(data.bufferAs16Bit, data.length);
-    }
+        dst += to - from;
+        return true;
+    });
+    return ret;
 }
 }
@@ -21,12 +21,15 @@
 #define __EscargotRopeString__
 
 #include "runtime/String.h"
+#include "util/Vector.h"
 
 namespace Escargot {
 
 class ExecutionState;
 
 class RopeString : public String {
+    friend class HeapSnapshot;
+
 public:
     RopeString()
         : String()
@@ -36,6 +39,8 @@ public:
         m_bufferData.hasSpecialImpl = true;
         m_bufferData.length = 0;
         m_bufferData.buffer = nullptr;
+        m_depth = 0;
+        m_charAccessCount = 0;
     }
 
     // this function not always create RopeString.
@@ -44,6 +49,7 @@ public:
     // provide ExecutionState if you need limit of string length(exception can be thrown only in ExecutionState area)
     static String* createRopeString(String* lstr, String* rstr, ExecutionState* state = nullptr);
 
+    virtual char16_t charAt(const size_t idx) const override;
     virtual UTF16StringData toUTF16StringData() const override;
     virtual UTF8StringData toUTF8StringData() const override;
     virtual UTF8StringDataNonGCStd toNonGCUTF8StringData(int options = StringWriteOption::NoOptions) const override;
@@ -63,6 +69,18 @@ public:
         return (const char16_t*)bufferAccessData().buffer;
     }
 
+    // a rope keeps its children until its characters are needed in one buffer
+    static bool isUnflattenedRopeString(String* str)
+    {
+        return str->isRopeString() && ((RopeString*)str)->m_bufferData.hasSpecialImpl;
+    }
+
+    // calls fn(data, from, to) for every leaf of str which overlaps [start, end), from left to right.
+    // from and to are the overlapping range in data. no rope is flattened on the way
+    // stops and returns false as soon as fn returns false
+    template <typename Fn>
+    static bool forEachLeaf(String* str, size_t start, size_t end, const Fn& fn);
+
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
@@ -81,9 +99,64 @@ protected:
     void flattenRopeString();
 
 private:
+    static RopeString* createNode(String* lstr, String* rstr);
+    static String* balance(RopeString* rope);
+    static bool isBalanced(String* str);
+    static String* concatForBalance(String* lstr, String* rstr);
+    static void insertToBalanceForest(String** forest, String* str);
+    static void addToBalanceForest(String** forest, String* str);
+    static size_t depthOf(String* str)
+    {
+        return isUnflattenedRopeString(str) ? ((RopeString*)str)->m_depth : 0;
+    }
+
+    String* right() const
+    {
+        ASSERT(m_bufferData.hasSpecialImpl);
+        return m_bufferData.bufferAsString;
+    }
+
     String* m_left;
     // String* m_right; // Right String is stored in m_bufferAccessData.buffer if string is not flattened
+    // height of the tree of an unflattened rope. createRopeString keeps it below ROPE_STRING_BALANCE_DEPTH
+    // unless the rope is already balanced. a child flattened later is not reflected
+    uint32_t m_depth;
+    // charAt walks the tree a few times before it flattens the rope
+    mutable uint32_t m_charAccessCount;
 };
+
+template <typename Fn>
+bool RopeString::forEachLeaf(String* str, size_t start, size_t end, const Fn& fn)
+{
+    struct Entry {
+        String* m_string;
+        size_t m_offset;
+    };
+    VectorWithInlineStorage<ROPE_STRING_BALANCE_DEPTH + 2, Entry, GCUtil::gc_malloc_allocator<Entry>> stack;
+    stack.push_back(Entry({ str, 0 }));
+    while (stack.size()) {
+        Entry e = stack.back();
+        stack.pop_back();
+        size_t length = e.m_string->length();
+        if (e.m_offset >= end || e.m_offset + length <= start) {
+            continue;
+        }
+
+        if (isUnflattenedRopeString(e.m_string)) {
+            RopeString* rope = (RopeString*)e.m_string;
+            stack.push_back(Entry({ rope->right(), e.m_offset + rope->m_left->length() }));
+            stack.push_back(Entry({ rope->m_left, e.m_offset }));
+            continue;
+        }
+
+        size_t from = start > e.m_offset ? start - e.m_offset : 0;
+        size_t to = std::min(end - e.m_offset, length);
+        if (!fn(e.m_string->bufferAccessData(), from, to)) {
+            return false;
+        }
+    }
+    return true;
+}
 }
 
 #endif
@@ -32,6 +32,7 @@ namespace Escargot {
 
 SandBox::SandBox(Context* s)
     : m_context(s)
+    , m_hasPendingException(false)
 {
     m_oldSandBox = m_context->vmInstance()->m_currentSandBox;
     m_context->vmInstance()->m_currentSandBox = this;
@@ -67,31 +68,25 @@ void SandBox::processCatch(const Value& error, SandBoxResult& result)
 #endif /* ESCARGOT_DEBUGGER */
 
     for (size_t i = 0; i < m_stackTraceData.size(); i++) {
-        if ((size_t)m_stackTraceData[i].second.loc.index == SIZE_MAX && (size_t)m_stackTraceData[i].second.loc.actualCodeBlock != SIZE_MAX) {
+        StackTraceData traceData = m_stackTraceData[i].toStackTraceData();
+        if ((size_t)traceData.loc.index == SIZE_MAX && (size_t)traceData.loc.actualCodeBlock != SIZE_MAX) {
             // this means loc not computed yet.
-            ExtendedNodeLOC loc = m_stackTraceData[i].second.loc.actualCodeBlock->computeNodeLOCFromByteCode(m_context,
-                                                                                                             m_stackTraceData[i].second.loc.byteCodePosition, m_stackTraceData[i].second.loc.actualCodeBlock->m_codeBlock);
-            StackTraceData traceData;
+            ByteCodeBlock* byteCodeBlock = traceData.loc.actualCodeBlock;
+            ExtendedNodeLOC loc = byteCodeBlock->computeNodeLOCFromByteCode(m_context, traceData.loc.byteCodePosition, byteCodeBlock->m_codeBlock);
             traceData.loc = loc;
-            InterpretedCodeBlock* cb = m_stackTraceData[i].second.loc.actualCodeBlock->m_codeBlock;
-            traceData.src = cb->script()->src();
-            traceData.sourceCode = cb->script()->sourceCode();
-            traceData.functionName = m_stackTraceData[i].second.functionName;
-            traceData.isFunction = m_stackTraceData[i].second.isFunction;
-            traceData.isConstructor = m_stackTraceData[i].second.isConstructor;
-            traceData.isAssociatedWithJavaScriptCode = m_stackTraceData[i].second.isAssociatedWithJavaScriptCode;
-            traceData.isEval = m_stackTraceData[i].second.isEval;
+            traceData.sourceCode = byteCodeBlock->m_codeBlock->script()->sourceCode();
 
             result.stackTraceData.pushBack(traceData);
 
 #ifdef ESCARGOT_DEBUGGER
             if (i < 8 && debugger && debugger->enabled()) {
                 debugger->sendBacktraceInfo(Debugger::ESCARGOT_MESSAGE_EXCEPTION_BACKTRACE,
-                                            m_stackTraceData[i].second.loc.actualCodeBlock, (uint32_t)loc.line, (uint32_t)loc.column, m_stackTraceData[i].second.executionStateDepth);
+                                            byteCodeBlock, (uint32_t)loc.line, (uint32_t)loc.column, traceData.executionStateDepth);
             }
 #endif /* ESCARGOT_DEBUGGER */
         } else {
-            result.stackTraceData.pushBack(m_stackTraceData[i].second);
+            traceData.src = traceData.resolvedSrc();
+            result.stackTraceData.pushBack(traceData);
         }
     }
 }
@@ -120,13 +115,67 @@ SandBox::SandBoxResult SandBox::run(const std::function<Value()>& scriptRunner)
     return result;
 }
 
+String* SandBox::StackTraceData::resolvedSrc() const
+{
+    return src ? src : nativeFunctionSrc(functionName);
+}
+
+String* SandBox::StackTraceData::nativeFunctionSrc(String* functionName)
+{
+    StringBuilder builder;
+    builder.appendString("function ");
+    builder.appendString(functionName);
+    builder.appendString("() { ");
+    builder.appendString("[native function]");
+    builder.appendString(" } ");
+    return builder.finalize();
+}
+
+String* SandBox::StackTraceFrame::src() const
+{
+    if (codeBlock->isInterpretedCodeBlock() && codeBlock->asInterpretedCodeBlock()->script()) {
+        return codeBlock->asInterpretedCodeBlock()->script()->src();
+    }
+    ASSERT(kind == FunctionCode);
+    return nullptr;
+}
+
+SandBox::StackTraceData SandBox::StackTraceFrame::toStackTraceData() const
+{
+    StackTraceData data;
+    if (byteCodeBlock) {
+        data.loc.byteCodePosition = byteCodePosition;
+        data.loc.actualCodeBlock = byteCodeBlock;
+    }
+    data.src = src();
+#ifdef ESCARGOT_DEBUGGER
+    data.executionStateDepth = executionStateDepth;
+#endif /* ESCARGOT_DEBUGGER */
+    if (kind == FunctionCode) {
+        data.functionName = codeBlock->functionName().string();
+        data.isFunction = true;
+        data.isAssociatedWithJavaScriptCode = codeBlock->isInterpretedCodeBlock();
+        data.isConstructor = isConstructor;
+    } else {
+        if (kind == GlobalCode) {
+            data.sourceCode = codeBlock->asInterpretedCodeBlock()->script()->sourceCode();
+        }
+        data.isEval = true;
+        data.isAssociatedWithJavaScriptCode = true;
+    }
+    return data;
+}
+
 void SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, ExecutionState& state)
 {
     ExecutionState* pstate = &state;
+    const size_t maxDepth = state.context()->vmInstance()->maxStackTraceDepth();
+    // frames of a previously caught exception. if the first new frame is among them, so are its callers
+    const size_t recordedFrameCount = stackTraceData.size();
 #ifdef ESCARGOT_DEBUGGER
     uint32_t executionStateDepthIndex = 0;
 #endif /* ESCARGOT_DEBUGGER */
-    while (pstate) {
+    while (pstate && stackTraceData.size() < maxDepth) {
         FunctionObject* callee = pstate->resolveCallee();
         ExecutionState* es = pstate;
 
@@ -148,17 +197,24 @@ void SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, Executi
             break;
         }
 
-        bool alreadyExists = false;
-
-        for (size_t i = 0; i < stackTraceData.size(); i++) {
-            if (stackTraceData[i].first == es || stackTraceData[i].first->lexicalEnvironment() == es->lexicalEnvironment()) {
-                alreadyExists = true;
-                break;
+        // block, with and try states of a function are walked one by one before the state of the function,
+        // so a frame can only be the same as the last recorded one
+        bool alreadyExists = stackTraceData.size() && stackTraceData.back().lexicalEnvironment == es->lexicalEnvironment();
+        if (!alreadyExists && stackTraceData.size() == recordedFrameCount) {
+            for (size_t i = 0; i < recordedFrameCount; i++) {
+                if (stackTraceData[i].lexicalEnvironment == es->lexicalEnvironment()) {
+                    return;
+                }
             }
         }
 
         if (!alreadyExists) {
-            if (!callee && es && es->lexicalEnvironment()) {
+            StackTraceFrame frame;
+            frame.lexicalEnvironment = es->lexicalEnvironment();
+#ifdef ESCARGOT_DEBUGGER
+            frame.executionStateDepth = executionStateDepthIndex;
+#endif /* ESCARGOT_DEBUGGER */
+            if (!callee && es->lexicalEnvironment()) {
                 // can be null on module outer env
                 InterpretedCodeBlock* cb;
                 if (es->lexicalEnvironment()->record()->isGlobalEnvironmentRecord()) {
@@ -168,80 +224,32 @@ void SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, Executi
                     cb = es->lexicalEnvironment()->outerEnvironment()->record()->asGlobalEnvironmentRecord()->globalCodeBlock();
                 }
                 if (cb) {
-                    ByteCodeBlock* b = cb->byteCodeBlock();
-                    ExtendedNodeLOC loc(SIZE_MAX, SIZE_MAX, SIZE_MAX);
+                    frame.kind = StackTraceFrame::GlobalCode;
+                    frame.codeBlock = cb;
                     ASSERT(!pstate->m_isNativeFunctionObjectExecutionContext);
                     if (pstate->m_programCounter != nullptr) {
-                        loc.byteCodePosition = *pstate->m_programCounter - (size_t)b->m_code.data();
-                        loc.actualCodeBlock = b;
+                        frame.byteCodeBlock = cb->byteCodeBlock();
+                        frame.byteCodePosition = *pstate->m_programCounter - (size_t)frame.byteCodeBlock->m_code.data();
                     }
-                    SandBox::StackTraceData data;
-                    data.loc = loc;
-                    data.src = cb->script()->src();
-                    data.sourceCode = cb->script()->sourceCode();
-                    data.isEval = true;
-                    data.isFunction = false;
-                    data.isAssociatedWithJavaScriptCode = true;
-                    data.isConstructor = false;
-#ifdef ESCARGOT_DEBUGGER
-                    data.executionStateDepth = executionStateDepthIndex;
-#endif /* ESCARGOT_DEBUGGER */
-
-                    stackTraceData.pushBack(std::make_pair(es, data));
+                    stackTraceData.pushBack(frame);
                 }
             } else if (pstate->codeBlock() && pstate->codeBlock()->isInterpretedCodeBlock() && pstate->codeBlock()->asInterpretedCodeBlock()->isEvalCodeInFunction()) {
-                CodeBlock* cb = pstate->codeBlock();
-                ExtendedNodeLOC loc(SIZE_MAX, SIZE_MAX, SIZE_MAX);
-                SandBox::StackTraceData data;
-                data.loc = loc;
-                data.src = cb->asInterpretedCodeBlock()->script()->src();
-                data.sourceCode = String::emptyString;
-                data.isEval = true;
-                data.isFunction = false;
-                data.isAssociatedWithJavaScriptCode = true;
-                data.isConstructor = false;
-#ifdef ESCARGOT_DEBUGGER
-                data.executionStateDepth = executionStateDepthIndex;
-#endif /* ESCARGOT_DEBUGGER */
-
-                stackTraceData.pushBack(std::make_pair(es, data));
+                frame.kind = StackTraceFrame::EvalCodeInFunction;
+                frame.codeBlock = pstate->codeBlock();
+                stackTraceData.pushBack(frame);
             } else if (callee) {
                 CodeBlock* cb = callee->codeBlock();
-                ExtendedNodeLOC loc(SIZE_MAX, SIZE_MAX, SIZE_MAX);
+                frame.kind = StackTraceFrame::FunctionCode;
+                frame.codeBlock = cb;
+                frame.isConstructor = callee->isConstructor();
                 if (cb->isInterpretedCodeBlock()) {
-                    ByteCodeBlock* b = cb->asInterpretedCodeBlock()->byteCodeBlock();
                     ASSERT(!pstate->m_isNativeFunctionObjectExecutionContext);
                     if (pstate->m_programCounter != nullptr) {
-                        loc.byteCodePosition = *pstate->m_programCounter - (size_t)b->m_code.data();
-                        loc.actualCodeBlock = b;
+                        frame.byteCodeBlock = cb->asInterpretedCodeBlock()->byteCodeBlock();
+                        frame.byteCodePosition = *pstate->m_programCounter - (size_t)frame.byteCodeBlock->m_code.data();
                     }
                 }
-                SandBox::StackTraceData data;
-                data.loc = loc;
-                if (cb->isInterpretedCodeBlock() && cb->asInterpretedCodeBlock()->script()) {
-                    data.src = cb->asInterpretedCodeBlock()->script()->src();
-#ifdef ESCARGOT_DEBUGGER
-                    data.executionStateDepth = executionStateDepthIndex;
-#endif /* ESCARGOT_DEBUGGER */
-                } else {
-                    StringBuilder builder;
-                    builder.appendString("function ");
-                    builder.appendString(cb->functionName().string());
-                    builder.appendString("() { ");
-                    builder.appendString("[native function]");
-                    builder.appendString(" } ");
-                    data.src = builder.finalize();
-#ifdef ESCARGOT_DEBUGGER
-                    data.executionStateDepth = executionStateDepthIndex;
-#endif /* ESCARGOT_DEBUGGER */
-                }
-                data.functionName = cb->functionName().string();
-                data.isEval = false;
-                data.isFunction = true;
-                data.isAssociatedWithJavaScriptCode = cb->isInterpretedCodeBlock();
-                data.isConstructor = callee->isConstructor();
-                data.sourceCode = String::emptyString;
-                stackTraceData.pushBack(std::make_pair(es, data));
+                stackTraceData.pushBack(frame);
             }
         }
 
@@ -254,7 +262,7 @@ void SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, Executi
 
 void SandBox::throwException(ExecutionState& state, Value exception)
 {
-    m_stackTraceData.clear();
+    m_stackTraceData.clearWithoutDeallocation();
     createStackTraceData(m_stackTraceData, state);
 
     // We MUST save thrown exception Value.
@@ -263,6 +271,16 @@ void SandBox::throwException(ExecutionState& state, Value exception)
     throw exception;
 }
 
+void SandBox::setPendingException(ExecutionState& state, const Value& exception)
+{
+    ASSERT(!m_hasPendingException);
+    m_stackTraceData.clearWithoutDeallocation();
+    createStackTraceData(m_stackTraceData, state);
+
+    m_exception = exception;
+    m_hasPendingException = true;
+}
+
 void SandBox::rethrowPreviouslyCaughtException(ExecutionState& state, Value exception, const StackTraceDataVector& stackTraceData)
 {
     m_stackTraceData = stackTraceData;
@@ -275,23 +293,6 @@ void SandBox::rethrowPreviouslyCaughtException(ExecutionState& state, Value exce
     throw exception;
 }
 
-static Value builtinErrorObjectStackInfo(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
-{
-    if (!(LIKELY(thisValue.isPointerValue() && thisValue.asPointerValue()->isErrorObject()))) {
-        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "get Error.prototype.stack called on incompatible receiver");
-    }
-
-    ErrorObject* obj = thisValue.asObject()->asErrorObject();
-    if (obj->stackTraceData() == nullptr) {
-        return String::emptyString;
-    }
-
-    auto stackTraceData = obj->stackTraceData();
-    StringBuilder builder;
-    stackTraceData->buildStackTrace(state.context(), builder);
-    return builder.finalize();
-}
-
 ErrorObject::StackTraceData* ErrorObject::StackTraceData::create(SandBox* sandBox)
 {
     ErrorObject::StackTraceData* data = new ErrorObject::StackTraceData();
@@ -300,12 +301,17 @@ ErrorObject::StackTraceData* ErrorObject::StackTraceData::create(SandBox* sandBo
     data->exception = sandBox->m_exception;
 
     for (size_t i = 0; i < sandBox->m_stackTraceData.size(); i++) {
-        if ((size_t)sandBox->m_stackTraceData[i].second.loc.index == SIZE_MAX && (size_t)sandBox->m_stackTraceData[i].second.loc.actualCodeBlock != SIZE_MAX) {
-            data->gcValues[i].byteCodeBlock = sandBox->m_stackTraceData[i].second.loc.actualCodeBlock;
-            data->nonGCValues[i].byteCodePosition = sandBox->m_stackTraceData[i].second.loc.byteCodePosition;
-        } else {
-            data->gcValues[i].infoString = sandBox->m_stackTraceData[i].second.src;
+        const SandBox::StackTraceFrame& frame = sandBox->m_stackTraceData[i];
+        String* src;
+        if (frame.byteCodeBlock) {
+            data->gcValues[i].byteCodeBlock = frame.byteCodeBlock;
+            data->nonGCValues[i].byteCodePosition = frame.byteCodePosition;
+        } else if ((src = frame.src())) {
+            data->gcValues[i].infoString = src;
             data->nonGCValues[i].byteCodePosition = SIZE_MAX;
+        } else {
+            data->gcValues[i].infoString = frame.codeBlock->functionName().string();
+            data->nonGCValues[i].byteCodePosition = NativeFunctionFrame;
         }
     }
 
@@ -335,6 +341,8 @@ void ErrorObject::StackTraceData::buildStackTrace(Context* context, StringBuilde
         builder.appendString("at ");
         if (nonGCValues[i].byteCodePosition == SIZE_MAX) {
             builder.appendString(gcValues[i].infoString);
+        } else if (nonGCValues[i].byteCodePosition == NativeFunctionFrame) {
+            builder.appendString(SandBox::StackTraceData::nativeFunctionSrc(gcValues[i].infoString));
         } else {
             ExtendedNodeLOC loc = gcValues[i].byteCodeBlock->computeNodeLOCFromByteCode(context,
                                                                                         nonGCValues[i].byteCodePosition, gcValues[i].byteCodeBlock->m_codeBlock);
@@ -407,10 +415,7 @@ void SandBox::fillStackDataIntoErrorObject(const Value& e)
         obj->setStackTraceData(data);
 
         ExecutionState state(m_context);
-        JSGetterSetter gs(
-            new NativeFunctionObject(state, NativeFunctionInfo(m_context->staticStrings().stack, builtinErrorObjectStackInfo, 0, NativeFunctionInfo::Strict)),
-            Value(Value::EmptyValue));
-        ObjectPropertyDescriptor desc(gs, ObjectPropertyDescriptor::ConfigurablePresent);
+        ObjectPropertyDescriptor desc(*m_context->globalObject()->errorStackGetterSetterData(), ObjectPropertyDescriptor::ConfigurablePresent);
         obj->defineOwnProperty(state, ObjectPropertyName(m_context->staticStrings().stack), desc);
     }
 }
@@ -33,8 +33,9 @@ public:
     explicit SandBox(Context* s);
     ~SandBox();
 
+    // locations and native function descriptions are computed only when the trace is read
     struct StackTraceData : public gc {
-        String* src;
+        String* src; // nullptr for native functions. see resolvedSrc()
         String* sourceCode;
         ExtendedNodeLOC loc;
         String* functionName;
@@ -56,9 +57,49 @@ public:
             , isEval(false)
         {
         }
+
+        String* resolvedSrc() const;
+        static String* nativeFunctionSrc(String* functionName);
     };
 
-    typedef Vector<std::pair<ExecutionState*, StackTraceData>, GCUtil::gc_malloc_allocator<std::pair<ExecutionState*, StackTraceData>>> StackTraceDataVector;
+    // a frame recorded when an exception is thrown. it holds only the (code block, program counter) of the frame,
+    // and StackTraceData is made from it when the trace is read
+    struct StackTraceFrame {
+        enum Kind : uint8_t {
+            GlobalCode,
+            EvalCodeInFunction,
+            FunctionCode,
+        };
+
+        LexicalEnvironment* lexicalEnvironment; // environment of the function level ExecutionState. identifies the frame
+        CodeBlock* codeBlock;
+        ByteCodeBlock* byteCodeBlock; // nullptr if the frame has no program counter
+        size_t byteCodePosition;
+#ifdef ESCARGOT_DEBUGGER
+        uint32_t executionStateDepth;
+#endif /* ESCARGOT_DEBUGGER */
+        Kind kind;
+        bool isConstructor;
+
+        StackTraceFrame()
+            : lexicalEnvironment(nullptr)
+            , codeBlock(nullptr)
+            , byteCodeBlock(nullptr)
+            , byteCodePosition(SIZE_MAX)
+#ifdef ESCARGOT_DEBUGGER
+            , executionStateDepth(0)
+#endif /* ESCARGOT_DEBUGGER */
+            , kind(GlobalCode)
+            , isConstructor(false)
+        {
+        }
+
+        String* src() const; // nullptr for native functions
+        // location is left as (byteCodePosition, actualCodeBlock) for frames with a program counter
+        StackTraceData toStackTraceData() const;
+    };
+
+    typedef Vector<StackTraceFrame, GCUtil::gc_malloc_allocator<StackTraceFrame>> StackTraceDataVector;
 
     struct SandBoxResult {
         Value result;
@@ -73,10 +114,36 @@ public:
 
     SandBoxResult run(const std::function<Value()>& scriptRunner); // for capsule script executing with try-catch
     SandBoxResult run(Value (*runner)(ExecutionState&, void*), void* data);
+    // records at most VMInstance::maxStackTraceDepth() frames.
+    // frames already in stackTraceData, like the ones of a previously caught exception, are not recorded again
     static void createStackTraceData(StackTraceDataVector& stackTraceData, ExecutionState& state);
     void throwException(ExecutionState& state, Value exception);
     void rethrowPreviouslyCaughtException(ExecutionState& state, Value exception, const StackTraceDataVector& stackTraceData);
 
+    // records exception like throwException does, but the caller unwinds by returning from interpret().
+    // only used for a throw whose handler is reached through interpret() frames and call opcodes, never through a native frame
+    void setPendingException(ExecutionState& state, const Value& exception);
+
+    // makes an exception caught from a native callee the pending exception. its stack trace is kept
+    void passCaughtExceptionAsPending(const Value& exception)
+    {
+        ASSERT(!m_hasPendingException);
+        m_exception = exception;
+        m_hasPendingException = true;
+    }
+
+    bool hasPendingException() const
+    {
+        return m_hasPendingException;
+    }
+
+    Value takePendingException()
+    {
+        ASSERT(m_hasPendingException);
+        m_hasPendingException = false;
+        return m_exception;
+    }
+
     StackTraceDataVector& stackTraceData()
     {
         return m_stackTraceData;
@@ -94,7 +161,8 @@ protected:
 private:
     Context* m_context;
     SandBox* m_oldSandBox;
-    StackTraceDataVector m_stackTraceData;
+    bool m_hasPendingException;
+    StackTraceDataVector m_stackTraceData; // refilled on every throw without reallocating. unused slots are cleared
     Value m_exception; // To avoid accidential GC of exception value
 };
 }
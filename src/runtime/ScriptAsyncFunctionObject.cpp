@@ -137,6 +137,17 @@ static Value awaitRejectedFunction(ExecutionState& state, Value thisValue, size_
     return Value();
 }
 
+ExecutionPauser* ScriptAsyncFunctionObject::awaitHandlerExecutionPauser(Object* handler)
+{
+    if (handler->isNativeFunctionObject()) {
+        NativeFunctionPointer fn = handler->asNativeFunctionObject()->nativeCodeBlock()->nativeFunctionData()->m_fn;
+        if (fn == awaitFulfilledFunction || fn == awaitRejectedFunction) {
+            return ((ScriptAsyncFunctionHelperFunctionObject*)handler)->m_executionPauser;
+        }
+    }
+    return nullptr;
+}
+
 // http://www.ecma-international.org/ecma-262/10.0/#await
 PromiseObject* ScriptAsyncFunctionObject::awaitOperationBeforePause(ExecutionState& state, ExecutionPauser* executionPauser, const Value& awaitValue, Object* source)
 {
@@ -60,6 +60,8 @@ public:
 
     // http://www.ecma-international.org/ecma-262/10.0/#await
     static PromiseObject* awaitOperationBeforePause(ExecutionState& state, ExecutionPauser* pauser, const Value& awaitValue, Object* source);
+    // returns the suspended execution an await handler resumes, or nullptr if handler is not an await handler
+    static ExecutionPauser* awaitHandlerExecutionPauser(Object* handler);
 
 private:
     EncodedValue m_thisValue;
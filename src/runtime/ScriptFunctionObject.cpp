@@ -19,6 +19,7 @@
 
 #include "Escargot.h"
 #include "ScriptFunctionObject.h"
+#include "runtime/ScriptArrowFunctionObject.h"
 #include "runtime/ArrayObject.h"
 #include "runtime/GeneratorObject.h"
 #include "runtime/Context.h"
@@ -137,6 +138,91 @@ Object* ScriptFunctionObject::construct(ExecutionState& state, const size_t argc
     return FunctionObjectProcessCallGenerator::processCall<ScriptFunctionObject, true, true, false, ScriptFunctionObjectObjectThisValueBinderWithConstruct, ScriptFunctionObjectNewTargetBinderWithConstruct, ScriptFunctionObjectReturnValueBinderWithConstruct>(state, this, Value(thisArgument), argc, argv, newTarget).asObject();
 }
 
+void PreparedFunctionCall::prepare(ExecutionState& state)
+{
+    ASSERT(!m_isPrepared);
+    m_isPrepared = true;
+
+    if (!m_callee.isPointerValue() || !m_callee.asPointerValue()->isScriptFunctionObject()) {
+        return;
+    }
+
+    PointerValue* p = m_callee.asPointerValue();
+    // generators, async functions and class constructors have their own [[Call]]
+    if (p->isScriptGeneratorFunctionObject() || p->isScriptAsyncFunctionObject() || p->isScriptAsyncGeneratorFunctionObject() || p->isScriptClassConstructorFunctionObject()) {
+        return;
+    }
+
+    ScriptFunctionObject* function = p->asScriptFunctionObject();
+    InterpretedCodeBlock* codeBlock = function->interpretedCodeBlock();
+    if (!codeBlock->canAllocateEnvironmentOnStack() || codeBlock->isGenerator() || codeBlock->isAsync()) {
+        return;
+    }
+
+    ByteCodeBlock* blk = FunctionObjectProcessCallGenerator::ensureByteCodeBlock(state, function);
+    size_t registerSize = blk->m_requiredRegisterFileSizeInValueSize;
+    size_t stackStorageSize = codeBlock->totalStackAllocatedVariableSize();
+    size_t literalStorageSize = blk->m_numeralLiteralData.size();
+    Value* literalStorageSrc = blk->m_numeralLiteralData.data();
+
+    m_registerFile = CustomAllocator<Value>().allocate(registerSize + stackStorageSize + literalStorageSize);
+    Value* literalStorage = m_registerFile + registerSize + stackStorageSize;
+    for (size_t i = 0; i < literalStorageSize; i++) {
+        literalStorage[i] = literalStorageSrc[i];
+    }
+
+    m_function = function;
+    m_byteCodeBlock = blk;
+    m_isArrowFunction = p->isScriptArrowFunctionObject();
+}
+
+PreparedFunctionCall::~PreparedFunctionCall()
+{
+    if (m_registerFile) {
+        CustomAllocator<Value>().deallocate(m_registerFile);
+    }
+}
+
+class PreparedArrowFunctionThisValueBinder {
+public:
+    Value operator()(ExecutionState& callerState, ExecutionState& calleeState, ScriptFunctionObject* self, const Value& thisArgument, bool isStrict)
+    {
+        return self->asScriptArrowFunctionObject()->thisValue();
+    }
+};
+
+NEVER_INLINE Value PreparedFunctionCall::callSlowCase(ExecutionState& state, const Value& thisValue, const size_t argc, NULLABLE Value* argv)
+{
+    if (!m_isPrepared) {
+        prepare(state);
+        if (m_registerFile) {
+            return callPrepared(state, thisValue, argc, argv);
+        }
+    }
+    return Object::call(state, m_callee, thisValue, argc, argv);
+}
+
+NEVER_INLINE Value PreparedFunctionCall::callPrepared(ExecutionState& state, const Value& thisValue, const size_t argc, NULLABLE Value* argv)
+{
+    struct RunningScope {
+        explicit RunningScope(bool& isRunning)
+            : m_isRunning(isRunning)
+        {
+            m_isRunning = true;
+        }
+        ~RunningScope()
+        {
+            m_isRunning = false;
+        }
+        bool& m_isRunning;
+    } runningScope(m_isRunning);
+
+    if (m_isArrowFunction) {
+        return FunctionObjectProcessCallGenerator::processPreparedCall<ScriptFunctionObject, PreparedArrowFunctionThisValueBinder>(state, m_function, m_byteCodeBlock, m_registerFile, thisValue, argc, argv);
+    }
+    return FunctionObjectProcessCallGenerator::processPreparedCall<ScriptFunctionObject, FunctionObjectThisValueBinder>(state, m_function, m_byteCodeBlock, m_registerFile, thisValue, argc, argv);
+}
+
 void ScriptFunctionObject::generateArgumentsObject(ExecutionState& state, size_t argc, Value* argv, FunctionEnvironmentRecord* environmentRecordWillArgumentsObjectBeLocatedIn, Value* stackStorage, bool isMapped)
 {
     if (environmentRecordWillArgumentsObjectBeLocatedIn->m_argumentsObject->isArgumentsObject()) {
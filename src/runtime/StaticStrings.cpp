@@ -157,22 +157,70 @@ FOR_EACH_LAZY_STATIC_STRING(DECLARE_LAZY_STATIC_STRING);
 FOR_EACH_LAZY_INTL_STATIC_STRING(DECLARE_LAZY_STATIC_STRING);
 #undef DECLARE_LAZY_STATIC_STRING
 
+COMPILE_ASSERT((NUMBER_TO_STRING_CACHE_SIZE & (NUMBER_TO_STRING_CACHE_SIZE - 1)) == 0, NUMBER_TO_STRING_CACHE_SIZE_should_be_power_of_2);
+COMPILE_ASSERT((ARRAY_INDEX_STRING_CACHE_SIZE & (ARRAY_INDEX_STRING_CACHE_SIZE - 1)) == 0, ARRAY_INDEX_STRING_CACHE_SIZE_should_be_power_of_2);
+
+static ALWAYS_INLINE size_t numberToStringCacheIndex(double d)
+{
+    // consecutive integers like the indexes of a loop take different entries
+    if (d >= 0 && d <= std::numeric_limits<uint32_t>::max() && d == (uint32_t)d) {
+        return (uint32_t)d & (NUMBER_TO_STRING_CACHE_SIZE - 1);
+    }
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(double));
+    bits ^= bits >> 32;
+    bits ^= bits >> 11;
+    return bits & (NUMBER_TO_STRING_CACHE_SIZE - 1);
+}
+
+static ALWAYS_INLINE size_t arrayIndexStringCacheIndex(::Escargot::String* string)
+{
+    size_t bits = (size_t)string;
+    return ((bits >> 4) ^ (bits >> 12)) & (ARRAY_INDEX_STRING_CACHE_SIZE - 1);
+}
+
 ::Escargot::String* StaticStrings::dtoa(double d) const
 {
-    size_t size = dtoaCache.size();
+    ASSERT(!std::isnan(d) && !std::isinf(d) && !(d == 0 && std::signbit(d)));
+    if (UNLIKELY(m_numberToStringCache == nullptr)) {
+        m_numberToStringCache = (NumberToStringCacheEntry*)GC_MALLOC(sizeof(NumberToStringCacheEntry) * NUMBER_TO_STRING_CACHE_SIZE);
+        m_arrayIndexStringCache = (ArrayIndexStringCacheEntry*)GC_MALLOC(sizeof(ArrayIndexStringCacheEntry) * ARRAY_INDEX_STRING_CACHE_SIZE);
+    }
 
-    for (size_t i = 0; i < size; ++i) {
-        if (dtoaCache[i].first == d) {
-            return dtoaCache[i].second;
-        }
+    NumberToStringCacheEntry& entry = m_numberToStringCache[numberToStringCacheIndex(d)];
+    if (entry.m_string && entry.m_number == d) {
+        return entry.m_string;
     }
 
     ::Escargot::String* s = String::fromDouble(d);
-    dtoaCache.insert(0, std::make_pair(d, s));
-    if (dtoaCache.size() > dtoaCacheSize) {
-        dtoaCache.erase(dtoaCache.size() - 1);
+    entry.m_number = d;
+    entry.m_string = s;
+
+    if (d >= 0 && d < Value::InvalidArrayIndexValue && d == (uint32_t)d) {
+        ArrayIndexStringCacheEntry& indexEntry = m_arrayIndexStringCache[arrayIndexStringCacheIndex(s)];
+        indexEntry.m_string = s;
+        indexEntry.m_index = (uint32_t)d;
     }
 
     return s;
 }
+
+uint32_t StaticStrings::tryToUseAsArrayIndex(::Escargot::String* string) const
+{
+    if (LIKELY(m_arrayIndexStringCache != nullptr)) {
+        ArrayIndexStringCacheEntry& entry = m_arrayIndexStringCache[arrayIndexStringCacheIndex(string)];
+        if (entry.m_string == string) {
+            return entry.m_index;
+        }
+    }
+
+    uint32_t index = string->tryToUseAsArrayIndex();
+    // only indexes are cached. other property names should not evict them
+    if (index != Value::InvalidArrayIndexValue && m_arrayIndexStringCache) {
+        ArrayIndexStringCacheEntry& entry = m_arrayIndexStringCache[arrayIndexStringCacheIndex(string)];
+        entry.m_string = string;
+        entry.m_index = index;
+    }
+    return index;
+}
 }
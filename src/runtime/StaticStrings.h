@@ -694,7 +694,8 @@ namespace Escargot {
 class StaticStrings {
 public:
     StaticStrings(AtomicStringMap* atomicStringMap)
-        : dtoaCacheSize(5)
+        : m_numberToStringCache(nullptr)
+        , m_arrayIndexStringCache(nullptr)
         , m_atomicStringMap(atomicStringMap)
     {
     }
@@ -806,10 +807,26 @@ public:
 
     void initStaticStrings();
 
-    const size_t dtoaCacheSize; // 5;
-    mutable Vector<std::pair<double, ::Escargot::String*>, GCUtil::gc_malloc_allocator<std::pair<double, ::Escargot::String*>>> dtoaCache;
-
+    // number to string conversion through a direct-mapped cache of NUMBER_TO_STRING_CACHE_SIZE entries.
+    // d should not be NaN, Infinity or -0
     ::Escargot::String* dtoa(double d) const;
+    // same as string->tryToUseAsArrayIndex(). strings made by dtoa for array indexes and parsed strings are
+    // kept in a direct-mapped cache of ARRAY_INDEX_STRING_CACHE_SIZE entries, so they are not parsed again
+    uint32_t tryToUseAsArrayIndex(::Escargot::String* string) const;
+
+    struct NumberToStringCacheEntry {
+        double m_number;
+        ::Escargot::String* m_string;
+    };
+
+    struct ArrayIndexStringCacheEntry {
+        ::Escargot::String* m_string;
+        uint32_t m_index;
+    };
+
+    // allocated on first use. these are marked through the GC descriptor of VMInstance
+    mutable NumberToStringCacheEntry* m_numberToStringCache;
+    mutable ArrayIndexStringCacheEntry* m_arrayIndexStringCache;
 
 protected:
     AtomicStringMap* m_atomicStringMap;
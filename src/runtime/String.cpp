@@ -47,6 +47,7 @@
 #include "String.h"
 #include "CompressibleString.h"
 #include "Value.h"
+#include "util/Transcoder.h"
 
 #include "fast-dtoa.h"
 #include "bignum-dtoa.h"
@@ -118,32 +119,17 @@ bool isAllSpecialCharacters(const std::string& s, bool (*fn)(char))
 
 bool isAllASCII(const char* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if ((buf[i] & 0x80) != 0) {
-            return false;
-        }
-    }
-    return true;
+    return Transcoder::isASCII(buf, len);
 }
 
 bool isAllASCII(const char16_t* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if (buf[i] >= 128) {
-            return false;
-        }
-    }
-    return true;
+    return Transcoder::isASCII(buf, len);
 }
 
 bool isAllLatin1(const char16_t* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if (buf[i] >= 256) {
-            return false;
-        }
-    }
-    return true;
+    return Transcoder::isLatin1(buf, len);
 }
 
 bool isIndexString(String* str)
@@ -225,48 +211,29 @@ char32_t readUTF8Sequence(const char*& sequence, bool& valid, int& charlen)
 
 UTF16StringDataNonGCStd utf8StringToUTF16StringNonGC(const char* buf, const size_t len)
 {
+    bool isLatin1;
     UTF16StringDataNonGCStd str;
-    const char* source = buf;
-    int charlen;
-    bool valid;
-    while (source < buf + len) {
-        char32_t ch = readUTF8Sequence(source, valid, charlen);
-        if (!valid) { // Invalid sequence
-            str += 0xFFFD;
-        } else if ((uint32_t)(ch) <= 0xffff) { // BMP
-            if (((ch)&0xfffff800) == 0xd800) { // SURROGATE
-                str += 0xFFFD;
-                source -= (charlen - 1);
-            } else {
-                str += ch; // normal case
-            }
-        } else if ((uint32_t)((ch)-0x10000) <= 0xfffff) { // SUPPLEMENTARY
-            str += (char16_t)(((ch) >> 10) + 0xd7c0); // LEAD
-            str += (char16_t)(((ch)&0x3ff) | 0xdc00); // TRAIL
-        } else {
-            str += 0xFFFD;
-            source -= (charlen - 1);
-        }
-    }
-
+    str.resize(Transcoder::utf16LengthOfUTF8(buf, len, isLatin1));
+    Transcoder::decodeUTF8(buf, len, &str[0]);
     return str;
 }
 
 UTF16StringData utf8StringToUTF16String(const char* buf, const size_t len)
 {
-    auto str = utf8StringToUTF16StringNonGC(buf, len);
-    return UTF16StringData(str.data(), str.length());
+    bool isLatin1;
+    UTF16StringData str;
+    str.resizeWithUninitializedValues(Transcoder::utf16LengthOfUTF8(buf, len, isLatin1));
+    Transcoder::decodeUTF8(buf, len, str.data());
+    return str;
 }
 
 ASCIIStringData utf16StringToASCIIString(const char16_t* buf, const size_t len)
 {
+    ASSERT(isAllASCII(buf, len));
     ASCIIStringData str;
     str.resizeWithUninitializedValues(len);
-    for (unsigned i = 0; i < len; i++) {
-        ASSERT(buf[i] < 128);
-        str[i] = buf[i];
-    }
-    return ASCIIStringData(std::move(str));
+    Transcoder::narrowUTF16ToLatin1(buf, len, (LChar*)str.data());
+    return str;
 }
 
 size_t utf32ToUtf8(char32_t uc, char* UTF8)
@@ -357,6 +324,22 @@ size_t utf32ToUtf16(char32_t i, char16_t* u)
     }
 }
 
+size_t StringBufferAccessData::utf8Length() const
+{
+    if (has8BitContent) {
+        return Transcoder::utf8LengthOfLatin1((const LChar*)buffer, length);
+    }
+    return Transcoder::utf8LengthOfUTF16(bufferAs16Bit, length);
+}
+
+size_t StringBufferAccessData::writeUTF8(char* dst, bool replaceInvalidUtf8) const
+{
+    if (has8BitContent) {
+        return Transcoder::encodeLatin1ToUTF8((const LChar*)buffer, length, dst);
+    }
+    return Transcoder::encodeUTF16ToUTF8(bufferAs16Bit, length, dst, replaceInvalidUtf8);
+}
+
 bool StringBufferAccessData::equals16Bit(const char16_t* c1, const char* c2, size_t len)
 {
     while (len > 0) {
@@ -374,9 +357,7 @@ UTF16StringData ASCIIString::toUTF16StringData() const
     UTF16StringData ret;
     size_t len = length();
     ret.resizeWithUninitializedValues(len);
-    for (size_t i = 0; i < len; i++) {
-        ret[i] = charAt(i);
-    }
+    Transcoder::widenLatin1ToUTF16(ASCIIString::characters8(), len, ret.data());
     return ret;
 }
 
@@ -395,43 +376,23 @@ UTF16StringData Latin1String::toUTF16StringData() const
     UTF16StringData ret;
     size_t len = length();
     ret.resizeWithUninitializedValues(len);
-    for (size_t i = 0; i < len; i++) {
-        ret[i] = charAt(i);
-    }
+    Transcoder::widenLatin1ToUTF16(Latin1String::characters8(), len, ret.data());
     return ret;
 }
 
 UTF8StringData Latin1String::toUTF8StringData() const
 {
     UTF8StringData ret;
-    size_t len = length();
-    for (size_t i = 0; i < len; i++) {
-        uint8_t ch = m_bufferData.uncheckedCharAtFor8Bit(i); /* assume that code points above 0xff are impossible since latin-1 is 8-bit */
-        if (ch < 0x80) {
-            ret.append((char*)&ch, 1);
-        } else {
-            char buf[8];
-            auto len = utf32ToUtf8(ch, buf);
-            ret.append(buf, len);
-        }
-    }
+    ret.resizeWithUninitializedValues(Transcoder::utf8LengthOfLatin1(Latin1String::characters8(), length()));
+    Transcoder::encodeLatin1ToUTF8(Latin1String::characters8(), length(), ret.data());
     return ret;
 }
 
 UTF8StringDataNonGCStd Latin1String::toNonGCUTF8StringData(int options) const
 {
     UTF8StringDataNonGCStd ret;
-    size_t len = length();
-    for (size_t i = 0; i < len; i++) {
-        uint8_t ch = m_bufferData.uncheckedCharAtFor8Bit(i); /* assume that code points above 0xff are impossible since latin-1 is 8-bit */
-        if (ch < 0x80) {
-            ret.append((char*)&ch, 1);
-        } else {
-            char buf[8];
-            auto len = utf32ToUtf8(ch, buf);
-            ret.append(buf, len);
-        }
-    }
+    ret.resize(Transcoder::utf8LengthOfLatin1(Latin1String::characters8(), length()));
+    Transcoder::encodeLatin1ToUTF8(Latin1String::characters8(), length(), &ret[0]);
     return ret;
 }
 
@@ -442,7 +403,7 @@ UTF16StringData UTF16String::toUTF16StringData() const
 
 UTF8StringData UTF16String::toUTF8StringData() const
 {
-    return bufferAccessData().toUTF8String<UTF8StringData, UTF8StringDataNonGCStd>();
+    return bufferAccessData().toUTF8String<UTF8StringData>();
 }
 
 UTF8StringDataNonGCStd UTF16String::toNonGCUTF8StringData(int options) const
@@ -626,14 +587,45 @@ String* String::fromDouble(double v)
     return new ASCIIString(std::move(s));
 }
 
+struct ExternalMemoryReleaseData {
+    const void* m_buffer;
+    size_t m_byteLength;
+    String::ExternalMemoryReleaseCallback m_callback;
+    void* m_callbackData;
+};
+
+void String::setExternalMemoryReleaseCallback(const void* buffer, size_t byteLength, ExternalMemoryReleaseCallback callback, void* callbackData)
+{
+    ASSERT(callback);
+    // the release data lives outside of GC heap, so the finalizer can read it after this string is gone
+    ExternalMemoryReleaseData* data = new ExternalMemoryReleaseData({ buffer, byteLength, callback, callbackData });
+    GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void* cd) {
+        ExternalMemoryReleaseData* data = (ExternalMemoryReleaseData*)cd;
+        data->m_callback(data->m_buffer, data->m_byteLength, data->m_callbackData);
+        delete data;
+    },
+                                   data, nullptr, nullptr);
+}
+
 String* String::fromUTF8(const char* src, size_t len)
 {
     if (isAllASCII(src, len)) {
         return new ASCIIString(src, len);
-    } else {
-        auto s = utf8StringToUTF16String(src, len);
-        return new UTF16String(std::move(s));
     }
+
+    bool isLatin1;
+    size_t decodedLength = Transcoder::utf16LengthOfUTF8(src, len, isLatin1);
+    if (isLatin1) {
+        Latin1StringData s;
+        s.resizeWithUninitializedValues(decodedLength);
+        Transcoder::decodeUTF8(src, len, s.data());
+        return new Latin1String(std::move(s));
+    }
+
+    UTF16StringData s;
+    s.resizeWithUninitializedValues(decodedLength);
+    Transcoder::decodeUTF8(src, len, s.data());
+    return new UTF16String(std::move(s));
 }
 
 #if defined(ENABLE_COMPRESSIBLE_STRING)
@@ -673,6 +665,14 @@ bool String::equals(const String* src) const
         return false;
     }
 
+    if (UNLIKELY(m_bufferData.hasSpecialImpl || src->m_bufferData.hasSpecialImpl)) {
+        if (RopeString::isUnflattenedRopeString(const_cast<String*>(this))) {
+            return matchesAt(0, src);
+        } else if (RopeString::isUnflattenedRopeString(const_cast<String*>(src))) {
+            return src->matchesAt(0, this);
+        }
+    }
+
     const auto& myData = bufferAccessData();
     const auto& srcData = src->bufferAccessData();
 
@@ -690,6 +690,58 @@ bool String::equals(const String* src) const
     }
 }
 
+static bool stringRangeEqual(const StringBufferAccessData& a, size_t aStart, const StringBufferAccessData& b, size_t bStart, size_t len)
+{
+    if (a.has8BitContent && b.has8BitContent) {
+        return memcmp((const LChar*)a.buffer + aStart, (const LChar*)b.buffer + bStart, len) == 0;
+    } else if (!a.has8BitContent && !b.has8BitContent) {
+        return memcmp(a.bufferAs16Bit + aStart, b.bufferAs16Bit + bStart, len * sizeof(char16_t)) == 0;
+    }
+
+    const char16_t* s16 = a.has8BitContent ? b.bufferAs16Bit + bStart : a.bufferAs16Bit + aStart;
+    const LChar* s8 = a.has8BitContent ? (const LChar*)a.buffer + aStart : (const LChar*)b.buffer + bStart;
+    for (size_t i = 0; i < len; i++) {
+        if (s16[i] != s8[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool String::matchesAt(size_t position, const String* str) const
+{
+    ASSERT(position + str->length() <= length());
+    const auto& strData = str->bufferAccessData();
+    String* self = const_cast<String*>(this);
+    if (!m_bufferData.hasSpecialImpl || !RopeString::isUnflattenedRopeString(self)) {
+        return stringRangeEqual(bufferAccessData(), position, strData, 0, strData.length);
+    }
+
+    size_t compared = 0;
+    return RopeString::forEachLeaf(self, position, position + strData.length, [&](const StringBufferAccessData& data, size_t from, size_t to) -> bool {
+        bool same = stringRangeEqual(data, from, strData, compared, to - from);
+        compared += to - from;
+        return same;
+    });
+}
+
+size_t String::hashValueSpecialImpl() const
+{
+    ASSERT(m_bufferData.hasSpecialImpl);
+    // hashing a rope for a lookup in an AtomicStringMap does not need a flat copy of it
+    String* self = const_cast<String*>(this);
+    size_t hash = stringHashSeed;
+    RopeString::forEachLeaf(self, 0, length(), [&hash](const StringBufferAccessData& data, size_t from, size_t to) -> bool {
+        if (data.has8BitContent) {
+            hash = stringHash((const LChar*)data.buffer + from, to - from, hash);
+        } else {
+            hash = stringHash(data.bufferAs16Bit + from, to - from, hash);
+        }
+        return true;
+    });
+    return hash;
+}
+
 uint64_t String::tryToUseAsArrayIndex() const
 {
     uint32_t number = 0;
@@ -844,8 +896,7 @@ size_t String::rfind(String* str, size_t pos)
 String* String::substring(size_t from, size_t to)
 {
     if (to - from > STRING_SUB_STRING_MIN_VIEW_LENGTH) {
-        StringView* str = new StringView(this, from, to);
-        return str;
+        return DetachableStringView::create(this, from, to);
     }
     StringBuilder builder;
     builder.appendSubString(this, from, to);
@@ -148,49 +148,26 @@ struct StringBufferAccessData {
     template <typename OutputType>
     OutputType toUTF8String(int options = StringWriteOption::NoOptions) const
     {
-        OutputType ret;
-        const bool replaceInvalidUtf8 = options == StringWriteOption::ReplaceInvalidUtf8;
-        const auto& accessData = *this;
-        for (size_t i = 0; i < accessData.length; i++) {
-            char32_t ch = (uint16_t)accessData.charAt(i);
-            if (ch < 0x80) {
-                ret.append((char*)&ch, 1);
-            } else {
-                char32_t finalCh;
-                if (U16_IS_LEAD(ch)) {
-                    if (i + 1 == accessData.length) {
-                        if (replaceInvalidUtf8) {
-                            finalCh = 0xFFFD;
-                        } else {
-                            finalCh = ch;
-                        }
-                    } else {
-                        char16_t c2 = accessData.charAt(i + 1);
-                        finalCh = ch;
-                        if (U16_IS_TRAIL(c2)) {
-                            finalCh = U16_GET_SUPPLEMENTARY(ch, c2);
-                            i++;
-                        } else if (replaceInvalidUtf8) {
-                            finalCh = 0xFFFD;
-                        }
-                    }
-                } else if (replaceInvalidUtf8 && U16_IS_TRAIL(ch)) {
-                    finalCh = 0xFFFD;
-                } else {
-                    finalCh = ch;
-                }
-
-                char buf[8];
-                auto len = utf32ToUtf8(finalCh, buf);
-                ret.append(buf, len);
-            }
+        const size_t len = utf8Length();
+        char inlineBuffer[128];
+        std::unique_ptr<char[]> heapBuffer;
+        char* buffer = inlineBuffer;
+        if (len > sizeof(inlineBuffer)) {
+            heapBuffer.reset(new char[len]);
+            buffer = heapBuffer.get();
         }
-        return ret;
+        writeUTF8(buffer, options == StringWriteOption::ReplaceInvalidUtf8);
+        return OutputType(buffer, len);
     }
+
+    // exact byte length of the UTF-8 form written by writeUTF8
+    size_t utf8Length() const;
+    size_t writeUTF8(char* dst, bool replaceInvalidUtf8) const;
 };
 
 class String : public PointerValue {
     friend class AtomicString;
+    friend class HeapSnapshot;
 
 protected:
     String()
@@ -249,6 +226,10 @@ public:
         FromExternalMemory
     };
 
+    typedef void (*ExternalMemoryReleaseCallback)(const void* buffer, size_t byteLength, void* callbackData);
+    // for strings on external memory. callback is called once, when this string is collected
+    void setExternalMemoryReleaseCallback(const void* buffer, size_t byteLength, ExternalMemoryReleaseCallback callback, void* callbackData);
+
     virtual bool isStringView()
     {
         return false;
@@ -305,6 +286,8 @@ public:
     }
 
     bool equals(const String* src) const;
+    // true when the characters of str appear in this string from position. a rope is not flattened for this
+    bool matchesAt(size_t position, const String* str) const;
 
     template <const size_t srcLen>
     bool equals(const char (&src)[srcLen]) const
@@ -384,10 +367,12 @@ public:
 
     String* substring(size_t from, size_t to);
 
+    static const size_t stringHashSeed = static_cast<size_t>(0xc70f6907UL);
+
+    // hash can be the result of a previous call to continue hashing where it stopped
     template <typename T>
-    static inline size_t stringHash(T* src, size_t length)
+    static inline size_t stringHash(T* src, size_t length, size_t hash = stringHashSeed)
     {
-        size_t hash = static_cast<size_t>(0xc70f6907UL);
         for (; length; --length)
             hash = (hash * 131) + *src++;
         return hash;
@@ -395,15 +380,13 @@ public:
 
     size_t hashValue() const
     {
-        const auto& data = bufferAccessData();
-        size_t len = data.length;
         size_t hash;
-        if (LIKELY(data.has8BitContent)) {
-            auto ptr = (const LChar*)data.buffer;
-            hash = stringHash(ptr, len);
+        if (UNLIKELY(m_bufferData.hasSpecialImpl)) {
+            hash = hashValueSpecialImpl();
+        } else if (LIKELY(m_bufferData.has8BitContent)) {
+            hash = stringHash((const LChar*)m_bufferData.buffer, m_bufferData.length);
         } else {
-            auto ptr = (const char16_t*)data.buffer;
-            hash = stringHash(ptr, len);
+            hash = stringHash((const char16_t*)m_bufferData.buffer, m_bufferData.length);
         }
 
         if (UNLIKELY((hash % sizeof(size_t)) == 0)) {
@@ -485,6 +468,7 @@ protected:
     }
 
     static int stringCompare(size_t l1, size_t l2, const String* c1, const String* c2);
+    size_t hashValueSpecialImpl() const;
 
     template <typename T>
     static ALWAYS_INLINE bool stringEqual(const T* s, const T* s1, const size_t len)
@@ -21,223 +21,259 @@
 #include "StringBuilder.h"
 #include "ExecutionState.h"
 #include "ErrorObject.h"
+#include "util/Transcoder.h"
 
 namespace Escargot {
 
+COMPILE_ASSERT(STRING_BUILDER_INLINE_STORAGE_MAX % sizeof(char16_t) == 0, string_builder_inline_storage_must_hold_char16_t);
+
 void StringBuilder::appendPiece(String* str, size_t s, size_t e)
 {
-    if (e - s > 0) {
-        StringBuilderPiece piece;
-        piece.m_string = str;
-        piece.m_start = s;
-        piece.m_end = e;
-
-        const auto& data = str->bufferAccessData();
-        if (!data.has8BitContent) {
-            bool has8 = true;
-            for (size_t i = s; i < e; i++) {
-                if (((char16_t*)data.buffer)[i] > 255) {
-                    has8 = false;
-                    break;
-                }
-            }
-
-            if (!has8) {
-                m_has8BitContent = false;
-                piece.m_type = StringBuilderPiece::Type::UTF16StringStringPiece;
-            } else {
-                piece.m_type = StringBuilderPiece::Type::UTF16StringStringButLatin1ContentPiece;
-            }
+    size_t len = e - s;
+    if (!len) {
+        return;
+    }
 
+    if (len < STRING_BUILDER_PIECE_LENGTH_MIN) {
+        if (UNLIKELY(RopeString::isUnflattenedRopeString(str))) {
+            // copy from the leaves of a rope so a short part of it does not flatten the whole rope
+            RopeString::forEachLeaf(str, s, e, [this](const StringBufferAccessData& data, size_t from, size_t to) -> bool {
+                appendBufferRange(data, from, to);
+                return true;
+            });
         } else {
-            piece.m_type = StringBuilderPiece::Type::Latin1StringPiece;
+            appendBufferRange(str->bufferAccessData(), s, e);
         }
+        return;
+    }
 
-        m_contentLength += e - s;
-        if (m_piecesInlineStorageUsage < STRING_BUILDER_INLINE_STORAGE_MAX) {
-            m_piecesInlineStorage[m_piecesInlineStorageUsage++] = piece;
-        } else
-            m_pieces.push_back(piece);
+    if (m_has8BitContent && !str->has8BitContent()) {
+        bool isLatin1 = RopeString::forEachLeaf(str, s, e, [](const StringBufferAccessData& data, size_t from, size_t to) -> bool {
+            return data.has8BitContent || Transcoder::isLatin1(data.bufferAs16Bit + from, to - from);
+        });
+        if (!isLatin1) {
+            convertTo16Bit();
+        }
     }
+
+    StringBuilderPiece piece;
+    piece.m_string = str;
+    piece.m_start = s;
+    piece.m_end = e;
+    piece.m_position = m_bufferLength;
+    m_pieces.push_back(piece);
+    m_contentLength += len;
 }
 
-void StringBuilder::appendPiece(const char* str)
+void StringBuilder::appendBufferRange(const StringBufferAccessData& data, size_t s, size_t e)
 {
-    StringBuilderPiece piece;
-    piece.m_start = 0;
-    piece.m_end = strlen(str);
-    piece.m_raw = str;
-    piece.m_type = StringBuilderPiece::Type::ConstChar;
-    if (piece.m_end) {
-        m_contentLength += piece.m_end;
-        if (m_piecesInlineStorageUsage < STRING_BUILDER_INLINE_STORAGE_MAX) {
-            m_piecesInlineStorage[m_piecesInlineStorageUsage++] = piece;
-        } else
-            m_pieces.push_back(piece);
+    if (data.has8BitContent) {
+        appendLatin1(((const LChar*)data.buffer) + s, e - s);
+    } else {
+        appendUTF16(((const char16_t*)data.buffer) + s, e - s);
     }
 }
 
-void StringBuilder::appendPiece(char16_t ch)
+void StringBuilder::appendLatin1(const LChar* src, size_t len)
 {
-    StringBuilderPiece piece;
-    piece.m_start = 0;
-    piece.m_end = 1;
-    piece.m_ch = ch;
-    piece.m_type = StringBuilderPiece::Type::Char;
+    ensureCapacity(len);
+    if (m_has8BitContent) {
+        memcpy(buffer8() + m_bufferLength, src, len);
+    } else {
+        char16_t* dst = buffer16() + m_bufferLength;
+        for (size_t i = 0; i < len; i++) {
+            dst[i] = src[i];
+        }
+    }
+    m_bufferLength += len;
+    m_contentLength += len;
+}
 
-    if (ch > 255) {
-        m_has8BitContent = false;
+void StringBuilder::appendUTF16(const char16_t* src, size_t len)
+{
+    if (m_has8BitContent) {
+        for (size_t i = 0; i < len; i++) {
+            if (src[i] > 255) {
+                convertTo16Bit();
+                break;
+            }
+        }
     }
 
-    m_contentLength += 1;
-    if (m_piecesInlineStorageUsage < STRING_BUILDER_INLINE_STORAGE_MAX) {
-        m_piecesInlineStorage[m_piecesInlineStorageUsage++] = piece;
-    } else
-        m_pieces.push_back(piece);
+    ensureCapacity(len);
+    if (m_has8BitContent) {
+        LChar* dst = buffer8() + m_bufferLength;
+        for (size_t i = 0; i < len; i++) {
+            dst[i] = (LChar)src[i];
+        }
+    } else {
+        memcpy(buffer16() + m_bufferLength, src, len * sizeof(char16_t));
+    }
+    m_bufferLength += len;
+    m_contentLength += len;
 }
 
-String* StringBuilder::finalize(ExecutionState* state)
+void StringBuilder::appendCharSlowCase(char16_t ch)
 {
-    if (!m_contentLength) {
-        clear();
-        return String::emptyString;
+    if (m_has8BitContent && ch > 255) {
+        convertTo16Bit();
     }
 
+    ensureCapacity(1);
+    if (m_has8BitContent) {
+        buffer8()[m_bufferLength++] = (LChar)ch;
+    } else {
+        buffer16()[m_bufferLength++] = ch;
+    }
+    m_contentLength++;
+}
 
-    if (state && UNLIKELY(m_contentLength > STRING_MAXIMUM_LENGTH)) {
-        ErrorObject::throwBuiltinError(*state, ErrorObject::RangeError, ErrorObject::Messages::String_InvalidStringLength);
+void StringBuilder::ensureCapacity(size_t extra)
+{
+    size_t required = m_bufferLength + extra;
+    if (LIKELY(required <= m_bufferCapacity)) {
+        return;
     }
 
-    if (m_has8BitContent) {
-        Latin1StringData ret;
-        ret.resizeWithUninitializedValues(m_contentLength);
-
-        size_t currentLength = 0;
-        for (size_t i = 0; i < m_piecesInlineStorageUsage; i++) {
-            const StringBuilderPiece& piece = m_piecesInlineStorage[i];
-            if (piece.m_type == StringBuilderPiece::Char) {
-                ret[currentLength++] = (LChar)piece.m_ch;
-            } else if (piece.m_type == StringBuilderPiece::ConstChar) {
-                const char* data = piece.m_raw;
-                size_t l = piece.m_end;
-                memcpy(&ret[currentLength], data, l);
-                currentLength += l;
-            } else {
-                String* data = piece.m_string;
-                size_t s = piece.m_start;
-                size_t e = piece.m_end;
-                size_t l = e - s;
-                const auto& accessData = data->bufferAccessData();
-                if (accessData.has8BitContent) {
-                    memcpy(&ret[currentLength], ((LChar*)accessData.buffer) + s, l);
-                    currentLength += l;
-                } else {
-                    char16_t* b = ((char16_t*)accessData.buffer);
-                    for (size_t k = s; k < e; k++) {
-                        ret[currentLength++] = b[k];
-                    }
-                }
-            }
+    size_t newCapacity = std::max(required, m_bufferCapacity * 2);
+    size_t unitSize = m_has8BitContent ? sizeof(LChar) : sizeof(char16_t);
+    if (isInlineBuffer()) {
+        void* newBuffer = GC_MALLOC_ATOMIC((newCapacity + 1) * unitSize);
+        memcpy(newBuffer, m_buffer, m_bufferLength * unitSize);
+        m_buffer = newBuffer;
+    } else {
+        m_buffer = GC_REALLOC(m_buffer, (newCapacity + 1) * unitSize);
+    }
+    m_bufferCapacity = newCapacity;
+}
+
+void StringBuilder::convertTo16Bit()
+{
+    ASSERT(m_has8BitContent);
+    const LChar* src = (const LChar*)m_buffer;
+    if (isInlineBuffer() && m_bufferLength <= STRING_BUILDER_INLINE_STORAGE_MAX / sizeof(char16_t)) {
+        // widen from the back so that no character is overwritten before it is read
+        for (size_t i = m_bufferLength; i > 0; i--) {
+            m_inlineBuffer[i - 1] = src[i - 1];
+        }
+        m_bufferCapacity = STRING_BUILDER_INLINE_STORAGE_MAX / sizeof(char16_t);
+    } else {
+        char16_t* newBuffer = (char16_t*)GC_MALLOC_ATOMIC((m_bufferCapacity + 1) * sizeof(char16_t));
+        for (size_t i = 0; i < m_bufferLength; i++) {
+            newBuffer[i] = src[i];
         }
+        if (!isInlineBuffer()) {
+            GC_FREE(m_buffer);
+        }
+        m_buffer = newBuffer;
+    }
+    m_has8BitContent = false;
+}
 
-        for (size_t i = 0; i < m_pieces.size(); i++) {
-            const StringBuilderPiece& piece = m_pieces[i];
-            if (piece.m_type == StringBuilderPiece::Char) {
-                ret[currentLength++] = (LChar)piece.m_ch;
-            } else if (piece.m_type == StringBuilderPiece::ConstChar) {
-                const char* data = piece.m_raw;
-                size_t l = piece.m_end;
-                memcpy(&ret[currentLength], data, l);
-                currentLength += l;
-            } else {
-                String* data = piece.m_string;
-                size_t s = piece.m_start;
-                size_t e = piece.m_end;
-                size_t l = e - s;
-                const auto& accessData = data->bufferAccessData();
-                if (accessData.has8BitContent) {
-                    memcpy(&ret[currentLength], ((LChar*)accessData.buffer) + s, l);
-                    currentLength += l;
-                } else {
-                    char16_t* b = ((char16_t*)accessData.buffer);
-                    for (size_t k = s; k < e; k++) {
-                        ret[currentLength++] = b[k];
-                    }
-                }
+// a rope piece is copied leaf by leaf and stays unflattened
+template <typename ResultType>
+static void copyStringRange(ResultType* dst, String* str, size_t s, size_t e)
+{
+    RopeString::forEachLeaf(str, s, e, [&dst](const StringBufferAccessData& data, size_t from, size_t to) -> bool {
+        if (data.has8BitContent) {
+            const LChar* src = ((const LChar*)data.buffer) + from;
+            for (size_t i = 0; i < to - from; i++) {
+                dst[i] = src[i];
+            }
+        } else {
+            // ResultType is LChar only when every piece has Latin1 content
+            const char16_t* src = data.bufferAs16Bit + from;
+            for (size_t i = 0; i < to - from; i++) {
+                dst[i] = (ResultType)src[i];
             }
         }
+        dst += to - from;
+        return true;
+    });
+}
+
+template <typename ResultType>
+ResultType* StringBuilder::mergeBufferAndPieces(const ResultType* buffer)
+{
+    ResultType* result = (ResultType*)GC_MALLOC_ATOMIC((m_contentLength + 1) * sizeof(ResultType));
+    size_t resultLength = 0;
+    size_t bufferPosition = 0;
+    for (size_t i = 0; i < m_pieces.size(); i++) {
+        const StringBuilderPiece& piece = m_pieces[i];
+        size_t l = piece.m_position - bufferPosition;
+        memcpy(result + resultLength, buffer + bufferPosition, l * sizeof(ResultType));
+        resultLength += l;
+        bufferPosition = piece.m_position;
+
+        copyStringRange(result + resultLength, piece.m_string, piece.m_start, piece.m_end);
+        resultLength += piece.m_end - piece.m_start;
+    }
+    memcpy(result + resultLength, buffer + bufferPosition, (m_bufferLength - bufferPosition) * sizeof(ResultType));
+    resultLength += m_bufferLength - bufferPosition;
+    ASSERT(resultLength == m_contentLength);
+    result[resultLength] = 0;
+    return result;
+}
 
+String* StringBuilder::finalize(ExecutionState* state)
+{
+    if (!m_contentLength) {
         clear();
-        return new Latin1String(std::move(ret));
+        return String::emptyString;
+    }
+
+    if (state && UNLIKELY(m_contentLength > STRING_MAXIMUM_LENGTH)) {
+        ErrorObject::throwBuiltinError(*state, ErrorObject::RangeError, ErrorObject::Messages::String_InvalidStringLength);
+    }
+
+    size_t length = m_contentLength;
+    bool is8Bit = m_has8BitContent;
+    size_t unitSize = is8Bit ? sizeof(LChar) : sizeof(char16_t);
+    void* result;
+    if (m_pieces.size()) {
+        if (is8Bit) {
+            result = mergeBufferAndPieces(buffer8());
+        } else {
+            result = mergeBufferAndPieces(buffer16());
+        }
     } else {
-        UTF16StringData ret;
-        ret.resizeWithUninitializedValues(m_contentLength);
-
-        size_t currentLength = 0;
-        for (size_t i = 0; i < m_piecesInlineStorageUsage; i++) {
-            const StringBuilderPiece& piece = m_piecesInlineStorage[i];
-            if (piece.m_type == StringBuilderPiece::Char) {
-                ret[currentLength++] = piece.m_ch;
-            } else if (piece.m_type == StringBuilderPiece::ConstChar) {
-                const char* data = piece.m_raw;
-                size_t l = piece.m_end;
-                for (size_t j = 0; j < l; j++) {
-                    ret[currentLength++] = data[j];
-                }
-            } else {
-                String* data = piece.m_string;
-                size_t s = piece.m_start;
-                size_t e = piece.m_end;
-                size_t l = e - s;
-                if (data->has8BitContent()) {
-                    auto ptr = data->characters8();
-                    ptr += s;
-                    for (size_t j = 0; j < l; j++) {
-                        ret[currentLength++] = ptr[j];
-                    }
-                } else {
-                    auto ptr = data->characters16();
-                    ptr += s;
-                    for (size_t j = 0; j < l; j++) {
-                        ret[currentLength++] = ptr[j];
-                    }
-                }
+        if (isInlineBuffer()) {
+            result = GC_MALLOC_ATOMIC((m_contentLength + 1) * unitSize);
+            memcpy(result, m_buffer, m_contentLength * unitSize);
+        } else {
+            // the buffer becomes the buffer of the result string
+            result = m_buffer;
+            if (m_bufferCapacity > m_contentLength + m_contentLength / 8) {
+                result = GC_REALLOC(result, (m_contentLength + 1) * unitSize);
             }
+            m_buffer = m_inlineBuffer;
         }
 
-        for (size_t i = 0; i < m_pieces.size(); i++) {
-            const StringBuilderPiece& piece = m_pieces[i];
-            if (piece.m_type == StringBuilderPiece::Char) {
-                ret[currentLength++] = piece.m_ch;
-            } else if (piece.m_type == StringBuilderPiece::ConstChar) {
-                const char* data = piece.m_raw;
-                size_t l = piece.m_end;
-                for (size_t j = 0; j < l; j++) {
-                    ret[currentLength++] = data[j];
-                }
-            } else {
-                String* data = piece.m_string;
-                size_t s = piece.m_start;
-                size_t e = piece.m_end;
-                size_t l = e - s;
-                if (data->has8BitContent()) {
-                    auto ptr = data->characters8();
-                    ptr += s;
-                    for (size_t j = 0; j < l; j++) {
-                        ret[currentLength++] = ptr[j];
-                    }
-                } else {
-                    auto ptr = data->characters16();
-                    ptr += s;
-                    for (size_t j = 0; j < l; j++) {
-                        ret[currentLength++] = ptr[j];
-                    }
-                }
-            }
+        if (m_has8BitContent) {
+            ((LChar*)result)[m_contentLength] = 0;
+        } else {
+            ((char16_t*)result)[m_contentLength] = 0;
         }
+    }
 
-        clear();
-        return new UTF16String(std::move(ret));
+    clear();
+
+    if (is8Bit) {
+        return new Latin1String((const LChar*)result, length, String::FromExternalMemory);
+    }
+    return new UTF16String((const char16_t*)result, length, String::FromExternalMemory);
+}
+
+void StringBuilder::clear()
+{
+    if (!isInlineBuffer()) {
+        GC_FREE(m_buffer);
+        m_buffer = m_inlineBuffer;
     }
+    m_has8BitContent = true;
+    m_bufferLength = 0;
+    m_bufferCapacity = STRING_BUILDER_INLINE_STORAGE_MAX;
+    m_contentLength = 0;
+    m_pieces.clear();
 }
 }
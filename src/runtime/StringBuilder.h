@@ -29,59 +29,84 @@ class ExecutionState;
 
 class StringBuilder {
     MAKE_STACK_ALLOCATED();
+    // a long string is not copied when appended. its characters are inserted
+    // at m_position of the buffered characters in finalize()
     struct StringBuilderPiece {
-        enum Type {
-            Latin1StringPiece,
-            UTF16StringStringPiece,
-            UTF16StringStringButLatin1ContentPiece,
-            ConstChar,
-            Char,
-        };
-        Type m_type;
-        union {
-            String* m_string;
-            const char* m_raw;
-            char16_t m_ch;
-        };
+        String* m_string;
         size_t m_start, m_end;
+        size_t m_position;
     };
 
-    void appendPiece(char16_t ch);
-    void appendPiece(const char* str);
     void appendPiece(String* str, size_t s, size_t e);
+    void appendBufferRange(const StringBufferAccessData& data, size_t s, size_t e);
+    void appendLatin1(const LChar* src, size_t len);
+    void appendUTF16(const char16_t* src, size_t len);
+    void appendCharSlowCase(char16_t ch);
+    void ensureCapacity(size_t extra);
+    void convertTo16Bit();
+    template <typename ResultType>
+    ResultType* mergeBufferAndPieces(const ResultType* buffer);
+
+    LChar* buffer8()
+    {
+        ASSERT(m_has8BitContent);
+        return (LChar*)m_buffer;
+    }
+
+    char16_t* buffer16()
+    {
+        ASSERT(!m_has8BitContent);
+        return (char16_t*)m_buffer;
+    }
+
+    bool isInlineBuffer() const
+    {
+        return m_buffer == m_inlineBuffer;
+    }
 
 public:
     StringBuilder()
+        : m_has8BitContent(true)
+        , m_buffer(m_inlineBuffer)
+        , m_bufferLength(0)
+        , m_bufferCapacity(STRING_BUILDER_INLINE_STORAGE_MAX)
+        , m_contentLength(0)
     {
-        m_has8BitContent = true;
-        m_contentLength = 0;
-        m_piecesInlineStorageUsage = 0;
     }
 
+    // m_buffer can point m_inlineBuffer of this builder
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
     size_t contentLength() { return m_contentLength; }
     void appendString(const char* str)
     {
-        appendPiece(str);
+        appendLatin1((const LChar*)str, strlen(str));
     }
 
     void appendChar(char16_t ch)
     {
-        appendPiece(ch);
+        if (LIKELY(m_has8BitContent && ch < 256 && m_bufferLength < m_bufferCapacity)) {
+            buffer8()[m_bufferLength++] = ch;
+            m_contentLength++;
+            return;
+        }
+        appendCharSlowCase(ch);
     }
 
     void appendChar(char32_t ch)
     {
         char16_t buf[2];
         auto c = utf32ToUtf16(ch, buf);
-        appendPiece(buf[0]);
+        appendChar(buf[0]);
         if (c == 2) {
-            appendPiece(buf[1]);
+            appendChar(buf[1]);
         }
     }
 
     void appendChar(char ch)
     {
-        appendPiece(ch);
+        appendChar((char16_t)(LChar)ch);
     }
 
     void appendString(String* str)
@@ -96,20 +121,18 @@ public:
 
     String* finalize(ExecutionState* state = nullptr); // provide ExecutionState if you need limit of string length(exception can be thrown only in ExecutionState area)
 
-    void clear()
-    {
-        m_has8BitContent = true;
-        m_contentLength = 0;
-        m_piecesInlineStorageUsage = 0;
-        m_pieces.clear();
-    }
+    void clear();
 
 private:
     bool m_has8BitContent : 1;
-    size_t m_piecesInlineStorageUsage;
-    size_t m_contentLength;
-    StringBuilderPiece m_piecesInlineStorage[STRING_BUILDER_INLINE_STORAGE_MAX];
+    // characters are kept in m_inlineBuffer first, then in a GC_MALLOC_ATOMIC buffer which grows twice
+    // the buffer holds LChars until a non-Latin1 character is appended. it holds char16_ts from then on
+    void* m_buffer;
+    size_t m_bufferLength;
+    size_t m_bufferCapacity; // in characters. a heap buffer has room for one more character to put the terminating zero
+    size_t m_contentLength; // length of the buffer and the pieces
     Vector<StringBuilderPiece, GCUtil::gc_malloc_allocator<StringBuilderPiece>> m_pieces;
+    char16_t m_inlineBuffer[STRING_BUILDER_INLINE_STORAGE_MAX / sizeof(char16_t)];
 };
 }
 
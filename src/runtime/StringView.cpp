@@ -19,6 +19,7 @@
 
 #include "Escargot.h"
 #include "StringView.h"
+#include "runtime/CompressibleString.h"
 
 namespace Escargot {
 
@@ -34,4 +35,111 @@ void* StringView::operator new(size_t size)
     }
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
+
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+StringBufferAccessData StringView::compressibleStringBufferAccessData()
+{
+    CompressibleString* str = static_cast<CompressibleString*>(m_bufferData.bufferAsString);
+    return str->rangeBufferAccessData(m_start, m_start + m_bufferData.length);
+}
+#endif
+
+DetachableStringView::Statistics DetachableStringView::s_statistics;
+
+void* DetachableStringView::operator new(size_t size)
+{
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        // m_bufferData.bufferAsString is not marked. the parent is kept by other references only
+        GC_word obj_bitmap[GC_BITMAP_SIZE(DetachableStringView)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(DetachableStringView, m_detachedBuffer));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(DetachableStringView));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
+// finalizer data of a parent string. each element is a disappearing link to a view of the parent,
+// which is cleared by GC when the view is collected. the list is not visible to GC
+struct DetachableStringViewList {
+    DetachableStringViewList()
+        : m_pruneSize(16)
+    {
+    }
+
+    std::list<void*, std::allocator<void*>> m_links;
+    size_t m_pruneSize;
+};
+
+StringView* DetachableStringView::create(String* str, const size_t s, const size_t e)
+{
+    size_t parentLength = str->length();
+    if (parentLength < STRING_VIEW_DETACH_MIN_PARENT_LENGTH || (e - s) * STRING_VIEW_DETACH_LENGTH_RATIO > parentLength
+        || str->isStringView() || GC_base(str) != str) {
+        return new StringView(str, s, e);
+    }
+
+    GC_finalization_proc oldFinalizer = nullptr;
+    void* oldData = nullptr;
+    GC_REGISTER_FINALIZER_NO_ORDER(str, detachViews, nullptr, &oldFinalizer, &oldData);
+    if (oldFinalizer && oldFinalizer != detachViews) {
+        // the string has its own finalizer (e.g. CompressibleString). give it back and keep the parent alive
+        GC_REGISTER_FINALIZER_NO_ORDER(str, oldFinalizer, oldData, nullptr, nullptr);
+        return new StringView(str, s, e);
+    }
+
+    DetachableStringViewList* list = oldFinalizer ? (DetachableStringViewList*)oldData : new DetachableStringViewList();
+    GC_REGISTER_FINALIZER_NO_ORDER(str, detachViews, list, nullptr, nullptr);
+
+    if (list->m_links.size() >= list->m_pruneSize) {
+        list->m_links.remove(nullptr);
+        list->m_pruneSize = std::max(list->m_pruneSize, list->m_links.size() * 2);
+    }
+
+    DetachableStringView* view = new DetachableStringView(str, s, e);
+    list->m_links.push_back(view);
+    GC_GENERAL_REGISTER_DISAPPEARING_LINK(&list->m_links.back(), view);
+    return view;
+}
+
+void DetachableStringView::detachViews(void* parent, void* data)
+{
+    // called when the parent is reachable from nothing but views. copy the live views out of it
+    DetachableStringViewList* list = (DetachableStringViewList*)data;
+    bool detached = false;
+    for (auto iter = list->m_links.begin(); iter != list->m_links.end(); iter++) {
+        if (*iter) {
+            DetachableStringView* view = (DetachableStringView*)*iter;
+            GC_unregister_disappearing_link(&*iter);
+            view->detach();
+            detached = true;
+        }
+    }
+
+    if (detached) {
+        String* str = (String*)parent;
+        s_statistics.reclaimedBytes += str->length() * (str->has8BitContent() ? sizeof(LChar) : sizeof(char16_t));
+    }
+    delete list;
+}
+
+void DetachableStringView::detach()
+{
+    ASSERT(m_bufferData.hasSpecialImpl);
+    const auto& data = bufferAccessData();
+    size_t unitSize = data.has8BitContent ? sizeof(LChar) : sizeof(char16_t);
+    size_t byteLength = data.length * unitSize;
+    char* buffer = (char*)GC_MALLOC_ATOMIC(byteLength + unitSize);
+    memcpy(buffer, data.buffer, byteLength);
+    memset(buffer + byteLength, 0, unitSize);
+
+    m_detachedBuffer = buffer;
+    m_bufferData.buffer = buffer;
+    m_bufferData.hasSpecialImpl = false;
+    m_start = 0;
+
+    s_statistics.detachedViewCount++;
+    s_statistics.copiedBytes += byteLength;
+}
 }
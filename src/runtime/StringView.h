@@ -132,6 +132,12 @@ protected:
     {
         ASSERT(m_bufferData.hasSpecialImpl);
 
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+        if (UNLIKELY(m_bufferData.bufferAsString->isCompressibleString())) {
+            return compressibleStringBufferAccessData();
+        }
+#endif
+
         StringBufferAccessData r = m_bufferData.bufferAsString->bufferAccessData();
         // keep original buffer pointer in stack
         // without this, compressible string can free this pointer
@@ -155,9 +161,53 @@ protected:
         m_start = start;
     }
 
-private:
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    // reads only the range of the view, so a function of a compressed script source does not decompress the whole source
+    StringBufferAccessData compressibleStringBufferAccessData();
+#endif
+
     size_t m_start;
 };
+
+// a short view created by String::substring over a much longer string.
+// the pointer to the longer string is hidden from GC. when nothing else keeps the longer string,
+// its finalizer copies the characters of every view alive out of it, so a few slices do not keep the whole string
+class DetachableStringView : public StringView {
+public:
+    struct Statistics {
+        size_t detachedViewCount;
+        size_t copiedBytes;
+        size_t reclaimedBytes;
+    };
+
+    // returns a DetachableStringView if str is long enough and the view is short enough to be worth it
+    // otherwise returns a plain StringView
+    static StringView* create(String* str, const size_t s, const size_t e);
+
+    // counted for every VMInstance of the process
+    static const Statistics& statistics()
+    {
+        return s_statistics;
+    }
+
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+
+private:
+    DetachableStringView(String* str, const size_t s, const size_t e)
+        : StringView(str, s, e)
+        , m_detachedBuffer(nullptr)
+    {
+    }
+
+    static void detachViews(void* parent, void* views);
+    void detach();
+
+    // owns the characters after detach()
+    void* m_detachedBuffer;
+
+    static Statistics s_statistics;
+};
 }
 
 #endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "UTF8String.h"
+#include "util/Transcoder.h"
+
+namespace Escargot {
+
+void* UTF8String::operator new(size_t size)
+{
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        // m_utf8Source is external memory. only the decoded buffer is traced
+        GC_word obj_bitmap[GC_BITMAP_SIZE(UTF8String)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(UTF8String, m_bufferData.buffer));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(UTF8String));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
+UTF8String::UTF8String(const char* src, size_t len, FromExternalMemoryTag)
+    : String()
+    , m_utf8Source(src)
+    , m_utf8Length(len)
+{
+    if (isAllASCII(src, len)) {
+        m_bufferData.has8BitContent = true;
+        m_bufferData.length = len;
+        m_bufferData.buffer = src;
+        return;
+    }
+
+    bool isLatin1;
+    m_bufferData.length = Transcoder::utf16LengthOfUTF8(src, len, isLatin1);
+    m_bufferData.has8BitContent = isLatin1;
+    m_bufferData.buffer = nullptr;
+    m_bufferData.hasSpecialImpl = true;
+}
+
+void UTF8String::decode()
+{
+    ASSERT(m_bufferData.hasSpecialImpl);
+    size_t length = m_bufferData.length;
+    if (m_bufferData.has8BitContent) {
+        LChar* buffer = (LChar*)GC_MALLOC_ATOMIC(length);
+        Transcoder::decodeUTF8(m_utf8Source, m_utf8Length, buffer);
+        m_bufferData.buffer = buffer;
+    } else {
+        char16_t* buffer = (char16_t*)GC_MALLOC_ATOMIC(length * sizeof(char16_t));
+        Transcoder::decodeUTF8(m_utf8Source, m_utf8Length, buffer);
+        m_bufferData.buffer = buffer;
+    }
+    m_bufferData.hasSpecialImpl = false;
+}
+
+StringBufferAccessData UTF8String::bufferAccessDataSpecialImpl()
+{
+    decode();
+    return m_bufferData;
+}
+
+UTF16StringData UTF8String::toUTF16StringData() const
+{
+    UTF16StringData ret;
+    ret.resizeWithUninitializedValues(length());
+    if (!isDecoded()) {
+        // decode straight into the result. the decoded form is not kept
+        Transcoder::decodeUTF8(m_utf8Source, m_utf8Length, ret.data());
+    } else if (m_bufferData.has8BitContent) {
+        Transcoder::widenLatin1ToUTF16((const LChar*)m_bufferData.buffer, length(), ret.data());
+    } else {
+        memcpy(ret.data(), m_bufferData.buffer, length() * sizeof(char16_t));
+    }
+    return ret;
+}
+
+UTF8StringData UTF8String::toUTF8StringData() const
+{
+    return UTF8StringData(m_utf8Source, m_utf8Length);
+}
+
+UTF8StringDataNonGCStd UTF8String::toNonGCUTF8StringData(int options) const
+{
+    return UTF8StringDataNonGCStd(m_utf8Source, m_utf8Length);
+}
+}
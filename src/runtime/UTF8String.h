@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotUTF8String__
+#define __EscargotUTF8String__
+
+#include "runtime/String.h"
+
+namespace Escargot {
+
+// String on external UTF-8 memory.
+// length and width are computed with one scan at creation, but the UTF-16 (or Latin-1) form is
+// decoded only when characters are accessed. pure ASCII sources are used in place without decoding.
+// UTF-8 output is copied from the source directly, so it should be valid UTF-8 and must not change while this string is alive
+class UTF8String : public String {
+public:
+    UTF8String(const char* src, size_t len, FromExternalMemoryTag);
+
+    virtual UTF16StringData toUTF16StringData() const override;
+    virtual UTF8StringData toUTF8StringData() const override;
+    virtual UTF8StringDataNonGCStd toNonGCUTF8StringData(int options = StringWriteOption::NoOptions) const override;
+
+    virtual const LChar* characters8() const override
+    {
+        return (const LChar*)bufferAccessData().buffer;
+    }
+
+    virtual const char16_t* characters16() const override
+    {
+        return (const char16_t*)bufferAccessData().buffer;
+    }
+
+    bool isDecoded() const
+    {
+        return !m_bufferData.hasSpecialImpl;
+    }
+
+    const char* utf8Source() const
+    {
+        return m_utf8Source;
+    }
+
+    size_t utf8Length() const
+    {
+        return m_utf8Length;
+    }
+
+    void* operator new(size_t);
+    void* operator new[](size_t) = delete;
+
+protected:
+    virtual StringBufferAccessData bufferAccessDataSpecialImpl() override;
+
+private:
+    void decode();
+
+    const char* m_utf8Source;
+    size_t m_utf8Length;
+};
+}
+
+#endif
@@ -97,26 +97,164 @@ static ObjectPropertyNativeGetterSetterData regexpLastIndexGetterSetterData(
 #define COMPRESSIBLE_COMPRESS_CHECK_INTERVAL 1000
 #define COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL 1000
 #define COMPRESSIBLE_COMPRESS_MIN_SIZE 1024 * 128
+#define COMPRESSIBLE_COMPRESS_BYTE_BUDGET 1024 * 1024 * 16
+#define COMPRESSIBLE_COMPRESS_TIME_BUDGET 10
+
+VMInstance::CompressibleStringPolicy::CompressibleStringPolicy()
+    : m_checkInterval(COMPRESSIBLE_COMPRESS_CHECK_INTERVAL)
+    , m_coldTime(COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL)
+    , m_minByteSize(COMPRESSIBLE_COMPRESS_MIN_SIZE)
+    , m_byteBudget(COMPRESSIBLE_COMPRESS_BYTE_BUDGET)
+    , m_timeBudget(COMPRESSIBLE_COMPRESS_TIME_BUDGET)
+{
+}
+
+void VMInstance::setCompressibleStringPolicy(const CompressibleStringPolicy& policy)
+{
+    m_compressibleStringPolicy = policy;
+
+    // m_minByteSize decides what is queued
+    while (m_compressibleStringQueue.size()) {
+        removeQueuedCompressibleString(m_compressibleStringQueue.size() - 1);
+    }
+    for (size_t i = 0; i < m_compressibleStrings.size(); i++) {
+        queueCompressibleString(m_compressibleStrings[i]);
+    }
+}
+
+bool VMInstance::isQueuedBefore(CompressibleString* a, CompressibleString* b)
+{
+    if (a->m_queuedTickcount != b->m_queuedTickcount) {
+        return a->m_queuedTickcount < b->m_queuedTickcount;
+    }
+    return a->decomressedBufferSize() > b->decomressedBufferSize();
+}
+
+void VMInstance::setQueuedCompressibleString(size_t index, CompressibleString* str)
+{
+    m_compressibleStringQueue[index] = str;
+    str->m_queueIndex = index;
+}
+
+void VMInstance::siftUpCompressibleString(size_t index)
+{
+    CompressibleString* str = m_compressibleStringQueue[index];
+    while (index) {
+        size_t parent = (index - 1) / 2;
+        if (!isQueuedBefore(str, m_compressibleStringQueue[parent])) {
+            break;
+        }
+        setQueuedCompressibleString(index, m_compressibleStringQueue[parent]);
+        index = parent;
+    }
+    setQueuedCompressibleString(index, str);
+}
+
+void VMInstance::siftDownCompressibleString(size_t index)
+{
+    CompressibleString* str = m_compressibleStringQueue[index];
+    size_t size = m_compressibleStringQueue.size();
+    while (true) {
+        size_t child = index * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && isQueuedBefore(m_compressibleStringQueue[child + 1], m_compressibleStringQueue[child])) {
+            child++;
+        }
+        if (!isQueuedBefore(m_compressibleStringQueue[child], str)) {
+            break;
+        }
+        setQueuedCompressibleString(index, m_compressibleStringQueue[child]);
+        index = child;
+    }
+    setQueuedCompressibleString(index, str);
+}
+
+void VMInstance::removeQueuedCompressibleString(size_t index)
+{
+    CompressibleString* str = m_compressibleStringQueue[index];
+    CompressibleString* last = m_compressibleStringQueue.back();
+    m_compressibleStringQueue.pop_back();
+    str->m_queueIndex = SIZE_MAX;
+
+    if (last != str) {
+        setQueuedCompressibleString(index, last);
+        siftDownCompressibleString(index);
+        siftUpCompressibleString(last->m_queueIndex);
+    }
+}
+
+void VMInstance::queueCompressibleString(CompressibleString* str)
+{
+    // a compressed string is queued while it has chunks decompressed for ranges
+    size_t byteSize = str->decomressedBufferSize();
+    if (str->m_queueIndex != SIZE_MAX || !byteSize || (!str->isCompressed() && byteSize < m_compressibleStringPolicy.m_minByteSize)) {
+        return;
+    }
+
+    str->m_queuedTickcount = str->m_lastUsedTickcount;
+    m_compressibleStringQueue.push_back(str);
+    str->m_queueIndex = m_compressibleStringQueue.size() - 1;
+    siftUpCompressibleString(str->m_queueIndex);
+}
+
+void VMInstance::dequeueCompressibleString(CompressibleString* str)
+{
+    if (str->m_queueIndex != SIZE_MAX) {
+        removeQueuedCompressibleString(str->m_queueIndex);
+    }
+}
 
 void VMInstance::compressStringsIfNeeds(uint64_t currentTickCount)
 {
-    auto& currentAllocatedCompressibleStrings = compressibleStrings();
-    const size_t& currentAllocatedCompressibleStringsCount = currentAllocatedCompressibleStrings.size();
-    size_t mostBigIndex = SIZE_MAX;
+    const CompressibleStringPolicy& policy = m_compressibleStringPolicy;
+    uint64_t startTime = longTickCount();
+    size_t compressedBytes = 0;
+    // strings referenced from the stack now. they are queued again as if they were used now
+    std::vector<CompressibleString*> inUse;
+
+    while (m_compressibleStringQueue.size()) {
+        CompressibleString* str = m_compressibleStringQueue[0];
+        if (str->m_queuedTickcount != str->m_lastUsedTickcount) {
+            str->m_queuedTickcount = str->m_lastUsedTickcount;
+            siftDownCompressibleString(0);
+            continue;
+        }
+
+        if (currentTickCount - str->m_lastUsedTickcount < policy.m_coldTime) {
+            // every other string was used later
+            break;
+        }
+
+        size_t byteSize = str->decomressedBufferSize();
+        if (compressedBytes && (compressedBytes + byteSize > policy.m_byteBudget || (longTickCount() - startTime) / 1000 >= policy.m_timeBudget)) {
+            break;
+        }
 
-    for (size_t i = 0; i < currentAllocatedCompressibleStringsCount; i++) {
-        if (!currentAllocatedCompressibleStrings[i]->isCompressed() && currentTickCount - currentAllocatedCompressibleStrings[i]->m_lastUsedTickcount > COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL && currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > COMPRESSIBLE_COMPRESS_MIN_SIZE) {
-            if (mostBigIndex == SIZE_MAX) {
-                mostBigIndex = i;
-            } else if (currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > currentAllocatedCompressibleStrings[mostBigIndex]->decomressedBufferSize()) {
-                mostBigIndex = i;
+        removeQueuedCompressibleString(0);
+        bool hasWholeBuffer = !str->isCompressed();
+        bool released = str->compress();
+        if (hasWholeBuffer && str->isCompressed()) {
+            m_compressibleStringStatistics.m_compressionCount++;
+            m_compressibleStringStatistics.m_compressedBytes += str->byteLength();
+            for (size_t i = 0; i < str->m_compressedData.size(); i++) {
+                m_compressibleStringStatistics.m_compressedSize += str->m_compressedData[i].size();
             }
         }
+        if (released) {
+            compressedBytes += byteSize;
+        } else {
+            inUse.push_back(str);
+        }
     }
 
-    if (mostBigIndex != SIZE_MAX) {
-        currentAllocatedCompressibleStrings[mostBigIndex]->compress();
+    for (size_t i = 0; i < inUse.size(); i++) {
+        inUse[i]->m_lastUsedTickcount = currentTickCount;
+        queueCompressibleString(inUse[i]);
     }
+
+    m_compressibleStringStatistics.m_compressionTime += longTickCount() - startTime;
 }
 #endif
 
@@ -131,10 +269,6 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
 #endif /* ESCARGOT_DEBUGGER */
 
     if (t == GC_EventType::GC_EVENT_MARK_START && !debuggerEnabled) {
-        if (self->m_regexpCache->size() > REGEXP_CACHE_SIZE_MAX) {
-            self->m_regexpCache->clear();
-        }
-
         auto& currentCodeSizeTotal = self->compiledByteCodeSize();
         if (currentCodeSizeTotal > SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX) {
             currentCodeSizeTotal = std::numeric_limits<size_t>::max();
@@ -147,7 +281,7 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
     } else if (t == GC_EventType::GC_EVENT_RECLAIM_END) {
 #if defined(ENABLE_COMPRESSIBLE_STRING)
         auto currentTick = fastTickCount();
-        if (currentTick - self->m_lastCompressibleStringsTestTime > COMPRESSIBLE_COMPRESS_CHECK_INTERVAL) {
+        if (currentTick - self->m_lastCompressibleStringsTestTime >= self->m_compressibleStringPolicy.m_checkInterval) {
             self->compressStringsIfNeeds(currentTick);
             self->m_lastCompressibleStringsTestTime = currentTick;
         }
@@ -183,7 +317,8 @@ void* VMInstance::operator new(size_t size)
     static GC_descr descr;
     if (!typeInited) {
         GC_word desc[GC_BITMAP_SIZE(VMInstance)] = { 0 };
-        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_staticStrings.dtoaCache));
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_staticStrings.m_numberToStringCache));
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_staticStrings.m_arrayIndexStringCache));
 
         // we should mark every word of m_atomicStringMap
         for (size_t i = 0; i < sizeof(m_atomicStringMap); i += sizeof(size_t)) {
@@ -195,6 +330,7 @@ void* VMInstance::operator new(size_t size)
 #undef DECLARE_GLOBAL_SYMBOLS
 
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_globalSymbolRegistry));
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_contexts));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_currentSandBox));
 
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_defaultStructureForObject));
@@ -261,6 +397,7 @@ VMInstance::~VMInstance()
 VMInstance::VMInstance(Platform* platform, const char* locale, const char* timezone)
     : m_staticStrings(&m_atomicStringMap)
     , m_currentSandBox(nullptr)
+    , m_maxStackTraceDepth(STACK_TRACE_DEPTH_MAX)
     , m_randEngine((unsigned int)time(NULL))
     , m_isFinalized(false)
     , m_didSomePrototypeObjectDefineIndexedProperty(false)
@@ -303,7 +440,7 @@ VMInstance::VMInstance(Platform* platform, const char* locale, const char* timez
     m_staticStrings.initStaticStrings();
 
     m_bumpPointerAllocator = new (PointerFreeGC) WTF::BumpPointerAllocator();
-    m_regexpCache = new (GC) RegExpCacheMap();
+    m_regexpCache = new RegExpCache();
     m_regexpOptionStringCache = (ASCIIString**)GC_MALLOC(64 * sizeof(ASCIIString*));
     memset(m_regexpOptionStringCache, 0, 64 * sizeof(ASCIIString*));
 
@@ -473,6 +610,34 @@ void VMInstance::somePrototypeObjectDefineIndexedProperty(ExecutionState& state)
     }
 }
 
+void VMInstance::registerContext(Context* context)
+{
+    // drop the cells of collected contexts
+    size_t live = 0;
+    for (size_t i = 0; i < m_contexts.size(); i++) {
+        if (*m_contexts[i]) {
+            m_contexts[live++] = m_contexts[i];
+        }
+    }
+    m_contexts.resizeWithUninitializedValues(live);
+
+    Context** cell = (Context**)GC_MALLOC_ATOMIC(sizeof(Context*));
+    *cell = context;
+    GC_GENERAL_REGISTER_DISAPPEARING_LINK((void**)cell, context);
+    m_contexts.pushBack(cell);
+}
+
+ContextVector VMInstance::liveContexts()
+{
+    ContextVector result;
+    for (size_t i = 0; i < m_contexts.size(); i++) {
+        if (*m_contexts[i]) {
+            result.pushBack(*m_contexts[i]);
+        }
+    }
+    return result;
+}
+
 void VMInstance::enqueuePromiseJob(PromiseObject* promise, Job* job)
 {
     m_jobQueue->enqueueJob(job);
@@ -66,6 +66,7 @@ struct GlobalSymbolRegistryItem {
 };
 
 typedef Vector<GlobalSymbolRegistryItem, GCUtil::gc_malloc_allocator<GlobalSymbolRegistryItem>> GlobalSymbolRegistryVector;
+typedef Vector<Context*, GCUtil::gc_malloc_allocator<Context*>> ContextVector;
 
 class VMInstance : public gc {
     friend class Context;
@@ -92,6 +93,9 @@ public:
         return m_globalSymbolRegistry;
     }
 
+    // contexts of this instance which are not collected yet
+    ContextVector liveContexts();
+
 #if defined(ENABLE_ICU)
     const std::string& locale()
     {
@@ -192,6 +196,54 @@ public:
     {
         return m_compressibleStringsUncomressedBufferSize;
     }
+
+    // how cold CompressibleStrings are compressed after GC. times are in milliseconds
+    struct CompressibleStringPolicy {
+        CompressibleStringPolicy();
+
+        uint64_t m_checkInterval; // between two compression passes
+        uint64_t m_coldTime; // a string unused for this long is compressed
+        size_t m_minByteSize; // smaller strings are never compressed
+        size_t m_byteBudget; // uncompressed bytes compressed by one pass at most
+        uint64_t m_timeBudget; // a pass does not start another string after this long
+    };
+
+    struct CompressibleStringStatistics {
+        CompressibleStringStatistics()
+            : m_compressionCount(0)
+            , m_compressedBytes(0)
+            , m_compressedSize(0)
+            , m_decompressionCount(0)
+            , m_decompressedBytes(0)
+            , m_compressionTime(0)
+            , m_decompressionTime(0)
+        {
+        }
+
+        size_t m_compressionCount;
+        size_t m_compressedBytes; // uncompressed bytes of the strings compressed
+        size_t m_compressedSize; // bytes they were compressed into
+        size_t m_decompressionCount; // of whole strings and of ranges
+        size_t m_decompressedBytes;
+        uint64_t m_compressionTime; // in microseconds
+        uint64_t m_decompressionTime; // in microseconds
+    };
+
+    const CompressibleStringPolicy& compressibleStringPolicy()
+    {
+        return m_compressibleStringPolicy;
+    }
+
+    void setCompressibleStringPolicy(const CompressibleStringPolicy& policy);
+
+    CompressibleStringStatistics& compressibleStringStatistics()
+    {
+        return m_compressibleStringStatistics;
+    }
+
+    // an uncompressed string is queued to be compressed when it gets cold
+    void queueCompressibleString(CompressibleString* str);
+    void dequeueCompressibleString(CompressibleString* str);
 #endif
 
     std::mt19937& randEngine()
@@ -219,6 +271,17 @@ public:
         return m_regexpOptionStringCache;
     }
 
+    // number of frames recorded when an exception is thrown
+    size_t maxStackTraceDepth()
+    {
+        return m_maxStackTraceDepth;
+    }
+
+    void setMaxStackTraceDepth(size_t depth)
+    {
+        m_maxStackTraceDepth = depth;
+    }
+
 
     void setOnDestroyCallback(void (*onVMInstanceDestroy)(VMInstance* instance, void* data), void* data)
     {
@@ -240,7 +303,11 @@ private:
     AtomicStringMap m_atomicStringMap;
     GlobalSymbols m_globalSymbols;
     GlobalSymbolRegistryVector m_globalSymbolRegistry;
+    // every Context is kept in its own atomic cell registered as a disappearing link,
+    // so this list does not keep contexts alive
+    Vector<Context**, GCUtil::gc_malloc_allocator<Context**>> m_contexts;
     SandBox* m_currentSandBox;
+    size_t m_maxStackTraceDepth;
 
     std::mt19937 m_randEngine;
 
@@ -271,10 +338,23 @@ private:
     uint64_t m_lastCompressibleStringsTestTime;
     size_t m_compressibleStringsUncomressedBufferSize;
     std::vector<CompressibleString*> m_compressibleStrings;
+    // uncompressed strings of at least m_minByteSize bytes as a binary heap.
+    // the least recently used one comes first, and the bigger one of the same last use
+    // the last use is the one when the string was queued. a string used since is requeued when it comes up
+    std::vector<CompressibleString*> m_compressibleStringQueue;
+    CompressibleStringPolicy m_compressibleStringPolicy;
+    CompressibleStringStatistics m_compressibleStringStatistics;
 
     NEVER_INLINE void compressStringsIfNeeds(uint64_t currentTickCount = fastTickCount());
+    bool isQueuedBefore(CompressibleString* a, CompressibleString* b);
+    void setQueuedCompressibleString(size_t index, CompressibleString* str);
+    void siftUpCompressibleString(size_t index);
+    void siftDownCompressibleString(size_t index);
+    void removeQueuedCompressibleString(size_t index);
 #endif
 
+    void registerContext(Context* context);
+
     static void gcEventCallback(GC_EventType t, void* data);
     void (*m_onVMInstanceDestroy)(VMInstance* instance, void* data);
     void* m_onVMInstanceDestroyData;
@@ -285,7 +365,7 @@ private:
 
     // regexp object data
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
-    RegExpCacheMap* m_regexpCache;
+    RegExpCache* m_regexpCache;
     ASCIIString** m_regexpOptionStringCache;
 
 // date object data
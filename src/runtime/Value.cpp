@@ -710,7 +710,12 @@ Value::ValueIndex Value::tryToUseAsIndexSlowCase(ExecutionState& ec) const
     if (isSymbol()) {
         return Value::InvalidIndexValue;
     }
-    return toString(ec)->tryToUseAsIndex();
+    String* string = toString(ec);
+    uint32_t index = ec.context()->staticStrings().tryToUseAsArrayIndex(string);
+    if (index != Value::InvalidArrayIndexValue) {
+        return index;
+    }
+    return string->tryToUseAsIndex();
 }
 
 uint32_t Value::tryToUseAsArrayIndexSlowCase(ExecutionState& ec) const
@@ -718,6 +723,6 @@ uint32_t Value::tryToUseAsArrayIndexSlowCase(ExecutionState& ec) const
     if (isSymbol()) {
         return Value::InvalidArrayIndexValue;
     }
-    return toString(ec)->tryToUseAsArrayIndex();
+    return ec.context()->staticStrings().tryToUseAsArrayIndex(toString(ec));
 }
 }
@@ -25,6 +25,8 @@
 namespace Escargot {
 
 class WeakMapObject : public Object {
+    friend class HeapSnapshot;
+
 public:
     struct WeakMapObjectDataItem : public gc {
         Object* key;
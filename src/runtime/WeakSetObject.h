@@ -25,6 +25,8 @@
 namespace Escargot {
 
 class WeakSetObject : public Object {
+    friend class HeapSnapshot;
+
 public:
     struct WeakSetObjectDataItem : public gc {
         Object* key;
@@ -209,15 +209,41 @@ static OptionalRef<StringRef> builtinHelperFileRead(OptionalRef<ExecutionStateRe
     }
 }
 
+struct FileChunkReader {
+    FILE* fp;
+    char buffer[4096];
+
+    static size_t read(const char** chunk, void* data)
+    {
+        FileChunkReader* reader = (FileChunkReader*)data;
+        *chunk = reader->buffer;
+        return fread(reader->buffer, 1, sizeof(reader->buffer), reader->fp);
+    }
+};
+
 static ValueRef* builtinLoad(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
 {
     if (argc >= 1) {
         auto f = argv[0]->toString(state)->toStdUTF8String();
         const char* fileName = f.data();
-        StringRef* src = builtinHelperFileRead(state, fileName, "load").value();
         bool isModule = stringEndsWith(f, "mjs");
 
-        auto script = state->context()->scriptParser()->initializeScript(src, argv[0]->toString(state), isModule).fetchScriptThrowsExceptionIfParseError(state);
+        FileChunkReader reader;
+        reader.fp = fopen(fileName, "rb");
+        if (!reader.fp) {
+            // throws the error for the file
+            builtinHelperFileRead(state, fileName, "load");
+            return ValueRef::createUndefined();
+        }
+
+        // the file is decoded while it is read instead of being gathered into one string first
+        fseek(reader.fp, 0, SEEK_END);
+        size_t fileSize = ftell(reader.fp);
+        fseek(reader.fp, 0, SEEK_SET);
+        auto result = state->context()->scriptParser()->initializeScriptFromStream(FileChunkReader::read, &reader, argv[0]->toString(state), isModule, fileSize);
+        fclose(reader.fp);
+
+        auto script = result.fetchScriptThrowsExceptionIfParseError(state);
         return script->execute(state);
     } else {
         return ValueRef::createUndefined();
@@ -630,6 +656,7 @@ int main(int argc, char* argv[])
     bool runShell = true;
     bool seenModule = false;
     std::string fileName;
+    std::string heapSnapshotFileName;
 
     for (int i = 1; i < argc; i++) {
         if (strlen(argv[i]) >= 2 && argv[i][0] == '-') { // parse command line option
@@ -646,6 +673,10 @@ int main(int argc, char* argv[])
                     fileName = argv[i] + sizeof("--filename-as=") - 1;
                     continue;
                 }
+                if (strstr(argv[i], "--heap-snapshot=") == argv[i]) {
+                    heapSnapshotFileName = argv[i] + sizeof("--heap-snapshot=") - 1;
+                    continue;
+                }
                 if (strcmp(argv[i], "--start-debug-server") == 0) {
                     context->initDebugger(nullptr);
                     continue;
@@ -709,6 +740,20 @@ int main(int argc, char* argv[])
         }
     }
 
+    // written after every given script has run
+    if (heapSnapshotFileName.length()) {
+        FILE* fp = fopen(heapSnapshotFileName.data(), "w");
+        if (!fp) {
+            printf("Cannot open file %s\n", heapSnapshotFileName.data());
+            return 3;
+        }
+        instance->writeHeapSnapshot([](const char* data, size_t length, void* callbackData) {
+            fwrite(data, 1, length, (FILE*)callbackData);
+        },
+                                    fp);
+        fclose(fp);
+    }
+
     while (runShell) {
         static char buf[2048];
         printf("escargot> ");
@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "Transcoder.h"
+
+#if defined(CPU_X86) || defined(CPU_X86_64)
+#if defined(__SSE2__) || defined(CPU_X86_64)
+#define TRANSCODER_USE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(TRANSCODER_USE_SSE2) && (defined(COMPILER_GCC) || defined(COMPILER_CLANG))
+#define TRANSCODER_USE_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TRANSCODER_USE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Escargot {
+
+#if defined(TRANSCODER_USE_AVX2)
+static bool hasAVX2()
+{
+    static int result = -1;
+    if (UNLIKELY(result < 0)) {
+        __builtin_cpu_init();
+        result = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return result;
+}
+
+__attribute__((target("avx2"))) static size_t findFirstNonASCIIAVX2(const char* src, size_t len, bool& found)
+{
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(v);
+        if (mask) {
+            found = true;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    found = false;
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t widenLatin1ToUTF16AVX2(const LChar* src, size_t len, char16_t* dst)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_cvtepu8_epi16(v));
+    }
+    return i;
+}
+#endif
+
+// scan as many whole vectors as possible. the caller finishes the tail with scalar code
+static ALWAYS_INLINE size_t asciiPrefixOfBlocks(const char* src, size_t len)
+{
+    size_t i = 0;
+#if defined(TRANSCODER_USE_SSE2)
+    for (; i + 16 <= len; i += 16) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(src + i)));
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#elif defined(TRANSCODER_USE_NEON)
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8((const uint8_t*)(src + i));
+        uint8x8_t folded = vorr_u8(vget_low_u8(v), vget_high_u8(v));
+        if (vget_lane_u64(vreinterpret_u64_u8(folded), 0) & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+#else
+    for (; i + 8 <= len; i += 8) {
+        uint64_t v;
+        memcpy(&v, src + i, 8);
+        if (v & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+#endif
+    return i;
+}
+
+template <const uint16_t invalidBits>
+static ALWAYS_INLINE size_t prefixOfBlocksWithoutBits(const char16_t* src, size_t len)
+{
+    size_t i = 0;
+#if defined(TRANSCODER_USE_SSE2)
+    const __m128i maskBits = _mm_set1_epi16((short)invalidBits);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= len; i += 8) {
+        __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + i)), maskBits);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(v, zero)) != 0xFFFF) {
+            break;
+        }
+    }
+#elif defined(TRANSCODER_USE_NEON)
+    const uint16x8_t maskBits = vdupq_n_u16(invalidBits);
+    for (; i + 8 <= len; i += 8) {
+        uint16x8_t v = vandq_u16(vld1q_u16((const uint16_t*)(src + i)), maskBits);
+        uint16x4_t folded = vorr_u16(vget_low_u16(v), vget_high_u16(v));
+        if (vget_lane_u64(vreinterpret_u64_u16(folded), 0)) {
+            break;
+        }
+    }
+#else
+    const uint64_t maskBits = invalidBits * 0x0001000100010001ULL;
+    for (; i + 4 <= len; i += 4) {
+        uint64_t v;
+        memcpy(&v, src + i, 8);
+        if (v & maskBits) {
+            break;
+        }
+    }
+#endif
+    return i;
+}
+
+static ALWAYS_INLINE void widenBlock16(const LChar* src, char16_t* dst)
+{
+#if defined(TRANSCODER_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_loadu_si128((const __m128i*)src);
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi8(v, zero));
+    _mm_storeu_si128((__m128i*)(dst + 8), _mm_unpackhi_epi8(v, zero));
+#elif defined(TRANSCODER_USE_NEON)
+    uint8x16_t v = vld1q_u8(src);
+    vst1q_u16((uint16_t*)dst, vmovl_u8(vget_low_u8(v)));
+    vst1q_u16((uint16_t*)(dst + 8), vmovl_u8(vget_high_u8(v)));
+#else
+    for (size_t i = 0; i < 16; i++) {
+        dst[i] = src[i];
+    }
+#endif
+}
+
+static ALWAYS_INLINE void narrowBlock16(const char16_t* src, LChar* dst)
+{
+#if defined(TRANSCODER_USE_SSE2)
+    __m128i lo = _mm_loadu_si128((const __m128i*)src);
+    __m128i hi = _mm_loadu_si128((const __m128i*)(src + 8));
+    _mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(lo, hi));
+#elif defined(TRANSCODER_USE_NEON)
+    uint8x8_t lo = vmovn_u16(vld1q_u16((const uint16_t*)src));
+    uint8x8_t hi = vmovn_u16(vld1q_u16((const uint16_t*)(src + 8)));
+    vst1q_u8(dst, vcombine_u8(lo, hi));
+#else
+    for (size_t i = 0; i < 16; i++) {
+        dst[i] = (LChar)src[i];
+    }
+#endif
+}
+
+static ALWAYS_INLINE bool isBlock16ASCII(const uint8_t* src)
+{
+#if defined(TRANSCODER_USE_SSE2)
+    return !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)src));
+#else
+    uint64_t a, b;
+    memcpy(&a, src, 8);
+    memcpy(&b, src + 8, 8);
+    return !((a | b) & 0x8080808080808080ULL);
+#endif
+}
+
+size_t Transcoder::findFirstNonASCII(const char* src, size_t len)
+{
+    size_t i = 0;
+#if defined(TRANSCODER_USE_AVX2)
+    if (len >= 64 && hasAVX2()) {
+        bool found;
+        i = findFirstNonASCIIAVX2(src, len, found);
+        if (found) {
+            return i;
+        }
+    }
+#endif
+    i += asciiPrefixOfBlocks(src + i, len - i);
+    for (; i < len; i++) {
+        if (src[i] & 0x80) {
+            break;
+        }
+    }
+    return i;
+}
+
+size_t Transcoder::findFirstNonASCII(const char16_t* src, size_t len)
+{
+    size_t i = prefixOfBlocksWithoutBits<0xFF80>(src, len);
+    for (; i < len; i++) {
+        if (src[i] >= 0x80) {
+            break;
+        }
+    }
+    return i;
+}
+
+size_t Transcoder::findFirstNonLatin1(const char16_t* src, size_t len)
+{
+    size_t i = prefixOfBlocksWithoutBits<0xFF00>(src, len);
+    for (; i < len; i++) {
+        if (src[i] >= 0x100) {
+            break;
+        }
+    }
+    return i;
+}
+
+void Transcoder::widenLatin1ToUTF16(const LChar* src, size_t len, char16_t* dst)
+{
+    size_t i = 0;
+#if defined(TRANSCODER_USE_AVX2)
+    if (len >= 64 && hasAVX2()) {
+        i = widenLatin1ToUTF16AVX2(src, len, dst);
+    }
+#endif
+    for (; i + 16 <= len; i += 16) {
+        widenBlock16(src + i, dst + i);
+    }
+    for (; i < len; i++) {
+        dst[i] = src[i];
+    }
+}
+
+void Transcoder::narrowUTF16ToLatin1(const char16_t* src, size_t len, LChar* dst)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        narrowBlock16(src + i, dst + i);
+    }
+    for (; i < len; i++) {
+        ASSERT(src[i] < 0x100);
+        dst[i] = (LChar)src[i];
+    }
+}
+
+static ALWAYS_INLINE bool isUTF8Continuation(uint8_t ch)
+{
+    return (ch & 0xC0) == 0x80;
+}
+
+// decode one code point starting at a non-ASCII byte.
+// return U+FFFD and consume one byte for every kind of error, like utf8StringToUTF16String did
+static ALWAYS_INLINE char32_t readNonASCIISequence(const uint8_t*& src, const uint8_t* end)
+{
+    const uint8_t ch = *src;
+    const size_t remain = end - src;
+    ASSERT(ch >= 0x80);
+
+    if ((ch & 0xE0) == 0xC0) {
+        if (remain >= 2 && isUTF8Continuation(src[1])) {
+            char32_t result = ((ch & 0x1F) << 6) | (src[1] & 0x3F);
+            src += 2;
+            return result;
+        }
+    } else if ((ch & 0xF0) == 0xE0) {
+        if (remain >= 3 && isUTF8Continuation(src[1]) && isUTF8Continuation(src[2])) {
+            char32_t result = ((ch & 0x0F) << 12) | ((src[1] & 0x3F) << 6) | (src[2] & 0x3F);
+            if ((result & 0xFFFFF800) != 0xD800) {
+                src += 3;
+                return result;
+            }
+        }
+    } else if ((ch & 0xF8) == 0xF0) {
+        if (remain >= 4 && isUTF8Continuation(src[1]) && isUTF8Continuation(src[2]) && isUTF8Continuation(src[3])) {
+            char32_t result = ((ch & 0x07) << 18) | ((src[1] & 0x3F) << 12) | ((src[2] & 0x3F) << 6) | (src[3] & 0x3F);
+            if (result <= 0x10FFFF && (result & 0xFFFFF800) != 0xD800) {
+                src += 4;
+                return result;
+            }
+        }
+    }
+
+    src++;
+    return 0xFFFD;
+}
+
+bool Transcoder::isValidUTF8(const char* src, size_t len)
+{
+    const uint8_t* p = (const uint8_t*)src;
+    const uint8_t* end = p + len;
+    while (p < end) {
+        if (*p < 0x80) {
+            p += findFirstNonASCII((const char*)p, end - p);
+            continue;
+        }
+        const uint8_t* start = p;
+        char32_t ch = readNonASCIISequence(p, end);
+        size_t consumed = p - start;
+        if (consumed == 1) {
+            return false;
+        }
+        // reject overlong forms which readNonASCIISequence accepts for compatibility
+        if ((consumed == 2 && ch < 0x80) || (consumed == 3 && ch < 0x800) || (consumed == 4 && ch < 0x10000)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t Transcoder::utf16LengthOfUTF8(const char* src, size_t len, bool& isLatin1)
+{
+    const uint8_t* p = (const uint8_t*)src;
+    const uint8_t* end = p + len;
+    size_t result = 0;
+    isLatin1 = true;
+    while (p < end) {
+        if (*p < 0x80) {
+            size_t run = findFirstNonASCII((const char*)p, end - p);
+            p += run;
+            result += run;
+            continue;
+        }
+        char32_t ch = readNonASCIISequence(p, end);
+        if (ch > 0xFF) {
+            isLatin1 = false;
+        }
+        result += (ch > 0xFFFF) ? 2 : 1;
+    }
+    return result;
+}
+
+size_t Transcoder::decodeUTF8(const char* src, size_t len, char16_t* dst)
+{
+    const uint8_t* p = (const uint8_t*)src;
+    const uint8_t* end = p + len;
+    char16_t* out = dst;
+    while (p < end) {
+        if (*p < 0x80) {
+            while (end - p >= 16 && isBlock16ASCII(p)) {
+                widenBlock16(p, out);
+                p += 16;
+                out += 16;
+            }
+            if (p < end && *p < 0x80) {
+                *out++ = *p++;
+            }
+            continue;
+        }
+        char32_t ch = readNonASCIISequence(p, end);
+        if (ch > 0xFFFF) {
+            *out++ = (char16_t)((ch >> 10) + 0xD7C0);
+            *out++ = (char16_t)((ch & 0x3FF) | 0xDC00);
+        } else {
+            *out++ = (char16_t)ch;
+        }
+    }
+    return out - dst;
+}
+
+size_t Transcoder::decodeUTF8(const char* src, size_t len, LChar* dst)
+{
+    const uint8_t* p = (const uint8_t*)src;
+    const uint8_t* end = p + len;
+    LChar* out = dst;
+    while (p < end) {
+        if (*p < 0x80) {
+            size_t run = findFirstNonASCII((const char*)p, end - p);
+            memcpy(out, p, run);
+            p += run;
+            out += run;
+            continue;
+        }
+        char32_t ch = readNonASCIISequence(p, end);
+        ASSERT(ch <= 0xFF);
+        *out++ = (LChar)ch;
+    }
+    return out - dst;
+}
+
+size_t Transcoder::utf8LengthOfLatin1(const LChar* src, size_t len)
+{
+    size_t result = len;
+    size_t i = 0;
+    while (i < len) {
+        i += findFirstNonASCII((const char*)src + i, len - i);
+        if (i < len) {
+            result++;
+            i++;
+        }
+    }
+    return result;
+}
+
+size_t Transcoder::utf8LengthOfUTF16(const char16_t* src, size_t len)
+{
+    size_t result = 0;
+    size_t i = 0;
+    while (i < len) {
+        size_t run = prefixOfBlocksWithoutBits<0xFF80>(src + i, len - i);
+        result += run;
+        i += run;
+        if (i == len) {
+            break;
+        }
+        char16_t ch = src[i++];
+        if (ch < 0x80) {
+            result += 1;
+        } else if (ch < 0x800) {
+            result += 2;
+        } else if (U16_IS_LEAD(ch) && i < len && U16_IS_TRAIL(src[i])) {
+            result += 4;
+            i++;
+        } else {
+            // BMP character or unpaired surrogate (written as itself or as U+FFFD)
+            result += 3;
+        }
+    }
+    return result;
+}
+
+size_t Transcoder::encodeLatin1ToUTF8(const LChar* src, size_t len, char* dst)
+{
+    char* out = dst;
+    size_t i = 0;
+    while (i < len) {
+        size_t run = findFirstNonASCII((const char*)src + i, len - i);
+        memcpy(out, src + i, run);
+        out += run;
+        i += run;
+        if (i < len) {
+            LChar ch = src[i++];
+            *out++ = (char)(0xC0 | (ch >> 6));
+            *out++ = (char)(0x80 | (ch & 0x3F));
+        }
+    }
+    return out - dst;
+}
+
+size_t Transcoder::encodeUTF16ToUTF8(const char16_t* src, size_t len, char* dst, bool replaceInvalid)
+{
+    char* out = dst;
+    size_t i = 0;
+    while (i < len) {
+        size_t run = prefixOfBlocksWithoutBits<0xFF80>(src + i, len - i);
+        size_t runEnd = i + run;
+        for (; i + 16 <= runEnd; i += 16) {
+            narrowBlock16(src + i, (LChar*)out);
+            out += 16;
+        }
+        for (; i < runEnd; i++) {
+            *out++ = (char)src[i];
+        }
+        if (i == len) {
+            break;
+        }
+
+        char32_t ch = src[i++];
+        if (ch < 0x80) {
+            *out++ = (char)ch;
+            continue;
+        } else if (ch < 0x800) {
+            *out++ = (char)(0xC0 | (ch >> 6));
+            *out++ = (char)(0x80 | (ch & 0x3F));
+            continue;
+        }
+
+        if (U16_IS_LEAD(ch) && i < len && U16_IS_TRAIL(src[i])) {
+            ch = U16_GET_SUPPLEMENTARY(ch, src[i]);
+            i++;
+            *out++ = (char)(0xF0 | (ch >> 18));
+            *out++ = (char)(0x80 | ((ch >> 12) & 0x3F));
+            *out++ = (char)(0x80 | ((ch >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (ch & 0x3F));
+            continue;
+        }
+
+        if (replaceInvalid && (ch & 0xFFFFF800) == 0xD800) {
+            ch = 0xFFFD;
+        }
+        *out++ = (char)(0xE0 | (ch >> 12));
+        *out++ = (char)(0x80 | ((ch >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (ch & 0x3F));
+    }
+    return out - dst;
+}
+} // namespace Escargot
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotTranscoder__
+#define __EscargotTranscoder__
+
+namespace Escargot {
+
+/*
+ * Bulk Latin-1 / UTF-16 / UTF-8 conversion kernels.
+ * Every function works on caller-owned raw buffers, so the same code serves String subclasses,
+ * JSON and the public API. Vector paths are SSE2 (+ AVX2 selected at runtime) on x86 and NEON on ARM.
+ * The scalar fallback produces exactly the same result.
+ *
+ * UTF-8 decoding keeps the rules of readUTF8Sequence: every invalid byte, encoded surrogate
+ * or out-of-range code point becomes one U+FFFD per byte.
+ */
+class Transcoder {
+public:
+    // return the index of the first unit out of range, or len if there is none
+    static size_t findFirstNonASCII(const char* src, size_t len);
+    static size_t findFirstNonASCII(const char16_t* src, size_t len);
+    static size_t findFirstNonLatin1(const char16_t* src, size_t len);
+
+    static bool isASCII(const char* src, size_t len)
+    {
+        return findFirstNonASCII(src, len) == len;
+    }
+
+    static bool isASCII(const char16_t* src, size_t len)
+    {
+        return findFirstNonASCII(src, len) == len;
+    }
+
+    static bool isLatin1(const char16_t* src, size_t len)
+    {
+        return findFirstNonLatin1(src, len) == len;
+    }
+
+    static bool isValidUTF8(const char* src, size_t len);
+
+    static void widenLatin1ToUTF16(const LChar* src, size_t len, char16_t* dst);
+    // every unit of src should be in Latin-1 range
+    static void narrowUTF16ToLatin1(const char16_t* src, size_t len, LChar* dst);
+
+    // number of UTF-16 units decodeUTF8 produces. isLatin1 is set when every decoded unit fits in 8 bits
+    static size_t utf16LengthOfUTF8(const char* src, size_t len, bool& isLatin1);
+    // dst should have room for utf16LengthOfUTF8(src, len) units. return the number of written units
+    static size_t decodeUTF8(const char* src, size_t len, char16_t* dst);
+    static size_t decodeUTF8(const char* src, size_t len, LChar* dst);
+
+    static size_t utf8LengthOfLatin1(const LChar* src, size_t len);
+    static size_t utf8LengthOfUTF16(const char16_t* src, size_t len);
+    // dst should have room for utf8LengthOf*(src, len) bytes. return the number of written bytes
+    static size_t encodeLatin1ToUTF8(const LChar* src, size_t len, char* dst);
+    // unpaired surrogates are written as they are(WTF-8) or replaced with U+FFFD
+    static size_t encodeUTF16ToUTF8(const char16_t* src, size_t len, char* dst, bool replaceInvalid = false);
+};
+} // namespace Escargot
+
+#endif
@@ -371,6 +371,16 @@ public:
         m_capacity = 0;
     }
 
+    // drops every element but keeps the buffer, so a vector refilled over and over allocates only once.
+    // the slots are reset, so a GC allocated buffer does not keep what the dropped elements pointed to alive
+    void clearWithoutDeallocation()
+    {
+        for (size_t i = 0; i < m_size; i++) {
+            m_buffer[i] = T();
+        }
+        m_size = 0;
+    }
+
     void shrinkToFit()
     {
         if (m_size != m_capacity) {
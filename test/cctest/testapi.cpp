@@ -523,3 +523,739 @@ TEST(FunctionTemplate, Basic2) {
     }, ftchild);
 }
 
+
+TEST(StringRef, UTF8RoundTrip) {
+    // ASCII run long enough for the vector paths, then Latin-1, BMP and supplementary characters
+    std::string src(100, 'a');
+    src += "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    src += std::string(40, 'b');
+
+    StringRef* str = StringRef::createFromUTF8(src.data(), src.length());
+    EXPECT_EQ(str->length(), 100u + 1 + 1 + 2 + 40);
+    EXPECT_EQ(str->charAt(99), u'a');
+    EXPECT_EQ(str->charAt(100), u'é');
+    EXPECT_EQ(str->charAt(101), u'€');
+    EXPECT_EQ(str->charAt(102), 0xD83D);
+    EXPECT_EQ(str->charAt(103), 0xDE00);
+    EXPECT_EQ(str->toStdUTF8String(), src);
+
+    // invalid bytes are replaced one by one
+    str = StringRef::createFromUTF8("a\xFF\xC3", 3);
+    EXPECT_EQ(str->length(), 3u);
+    EXPECT_EQ(str->charAt(1), 0xFFFD);
+    EXPECT_EQ(str->charAt(2), 0xFFFD);
+}
+
+TEST(StringRef, ExternalUTF8) {
+    static const char src[] = "caf\xC3\xA9 \xE2\x82\xAC";
+    StringRef* str = StringRef::createExternalFromUTF8(src, sizeof(src) - 1);
+    EXPECT_EQ(str->length(), 6u);
+    // UTF-8 output comes from the source without decoding
+    EXPECT_EQ(str->toStdUTF8String(), std::string(src));
+    EXPECT_EQ(str->charAt(3), u'\u00e9');
+    EXPECT_EQ(str->charAt(5), u'\u20ac');
+    EXPECT_TRUE(str->equals(StringRef::createFromUTF8(src, sizeof(src) - 1)));
+
+    // script sources can stay on external memory too
+    static const char script[] = "'caf\xC3\xA9'.length";
+    auto result = evalScript(g_context.get(), StringRef::createExternalFromUTF8(script, sizeof(script) - 1), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(result, "4");
+}
+
+TEST(EvalScript, LazyCompileSkipsInnerFunctions) {
+    // inner functions of a lazily compiled function are jumped over with the bounds of the first parsing
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("function outer(k) {\n"
+                                                                    "  var add = (a, b = () => 1) => a + b();\n"
+                                                                    "  var mul = async x => x;\n"
+                                                                    "  function inner(v) { return (w => w * k)(v) }\n"
+                                                                    "  var obj = { m(v) { return v }, get g() { return 2 } };\n"
+                                                                    "  return add(inner(2), () => obj.g) + obj.m(k);\n"
+                                                                    "}\n"
+                                                                    "outer(3)"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "11");
+}
+
+struct ByteChunkReader {
+    const char* source;
+    size_t remain;
+
+    // one byte per chunk, so every multi-byte character is split between chunks
+    static size_t read(const char** chunk, void* data)
+    {
+        ByteChunkReader* reader = (ByteChunkReader*)data;
+        if (!reader->remain) {
+            return 0;
+        }
+        *chunk = reader->source++;
+        reader->remain--;
+        return 1;
+    }
+};
+
+TEST(ScriptParserRef, InitializeScriptFromStream) {
+    static const char source[] = "var s = 'caf\xC3\xA9 \xF0\x9F\x98\x80'; s.length + ',' + s.charCodeAt(3) + ',' + s.codePointAt(5)";
+    ByteChunkReader reader = { source, sizeof(source) - 1 };
+    auto result = g_context->scriptParser()->initializeScriptFromStream(ByteChunkReader::read, &reader, StringRef::createFromASCII("stream.js"));
+    ASSERT_TRUE(result.isSuccessful());
+    EXPECT_EQ(result.script.value()->sourceCode()->length(), sizeof(source) - 1 - 1 - 2);
+
+    Evaluator::EvaluatorResult r = Evaluator::execute(g_context.get(), [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* {
+        return script->execute(state);
+    },
+                                                      result.script.value());
+    EXPECT_EQ(r.resultOrErrorToString(g_context.get())->toStdUTF8String(), "7,233,128512");
+}
+
+TEST(ScriptParserRef, InitializeScriptFromStreamCompressible) {
+    if (!StringRef::isCompressibleStringEnabled()) {
+        return;
+    }
+
+    VMInstanceRef* instance = g_context->vmInstance();
+    auto oldPolicy = instance->compressibleStringPolicy();
+    auto policy = oldPolicy;
+    policy.checkInterval = 0;
+    policy.coldTime = 0;
+    policy.minByteSize = 1024;
+    instance->setCompressibleStringPolicy(policy);
+
+    // a streamed source is compressible like a source read at once, so the shell can stream every file
+    std::string source = "function streamedSourceLate() { return 'late'; }\n/*" + std::string(64 * 1024, 'x') + "*/\n";
+    ByteChunkReader reader = { source.data(), source.length() };
+    auto before = instance->compressibleStringStatistics();
+    auto result = g_context->scriptParser()->initializeScriptFromStream(ByteChunkReader::read, &reader, StringRef::createFromASCII("stream.js"), false, source.length());
+    ASSERT_TRUE(result.isSuccessful());
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* {
+        return script->execute(state);
+    },
+                       result.script.value());
+    Memory::gc();
+
+    EXPECT_GT(instance->compressibleStringStatistics().compressionCount, before.compressionCount);
+    EXPECT_EQ(evalScript(g_context.get(), StringRef::createFromASCII("streamedSourceLate()"), StringRef::createFromASCII("test.js"), false), "late");
+    EXPECT_EQ(result.script.value()->sourceCode()->length(), source.length());
+
+    instance->setCompressibleStringPolicy(oldPolicy);
+}
+
+TEST(ArrayObjectRef, BulkCopy) {
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        double numbers[] = { 1.5, -2, 3 };
+        ArrayObjectRef* arr = ArrayObjectRef::create(state, numbers, 3);
+        EXPECT_TRUE(arr->get(state, ValueRef::create(0))->equalsTo(state, ValueRef::create(1.5)));
+
+        int32_t ints[] = { 7, 8 };
+        arr->copyFrom(state, ints, 2, 2);
+        EXPECT_TRUE(arr->get(state, StringRef::createFromASCII("length"))->equalsTo(state, ValueRef::create(4)));
+
+        double out[4];
+        arr->copyTo(state, out, 0, 4);
+        EXPECT_EQ(out[0], 1.5);
+        EXPECT_EQ(out[1], -2);
+        EXPECT_EQ(out[2], 7);
+        EXPECT_EQ(out[3], 8);
+
+        int32_t outInts[2];
+        arr->copyTo(state, outInts, 0, 2);
+        EXPECT_EQ(outInts[0], 1);
+        EXPECT_EQ(outInts[1], -2);
+        return ValueRef::createUndefined();
+    });
+}
+
+TEST(ArrayObjectRef, BulkCopyOutOfIndexRange) {
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        double numbers[] = { 1, 2 };
+        // the last element lands past the largest array index, so it becomes a plain property
+        ArrayObjectRef* arr = ArrayObjectRef::create(state, numbers, 2);
+        arr->copyFrom(state, numbers, 4294967294u, 2);
+        EXPECT_TRUE(arr->get(state, ValueRef::create(4294967294u))->equalsTo(state, ValueRef::create(1)));
+        EXPECT_TRUE(arr->get(state, StringRef::createFromASCII("4294967295"))->equalsTo(state, ValueRef::create(2)));
+        EXPECT_TRUE(arr->get(state, StringRef::createFromASCII("length"))->equalsTo(state, ValueRef::create(4294967295u)));
+        return ValueRef::createUndefined();
+    });
+
+    auto r = Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        double numbers[] = { 1, 2 };
+        ArrayObjectRef* arr = ArrayObjectRef::create(state, numbers, 2);
+        // start + length wraps around
+        arr->copyFrom(state, numbers, SIZE_MAX, 2);
+        return arr->get(state, ValueRef::create(0));
+    });
+    EXPECT_FALSE(r.isSuccessful());
+}
+
+static size_t s_releasedByteLength;
+
+TEST(ArrayBufferObjectRef, External) {
+    static double data[4] = { 1, 2, 3, 4 };
+    s_releasedByteLength = 0;
+
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        ArrayBufferObjectRef* buffer = ArrayBufferObjectRef::createExternal(state, data, sizeof(data), [](void* buffer, size_t byteLength, void* callbackData) {
+            s_releasedByteLength = byteLength;
+        },
+                                                                            nullptr);
+        Float64ArrayObjectRef* arr = Float64ArrayObjectRef::create(state, buffer, sizeof(double), 2);
+        EXPECT_EQ(arr->arrayLength(), 2u);
+        EXPECT_EQ((double*)arr->rawBuffer(), data + 1);
+        EXPECT_TRUE(arr->get(state, ValueRef::create(1))->equalsTo(state, ValueRef::create(3)));
+
+        buffer->detachArrayBuffer(state);
+        EXPECT_EQ(s_releasedByteLength, sizeof(data));
+        EXPECT_TRUE(arr->isDetachedBuffer());
+        EXPECT_EQ(arr->rawBuffer(), nullptr);
+        EXPECT_EQ(arr->byteLength(), 0u);
+        return ValueRef::createUndefined();
+    });
+}
+
+TEST(VMInstanceRef, RegExpCacheStatistics) {
+    VMInstanceRef* instance = g_context->vmInstance();
+    auto before = instance->regexpCacheStatistics();
+
+    // a source built at runtime is a different String each time, so only a content-keyed cache finds it again
+    evalScript(g_context.get(), StringRef::createFromASCII("for (var i = 0; i < 3; i++) new RegExp('cache' + 'Stat' + 'istics[0-9]+')"), StringRef::createFromASCII("test.js"), false);
+    auto after = instance->regexpCacheStatistics();
+    EXPECT_EQ(after.missCount, before.missCount + 1);
+    EXPECT_GE(after.hitCount, before.hitCount + 2);
+    EXPECT_GT(after.byteSize, 0u);
+
+    // sticky changes the compiled pattern, so it gets its own entry
+    evalScript(g_context.get(), StringRef::createFromASCII("new RegExp('cache' + 'Stat' + 'istics[0-9]+', 'y')"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(instance->regexpCacheStatistics().missCount, after.missCount + 1);
+}
+
+TEST(VMInstanceRef, StringViewStatistics) {
+    VMInstanceRef* instance = g_context->vmInstance();
+    auto before = instance->stringViewStatistics();
+
+    evalScript(g_context.get(), StringRef::createFromASCII("var body = 'a'.repeat(100000) + 'b'.repeat(100000); var kept = [body.slice(99990, 100040), body.substring(5, 100)]; body = null;"), StringRef::createFromASCII("test.js"), false);
+    for (int i = 0; i < 3; i++) {
+        Memory::gc();
+    }
+
+    // the slices read the same whether or not they were copied out of body
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("kept[0] === 'a'.repeat(10) + 'b'.repeat(40) && kept[1] === 'a'.repeat(95) && kept.join().length === 146"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+
+    auto after = instance->stringViewStatistics();
+    EXPECT_GE(after.detachedViewCount, before.detachedViewCount);
+    if (after.detachedViewCount > before.detachedViewCount) {
+        EXPECT_GE(after.reclaimedBytes - before.reclaimedBytes, 200000u);
+        EXPECT_GT(after.copiedBytes, before.copiedBytes);
+    }
+}
+
+TEST(VMInstanceRef, CompressibleStringPolicy) {
+    if (!StringRef::isCompressibleStringEnabled()) {
+        return;
+    }
+
+    VMInstanceRef* instance = g_context->vmInstance();
+    auto oldPolicy = instance->compressibleStringPolicy();
+    auto policy = oldPolicy;
+    policy.checkInterval = 0;
+    policy.coldTime = 0;
+    policy.minByteSize = 1024;
+    instance->setCompressibleStringPolicy(policy);
+    EXPECT_EQ(instance->compressibleStringPolicy().minByteSize, 1024u);
+
+    auto before = instance->compressibleStringStatistics();
+    std::string source(64 * 1024, 'c');
+    StringRef* strings[4];
+    for (size_t i = 0; i < 4; i++) {
+        strings[i] = StringRef::createFromASCIIToCompressibleString(g_context.get(), source.data(), source.length());
+    }
+    Memory::gc();
+
+    // several cold strings are compressed in one pass
+    auto compressed = instance->compressibleStringStatistics();
+    EXPECT_GT(compressed.compressionCount, before.compressionCount + 1);
+    EXPECT_LT(compressed.compressedSize - before.compressedSize, compressed.compressedBytes - before.compressedBytes);
+
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(strings[i]->toStdUTF8String(), source);
+    }
+    EXPECT_GT(instance->compressibleStringStatistics().decompressionCount, before.decompressionCount);
+
+    instance->setCompressibleStringPolicy(oldPolicy);
+}
+
+TEST(VMInstanceRef, CompressedScriptSource) {
+    if (!StringRef::isCompressibleStringEnabled()) {
+        return;
+    }
+
+    VMInstanceRef* instance = g_context->vmInstance();
+    auto oldPolicy = instance->compressibleStringPolicy();
+    auto policy = oldPolicy;
+    policy.checkInterval = 0;
+    policy.coldTime = 0;
+    policy.minByteSize = 1024;
+    instance->setCompressibleStringPolicy(policy);
+
+    std::string source = "function compressedSourceEarly() { return 'early'; }\n/*" + std::string(1024 * 1024, 'x') + "*/\nfunction compressedSourceLate() { return 'late'; }\n";
+    StringRef* sourceString = StringRef::createFromASCIIToCompressibleString(g_context.get(), source.data(), source.length());
+    auto before = instance->compressibleStringStatistics();
+    evalScript(g_context.get(), sourceString, StringRef::createFromASCII("compressed.js"), false);
+    for (int i = 0; i < 3; i++) {
+        Memory::gc();
+    }
+
+    auto compressed = instance->compressibleStringStatistics();
+    EXPECT_EQ(evalScript(g_context.get(), StringRef::createFromASCII("compressedSourceLate() + compressedSourceEarly()"), StringRef::createFromASCII("test.js"), false), "lateearly");
+    if (compressed.compressionCount > before.compressionCount) {
+        // only the chunks of the two functions were decompressed to compile them
+        auto after = instance->compressibleStringStatistics();
+        EXPECT_GT(after.decompressedBytes, compressed.decompressedBytes);
+        EXPECT_LT(after.decompressedBytes - compressed.decompressedBytes, source.length() / 4);
+    }
+    EXPECT_EQ(sourceString->length(), source.length());
+
+    instance->setCompressibleStringPolicy(oldPolicy);
+}
+
+TEST(VMInstanceRef, MaxStackTraceDepth) {
+    VMInstanceRef* instance = g_context->vmInstance();
+    size_t oldDepth = instance->maxStackTraceDepth();
+    instance->setMaxStackTraceDepth(3);
+
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("function f(n) { if (n == 0) throw new Error('deep'); f(n - 1); } try { f(20) } catch (e) { e.stack.split('at test.js').length - 1 }"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "3");
+
+    instance->setMaxStackTraceDepth(oldDepth);
+}
+
+TEST(VMInstanceRef, StackTraceLocation) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var a = 1;\r\nfunction f() {\n    throw new Error('x');\n}\ntry { f(); } catch (e) { e.stack.match(/test.js:\\d+:\\d+/g).join() }"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "test.js:3:5,test.js:5:7");
+}
+
+TEST(VMInstanceRef, StackTraceOfRethrownException) {
+    // try-finally rethrows the caught exception with the frames it had
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("function f() {\n throw new Error('x');\n}\nfunction g() {\n try { f(); } finally { }\n}\ntry { g(); } catch (e) { e.stack.match(/test.js:\\d+:\\d+/g).join() }"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "test.js:2:2,test.js:5:8,test.js:7:7");
+
+    // a shallow throw after a deep one has only its own frames
+    s = evalScript(g_context.get(), StringRef::createFromASCII("function d(n) { if (n) { return d(n - 1); } throw new Error('d'); } try { d(30); } catch (e) { } try { d(0); } catch (e) { e.stack.split('at test.js').length - 1 }"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "2");
+}
+
+TEST(VMInstanceRef, WriteHeapSnapshot) {
+    evalScript(g_context.get(), StringRef::createFromASCII("function HeapSnapshotTestClass() { this.payload = ['heap snapshot payload']; }"
+                                                           "var heapSnapshotTestObject = new HeapSnapshotTestClass();"
+                                                           "var heapSnapshotTestClosure = (function() { var heapSnapshotCaptured = {}; return function() { return heapSnapshotCaptured; } })();"),
+               StringRef::createFromASCII("test.js"), false);
+
+    std::string snapshot;
+    g_context->vmInstance()->writeHeapSnapshot([](const char* data, size_t length, void* callbackData) {
+        ((std::string*)callbackData)->append(data, length);
+    },
+                                               &snapshot);
+
+    EXPECT_NE(snapshot.find("\"HeapSnapshotTestClass\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"heap snapshot payload\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"heapSnapshotCaptured\""), std::string::npos);
+
+    // every edge should point to the start of a node
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state, std::string* snapshot) -> ValueRef* {
+        state->context()->globalObject()->set(state, StringRef::createFromASCII("heapSnapshotText"), StringRef::createFromUTF8(snapshot->data(), snapshot->length()));
+        return ValueRef::createUndefined();
+    },
+                       &snapshot);
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var h = JSON.parse(heapSnapshotText); var fields = h.snapshot.meta.node_fields.length;"
+                                                                    "var ok = h.nodes.length == h.snapshot.node_count * fields && h.edges.length == h.snapshot.edge_count * 3;"
+                                                                    "for (var i = 2; i < h.edges.length; i += 3) { ok = ok && h.edges[i] % fields == 0 && h.edges[i] < h.nodes.length }"
+                                                                    "heapSnapshotText = undefined; ok"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+}
+
+TEST(VMInstanceRef, WriteHeapSnapshotWithNativeAccessor) {
+    // the slot of a native data accessor holds the embedder data instead of a value
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        ObjectRef* obj = ObjectRef::create(state);
+        ObjectRef::NativeDataAccessorPropertyData* data = new ObjectRef::NativeDataAccessorPropertyData(false, true, true, [](ExecutionStateRef* state, ObjectRef* self, ObjectRef::NativeDataAccessorPropertyData* data) -> ValueRef* {
+            return ValueRef::create(42);
+        },
+                                                                                                         nullptr);
+        EXPECT_TRUE(obj->defineNativeDataAccessorProperty(state, StringRef::createFromASCII("heapSnapshotNativeAccessor"), data));
+        state->context()->globalObject()->set(state, StringRef::createFromASCII("heapSnapshotNativeAccessorObject"), obj);
+        return ValueRef::createUndefined();
+    });
+
+    std::string snapshot;
+    g_context->vmInstance()->writeHeapSnapshot([](const char* data, size_t length, void* callbackData) {
+        ((std::string*)callbackData)->append(data, length);
+    },
+                                               &snapshot);
+    EXPECT_NE(snapshot.find("\"heapSnapshotNativeAccessorObject\""), std::string::npos);
+
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("heapSnapshotNativeAccessorObject.heapSnapshotNativeAccessor"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "42");
+    evalScript(g_context.get(), StringRef::createFromASCII("heapSnapshotNativeAccessorObject = undefined"), StringRef::createFromASCII("test.js"), false);
+}
+
+TEST(VMInstanceRef, WriteHeapSnapshotInternalSlots) {
+    // every string below is reachable only through an internal slot, a suspended frame or a byte code literal.
+    // the literal has an escape so it is not a view of the source
+    evalScript(g_context.get(), StringRef::createFromASCII("var heapSnapshotPending = new Promise(function() {});"
+                                                           "var heapSnapshotSlots = {"
+                                                           "  map: new Map([[{}, ['map', 'value'].join(' ')]]),"
+                                                           "  weakMapKey: {},"
+                                                           "  set: new Set([['set', 'value'].join(' ')]),"
+                                                           "  bound: function() {}.bind(null, ['bound', 'argument'].join(' ')),"
+                                                           "  view: new Uint8Array(new ArrayBuffer(8)),"
+                                                           "  generator: (function*() { var s = ['generator', 'register'].join(' '); yield 1; yield s; })(),"
+                                                           "  literal: function() { return 'heap snapshot byte code literal\\x21'; },"
+                                                           "};"
+                                                           "heapSnapshotSlots.weakMap = new WeakMap([[heapSnapshotSlots.weakMapKey, ['weak map', 'value'].join(' ')]]);"
+                                                           "heapSnapshotSlots.generator.next();"
+                                                           "heapSnapshotSlots.literal();"
+                                                           "(function() { var s = ['promise', 'reaction'].join(' '); heapSnapshotPending.then(function() { return s; }); })();"
+                                                           "(async function() { var s = ['async', 'register'].join(' '); await heapSnapshotPending; return s; })();"),
+               StringRef::createFromASCII("test.js"), false);
+
+    std::string snapshot;
+    g_context->vmInstance()->writeHeapSnapshot([](const char* data, size_t length, void* callbackData) {
+        ((std::string*)callbackData)->append(data, length);
+    },
+                                               &snapshot);
+
+    EXPECT_NE(snapshot.find("\"map value\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"weak map value\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"set value\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"bound argument\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"bound_function\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"ArrayBuffer\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"generator register\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"heap snapshot byte code literal!\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"promise reaction\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"async register\""), std::string::npos);
+
+    evalScript(g_context.get(), StringRef::createFromASCII("heapSnapshotSlots = undefined; heapSnapshotPending = undefined"), StringRef::createFromASCII("test.js"), false);
+}
+
+TEST(EvalScript, RegExpPrefilterKeepsMatches) {
+    // [pattern, input, index of the first match or -1]. the start positions skipped by the prefilter must never hold a match
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var cases = ["
+                                                                    "[/HELLO/i, 'say hello', 4], [/[a-c]x/i, '..BX', 2], [/\\u00e9t\\u00e9/i, 'l\\u00c9T\\u00c9', 1], [/k/iu, 'a\\u212A', 1], [/s/iu, '\\u017F', 0],"
+                                                                    "[/\\u{1F600}/u, 'ab\\u{1F600}', 2], [/[\\u{1F600}-\\u{1F64F}]/u, 'x\\u{1F601}', 1], [/./u, '\\u{1F600}', 0], [/\\u3042/, 'ab\\u3042', 2], [/b/, '\\u3042b', 1],"
+                                                                    "[/abc|xyz|q/, '...xyz', 3], [/abc|xyz|q/, 'aaq', 2], [/(?:ab|cd)e/, 'abcde', 2], [/abcd/, 'abcabcd', 3], [/abcd/, 'abcab', -1],"
+                                                                    "[/a?b/, 'ccb', 2], [/x*y/, 'zzy', 2], [/(?:a|)b/, 'cb', 1], [/(a)?\\1b/, 'xb', 1], [/a*/, 'bbb', 0], [/(?:)/, 'b', 0],"
+                                                                    "[/(?=b)b/, 'aab', 2], [/\\bfoo/, 'afoo foo', 5], [/(?!a)b/, 'ab', 1], [/$/, 'ab', 2],"
+                                                                    "[/^b|c/, 'abc', 2], [/^b/, 'ab', -1], [/^b/m, 'a\\nb', 2], [/[^a]/, 'aab', 2], [/\\d+/, 'ab12', 2]"
+                                                                    "];"
+                                                                    "var failed = [];"
+                                                                    "for (var i = 0; i < cases.length; i++) { var m = cases[i][0].exec(cases[i][1]); if ((m ? m.index : -1) !== cases[i][2]) { failed.push(String(cases[i][0])); } }"
+                                                                    "var r = /b/g; r.lastIndex = 2; var m = r.exec('abab'); if (!m || m.index !== 3) { failed.push('lastIndex'); }"
+                                                                    "if ('aXbxc'.replace(/x/gi, '-') !== 'a-b-c' || 'a1b22c'.split(/\\d+/).join() !== 'a,b,c') { failed.push('global'); }"
+                                                                    "failed.join(' ')"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "");
+}
+
+TEST(EvalScript, RegExpLegacyStatics) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var failed = [];"
+                                                                    "function check(name, actual, expected) { if (actual !== expected) { failed.push(name + '=' + actual); } }"
+                                                                    "/(\\d+)-(\\d+)/.exec('tel 12-345 end');"
+                                                                    "check('exec$1', RegExp.$1, '12'); check('exec$2', RegExp.$2, '345'); check('exec$3', RegExp.$3, '');"
+                                                                    "check('execLastMatch', RegExp.lastMatch, '12-345'); check('exec$&', RegExp['$&'], '12-345'); check('execLastParen', RegExp.lastParen, '345');"
+                                                                    "check('execLeft', RegExp.leftContext, 'tel '); check('execRight', RegExp.rightContext, ' end'); check('exec$\\'', RegExp[\"$'\"], ' end');"
+                                                                    "check('execInput', RegExp.input, 'tel 12-345 end'); check('exec$_', RegExp.$_, 'tel 12-345 end');"
+                                                                    // a failed match leaves everything as it was
+                                                                    "check('fail', /zzz/.exec('nothing here'), null); check('fail', 'nothing'.replace(/zzz/g, '-'), 'nothing');"
+                                                                    "check('fail$1', RegExp.$1, '12'); check('failLastMatch', RegExp.lastMatch, '12-345'); check('failInput', RegExp.input, 'tel 12-345 end');"
+                                                                    "check('test', /o(.)/.test('foobar'), true); check('test$1', RegExp.$1, 'o'); check('test$2', RegExp.$2, '');"
+                                                                    "check('testLeft', RegExp.leftContext, 'f'); check('testRight', RegExp.rightContext, 'bar');"
+                                                                    // only the last match of a global replace is kept
+                                                                    "check('replace', 'x1y2z'.replace(/(\\d)/g, '#'), 'x#y#z'); check('replace$1', RegExp.$1, '2'); check('replaceLastMatch', RegExp.lastMatch, '2');"
+                                                                    "check('replaceLeft', RegExp.leftContext, 'x1y'); check('replaceRight', RegExp.rightContext, 'z'); check('replaceInput', RegExp.input, 'x1y2z');"
+                                                                    "check('split', 'a1b22c'.split(/\\d+/).join(), 'a,b,c'); check('splitLastMatch', RegExp.lastMatch, '22');"
+                                                                    "check('splitLeft', RegExp.leftContext, 'a1b'); check('splitRight', RegExp.rightContext, 'c'); check('split$1', RegExp.$1, '');"
+                                                                    // a group which did not participate reads as an empty string
+                                                                    "/(a)|(b)/.exec('xb'); check('alt$1', RegExp.$1, ''); check('alt$2', RegExp.$2, 'b'); check('altLastParen', RegExp.lastParen, 'b');"
+                                                                    "/(a)|(b)/.exec('a'); check('alt2$1', RegExp.$1, 'a'); check('alt2$2', RegExp.$2, ''); check('alt2LastParen', RegExp.lastParen, '');"
+                                                                    "/(.)(.)(.)(.)(.)(.)(.)(.)(.)(.)/.exec('abcdefghij'); check('$9', RegExp.$9, 'i'); check('tenLastParen', RegExp.lastParen, 'j');"
+                                                                    "RegExp.input = 'assigned'; check('inputSet', RegExp.input, 'assigned'); check('inputSetLastMatch', RegExp.lastMatch, 'abcdefghij');"
+                                                                    "failed.join(' ')"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "");
+}
+
+TEST(EvalScript, GeneratorResumeThrowReturn) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var failed = [], log = [];"
+                                                                    "function check(name, actual, expected) { if (actual !== expected) { failed.push(name + '=' + actual); } }"
+                                                                    "function result(r) { return r.value + (r.done ? ' done' : ''); }"
+                                                                    "function* sent() { var a = yield 1; var b = yield a + 1; return a + b; }"
+                                                                    "var it = sent(); check('sent1', result(it.next()), '1'); check('sent2', result(it.next(10)), '11'); check('sent3', result(it.next(5)), '15 done');"
+                                                                    "check('sent4', result(it.next()), 'undefined done');"
+                                                                    // pauses inside block, with and try statements
+                                                                    "function* nested() { { let x = yield 1; { yield x * 2; } } with ({ w: 3 }) { yield w; } try { yield 4; } finally { log.push('nested'); } }"
+                                                                    "it = nested(); var values = [it.next().value, it.next(5).value, it.next().value, it.next().value]; it.next();"
+                                                                    "check('nested', values.join() + ' ' + log.join(), '1,10,3,4 nested');"
+                                                                    "function* caught() { try { yield 1; } catch (e) { yield 'caught ' + e; } yield 'after'; }"
+                                                                    "it = caught(); it.next(); check('throw', result(it.throw('x')), 'caught x'); check('throwNext', result(it.next()), 'after');"
+                                                                    "it = caught(); try { it.throw('early'); failed.push('throwNotStarted'); } catch (e) { check('throwNotStarted', e, 'early'); }"
+                                                                    "check('throwNotStartedDone', result(it.next()), 'undefined done');"
+                                                                    "function* uncaught() { yield 1; yield 2; }"
+                                                                    "it = uncaught(); it.next(); try { it.throw('out'); } catch (e) { check('throwOut', e, 'out'); } check('throwOutDone', result(it.next()), 'undefined done');"
+                                                                    // return() runs finally blocks, which may yield or override the value
+                                                                    "log = []; function* cleanup() { try { yield 1; yield 2; } finally { log.push('finally'); } }"
+                                                                    "it = cleanup(); it.next(); check('return', result(it.return(42)), '42 done'); check('returnFinally', log.join(), 'finally');"
+                                                                    "check('returnAfter', result(it.next()), 'undefined done');"
+                                                                    "check('returnNotStarted', result(cleanup().return(1)), '1 done'); check('returnNotStartedFinally', log.join(), 'finally');"
+                                                                    "log = []; function* yieldInFinally() { try { yield 1; } finally { yield 'cleanup'; log.push('end'); } }"
+                                                                    "it = yieldInFinally(); it.next(); check('returnYield', result(it.return(7)), 'cleanup'); check('returnYieldNext', result(it.next()), '7 done');"
+                                                                    "check('returnYieldLog', log.join(), 'end');"
+                                                                    "function* overrides() { try { yield 1; } finally { return 'fin'; } }"
+                                                                    "it = overrides(); it.next(); check('returnOverride', result(it.return(5)), 'fin done');"
+                                                                    "function* rethrow() { try { try { yield 1; } finally { yield 2; } } catch (e) { yield 'outer ' + e; } }"
+                                                                    "it = rethrow(); it.next(); check('rethrowFinally', result(it.throw('t')), '2'); check('rethrowOuter', result(it.next()), 'outer t');"
+                                                                    "log = []; function* inner() { try { yield 'i1'; yield 'i2'; } finally { log.push('inner'); } } function* outer() { yield* inner(); yield 'o'; }"
+                                                                    "it = outer(); it.next(); check('delegateReturn', result(it.return(3)), '3 done'); check('delegateFinally', log.join(), 'inner');"
+                                                                    "it = outer(); it.next(); check('delegateThrow', (function() { try { it.throw('d'); } catch (e) { return e; } })(), 'd'); check('delegateThrowFinally', log.join(), 'inner,inner');"
+                                                                    "function* loop() { for (let i = 0; i < 3; i++) { try { yield i; } catch (e) { yield 'c' + i; } } }"
+                                                                    "it = loop(); it.next(); check('loopThrow', result(it.throw()), 'c0'); check('loopNext', result(it.next()), '1');"
+                                                                    "function* range(n) { for (var i = 0; i < n; i++) { yield i; } } var sum = 0; for (var v of range(1000)) { sum += v; } check('range', sum, 499500);"
+                                                                    "failed.join(' ')"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "");
+}
+
+TEST(EvalScript, ExceptionPassedToHandler) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var failed = [], log = [];"
+                                                                    "function check(name, actual, expected) { if (actual !== expected) { failed.push(name + '=' + actual); } }"
+                                                                    "function catchOf(f) { try { f(); } catch (e) { return e; } return 'none'; }"
+                                                                    "function thrower(v) { log.push('t'); throw v; log.push('after'); }"
+                                                                    "check('same', (function() { try { throw 'a'; } catch (e) { return 'c' + e; } })(), 'ca');"
+                                                                    "check('callee', (function() { try { thrower(1); log.push('no'); } catch (e) { return e + log.join(); } })(), '1t');"
+                                                                    // frames of callers without a try statement, and block and with frames, are left too
+                                                                    "function l3() { throw new Error('deep'); } function l2() { l3(); log.push('l2'); }"
+                                                                    "var deep = (function l1() { try { { let x = 1; with ({}) { l2(); } } } catch (e) { return e; } })();"
+                                                                    "check('deep', deep.message + log.join(), 'deept'); check('deepStack', deep.stack.split('at test.js').length - 1, 4);"
+                                                                    "log = []; function fin() { try { thrower('f'); } finally { log.push('fin'); } }"
+                                                                    "check('finally', catchOf(fin) + log.join(), 'ft,fin');"
+                                                                    "check('finallyReturn', (function() { try { thrower('x'); } finally { return 'over'; } })(), 'over');"
+                                                                    "check('rethrow', catchOf(function() { try { thrower('r'); } catch (e) { throw e + '2'; } }), 'r2');"
+                                                                    "check('catchBody', catchOf(function() { try { thrower('a'); } catch (e) { thrower(e + 'b'); } }), 'ab');"
+                                                                    "log = []; check('nested', (function() { try { try { thrower('n'); } finally { log.push('inner'); } } catch (e) { return e + log.join(); } })(), 'nt,inner');"
+                                                                    "check('nestedCatch', (function() { try { try { thrower('i'); } catch (e) { log.push(e); } thrower('o'); } catch (e) { return e; } })(), 'o');"
+                                                                    // natives, getters, bound functions and proxies between the frames
+                                                                    "check('native', catchOf(function() { [1].forEach(function() { thrower('cb'); }); }), 'cb');"
+                                                                    "var o = { get g() { thrower('get'); } }; check('getter', catchOf(function() { o.g; log.push('no'); }), 'get');"
+                                                                    "check('bound', catchOf(function() { thrower.bind(null, 'bound')(); }), 'bound');"
+                                                                    "var p = new Proxy(function() {}, { apply: function() { thrower('proxy'); } }); check('proxy', catchOf(function() { p(); }), 'proxy');"
+                                                                    "class C { m() { thrower('method'); } } check('method', catchOf(function() { new C().m(); }), 'method');"
+                                                                    "check('arrow', catchOf(() => { (() => thrower('arrow'))(); }), 'arrow');"
+                                                                    "check('classCall', catchOf(function() { C(); }) instanceof TypeError, true);"
+                                                                    "check('builtin', catchOf(function() { (function() { null.x; })(); }) instanceof TypeError, true);"
+                                                                    // builtins throwing by themselves, directly in the try statement and one script frame deeper
+                                                                    "check('nativeThrow', (function() { try { JSON.parse('{'); } catch (e) { return e instanceof SyntaxError; } })(), true);"
+                                                                    "log = []; check('nativeFinally', catchOf(function() { try { [].reduce(add); } finally { log.push('fin'); } }) instanceof TypeError && log.join(), 'fin');"
+                                                                    "function parser() { JSON.parse('{'); log.push('no'); } var ne = (function() { try { parser(); } catch (e) { return e; } })();"
+                                                                    "check('nativeDeep', ne instanceof SyntaxError && ne.stack.split('at test.js').length - 1, 3);"
+                                                                    "check('nativeBound', catchOf(function() { try { JSON.parse.bind(null, '{')(); } catch (e) { throw e.name; } }), 'SyntaxError');"
+                                                                    "check('nativeReceiver', catchOf(function() { try { Symbol().toString.call(1); } catch (e) { throw e.name; } }), 'TypeError');"
+                                                                    "check('nativeCallback', catchOf(function() { try { [1].map(parser); } catch (e) { throw e.name; } }), 'SyntaxError');"
+                                                                    // generators
+                                                                    "function* gen() { thrower('gen'); } check('generator', catchOf(function() { gen().next(); }), 'gen');"
+                                                                    "function* genCatch() { try { thrower('g'); } catch (e) { yield 'caught ' + e; } }"
+                                                                    "check('generatorCatch', genCatch().next().value, 'caught g');"
+                                                                    "function* genYield() { try { yield 1; thrower('y'); } catch (e) { yield e; } } var it = genYield(); it.next();"
+                                                                    "check('generatorResume', it.next().value, 'y');"
+                                                                    "function add(a, b) { return a + b; } check('after', add(1, 2), 3);"
+                                                                    "failed.join(' ')"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "");
+}
+
+TEST(EvalScript, RegExpNativeMatchesInterpreter) {
+    // [regexp, input, lastIndex]. appending an empty lookahead keeps a pattern on the interpreter, which gives the expected result
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var failed = [];"
+                                                                    "function check(name, actual, expected) { if (actual !== expected) { failed.push(name + '=' + actual); } }"
+                                                                    "function run(re, input, lastIndex) { re.lastIndex = lastIndex; var m = re.exec(input); return JSON.stringify(m) + ' ' + (m ? m.index : -1) + ' ' + re.lastIndex; }"
+                                                                    "var cases = ["
+                                                                    // captures
+                                                                    "[/(\\d+)-(\\d+)?/, 'tel 12- x'], [/(a)|(b)/, 'xb'], [/(?:(a)|b)c/, 'abc'], [/(a(b)?)?c/, 'ac'], [/((a)|(b))?c/, 'bc'], [/(x)?(x)??y/, 'xxy'],"
+                                                                    "[/(\\w+)\\s(\\w*?)(\\d{2,3})/, 'ab cd1234'], [/(a)|(b)/g, 'ab', 1],"
+                                                                    // back references and lookarounds
+                                                                    "[/(a+)b\\1/, 'aabaa'], [/(\\w)\\1/, 'abccd'], [/a(?=b)/, 'acab'], [/a(?!b)(\\w)/, 'abac'],"
+                                                                    // sticky
+                                                                    "[/b/y, 'abb', 1], [/b/y, 'abb', 0], [/a|bc/y, 'xbca', 1], [/(a+)(b)?/y, 'baab', 1], [/b/gy, 'abb', 3],"
+                                                                    // unicode
+                                                                    "[/./u, '\\u{1F600}x'], [/\\u{1F600}+/u, 'a\\u{1F600}\\u{1F600}'], [/[^a]/u, 'a\\uD83D\\uDE00'],"
+                                                                    // ignoreCase, multiline, dotAll and 16-bit input
+                                                                    "[/HeLLo/i, 'say hello'], [/[a-c]+x/i, 'zzABcX'], [/[^A-Z]/i, 'ABc1'], [/\\u00e9/i, '\\u00c9'], [/[\\u00e0-\\u00ff]+/i, 'x\\u00c0\\u00e9'],"
+                                                                    "[/\\bw/i, 'aW W'], [/^b/im, 'a\\nB'], [/[\\u3040-\\u309f]+/, 'ab\\u3042\\u3044c'], [/\\u3042|b/, 'xb\\u3042'], [/a.c/s, 'a\\nc'],"
+                                                                    // ^ in front of some alternatives or inside groups
+                                                                    "[/a|^b|ab/, 'xab'], [/(^a)?b/, 'cb'], [/(?:^)?b/, 'xb'], [/x(?:^a|b)/m, 'xb']"
+                                                                    "];"
+                                                                    "for (var i = 0; i < cases.length; i++) {"
+                                                                    "    var re = cases[i][0], lastIndex = cases[i][2] || 0;"
+                                                                    "    check(String(re), run(re, cases[i][1], lastIndex), run(new RegExp('(?:' + re.source + ')(?=)', re.flags), cases[i][1], lastIndex));"
+                                                                    "}"
+                                                                    "check('onceThrough', /a|^b|ab/.exec('xab')[0], 'a'); check('bolInGroup', /(^a)?b/.exec('cb').index, 1);"
+                                                                    "check('bolOptional', /(?:^)?b/.exec('xb').index, 1);"
+                                                                    "failed.join(' ')"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "");
+}
+
+#if defined(ENABLE_REGEXP_JIT)
+TEST(EvalScript, RegExpNativeBacktrackLimit) {
+    // 3^30 ways to fail. the native matcher gives up after Yarr's matchLimit backtracks like the interpreter does
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var failed = [];"
+                                                                    "function check(name, actual, expected) { if (actual !== expected) { failed.push(name + '=' + actual); } }"
+                                                                    "var anchored = new RegExp('^' + '(?:a|a)?'.repeat(30) + '$');"
+                                                                    "check('anchored', anchored.exec('a'.repeat(31)), null); check('anchoredTest', anchored.test('a'.repeat(31)), false);"
+                                                                    "check('anchoredAfter', anchored.exec('a'.repeat(30)).index, 0);"
+                                                                    // quadratic backtracking within the budget still finds the match
+                                                                    "check('longInput', /a*a\\d/.exec('a'.repeat(1000) + 'xa1').index, 1001);"
+                                                                    "failed.join(' ')"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "");
+}
+#endif
+
+TEST(EvalScript, StringBuilderMixedContent) {
+    // short and long, Latin1 and non-Latin1 parts are copied or referenced by StringBuilder
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var long8 = 'x'.repeat(1000), long16 = '\\u3042'.repeat(1000), latin16 = long16.replace(/\\u3042/g, '\\xe9');"
+                                                                    "var parts = ['a', long8, 'b', latin16, String.fromCharCode(0x3042), 'c'.repeat(300), long16, 'd'];"
+                                                                    "var ok = true;"
+                                                                    "for (var i = 0; i < parts.length; i++) {"
+                                                                    "  var sub = parts.slice(0, i + 1); var expected = '';"
+                                                                    "  for (var j = 0; j < sub.length; j++) { expected += sub[j] + (j + 1 < sub.length ? ',' : ''); }"
+                                                                    "  ok = ok && sub.join() === expected && JSON.parse(JSON.stringify(sub)).join() === expected;"
+                                                                    "}"
+                                                                    "ok"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+}
+
+TEST(EvalScript, FreezeAndSealSameShape) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("'use strict';"
+                                                                    "function make(i) { var o = { a: i, b: 'x', get c() { return this.a; }, set d(v) { this.e = v; } }; return o; }"
+                                                                    "var frozen = [], sealed = [];"
+                                                                    "for (var i = 0; i < 4; i++) { frozen.push(Object.freeze(make(i))); sealed.push(Object.seal(make(i))); }"
+                                                                    "var ok = true;"
+                                                                    "Object.defineProperty(sealed[0], 'a', { writable: false });"
+                                                                    "for (var i = 0; i < 4; i++) {"
+                                                                    "  var f = frozen[i], s = sealed[i];"
+                                                                    "  ok = ok && Object.isFrozen(f) && Object.isSealed(s) && !Object.isExtensible(s);"
+                                                                    "  ok = ok && f.c === i && !Object.getOwnPropertyDescriptor(f, 'a').writable && Object.getOwnPropertyDescriptor(f, 'b').enumerable;"
+                                                                    "  try { f.a = 10; ok = false; } catch (e) { ok = ok && e instanceof TypeError; }"
+                                                                    "  try { delete s.b; ok = false; } catch (e) { ok = ok && e instanceof TypeError; }"
+                                                                    "  if (i > 0) { s.a = 10; ok = ok && s.a === 10 && s.c === 10 && Object.getOwnPropertyDescriptor(s, 'a').writable; }"
+                                                                    "}"
+                                                                    "ok = ok && Object.isFrozen(sealed[0]) === false && !Object.getOwnPropertyDescriptor(sealed[0], 'a').writable;"
+                                                                    "var big = {}; for (var i = 0; i < 120; i++) { big['p' + i] = i; } Object.freeze(big);"
+                                                                    "ok && Object.isFrozen(big) && big.p119 === 119"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+}
+
+TEST(EvalScript, ObjectSpreadAndAssignCopy) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var src = { a: 1, b: 2.5, c: 'c', [Symbol.for('s')]: 4 }; src[0] = 0;"
+                                                                    "var spread = { ...src }, assigned = Object.assign({}, src);"
+                                                                    "spread.b += 1; assigned.b *= 2;"
+                                                                    "var ok = src.b === 2.5 && spread.b === 3.5 && assigned.b === 5 && spread[Symbol.for('s')] === 4 && assigned[0] === 0;"
+                                                                    "ok = ok && Object.keys(spread).join() === '0,a,b,c' && Object.keys(assigned).join() === '0,a,b,c';"
+                                                                    "var withProto = { ...{ ['__proto__']: 1 } }, assignedProto = Object.assign({}, JSON.parse('{\"__proto__\": null}'));"
+                                                                    "ok = ok && Object.getOwnPropertyDescriptor(withProto, '__proto__').value === 1 && Object.getPrototypeOf(assignedProto) === null;"
+                                                                    "Object.defineProperty(Object.prototype, 'readOnly', { value: 1, writable: false, configurable: true });"
+                                                                    "try { Object.assign({}, { readOnly: 2 }); ok = false; } catch (e) { ok = ok && e instanceof TypeError; }"
+                                                                    "ok = ok && ({ ...{ readOnly: 2 } }).readOnly === 2; delete Object.prototype.readOnly;"
+                                                                    "ok && ({ ...null, ...undefined, ...'ab' })[1] === 'b'"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+}
+
+TEST(EvalScript, ObjectAssignIndexToPrototype) {
+    // copying an index property onto a prototype must take arrays inheriting from it out of fast mode
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var proto = {}, holey = [3, , 1]; Object.setPrototypeOf(holey, proto);"
+                                                                    "Object.assign(proto, { 1: 2 });"
+                                                                    "holey[1] === 2 && holey.sort().join() === '1,2,3'"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+}
+
+TEST(EvalScript, ArrayHigherOrderFastMode) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("Array.prototype[1] = 'p'; var holey = [0, , 2];"
+                                                                    "var ok = holey.map(function(v) { return v; }).join() === '0,p,2' && holey.indexOf('p') === 1 && holey.includes('p');"
+                                                                    "ok = ok && holey.slice(0).join() === '0,p,2' && [].concat(holey).hasOwnProperty(1); delete Array.prototype[1];"
+                                                                    "var seen = [], grow = [1, 2, 3]; grow.forEach(function(v, i) { seen.push(v); if (i === 0) { grow.length = 2; } });"
+                                                                    "ok = ok && seen.join() === '1,2' && [1, 2, 3].filter(function(v, i, a) { a.push(9); return v > 1; }).join() === '2,3';"
+                                                                    "ok = ok && [1, 2, 3, 4].reduce(function(a, v) { return a + v; }) === 10 && [, , 5].reduce(function(a, v) { return a + v; }) === 5;"
+                                                                    "ok = ok && [1, NaN, 'a'].indexOf(NaN) === -1 && [1, NaN].includes(NaN) && [0, 1.5, 'x'].indexOf(-0) === 0;"
+                                                                    "ok = ok && ['a', 'b' + 'c'].indexOf('bc') === 1 && [, undefined].includes(undefined) && [1, '1'].indexOf('1') === 1;"
+                                                                    "class MyArray extends Array {} var mapped = MyArray.from([1, 2]).map(function(v) { return v * 2; });"
+                                                                    "ok && mapped instanceof MyArray && mapped.join() === '2,4' && Object.freeze([1]).map(function(v) { return v; })[0] === 1"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+}
+
+TEST(EvalScript, PreparedCallbackCalls) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var global = this, self = this;"
+                                                                    "var ok = [1].map(function() { return this; })[0] === global && [1].map(function() { 'use strict'; return this; })[0] === undefined;"
+                                                                    "ok = ok && [1].map(function() { return typeof this; }, 2)[0] === 'object' && [1].map(() => this)[0] === self;"
+                                                                    "function depth(v) { return v > 0 ? [v - 1].map(depth)[0] + 1 : 0; } ok = ok && depth(50) === 50;"
+                                                                    "var count = 0; function thrower(v) { count++; if (v === 2) { throw v; } return v + 0.5; }"
+                                                                    "try { [1, 2, 3].forEach(thrower); ok = false; } catch (e) { ok = ok && e === 2 && count === 2; }"
+                                                                    "ok = ok && [1, 3].map(thrower).join() === '1.5,3.5' && [1, 2].map(function(v) { return arguments.length; }).join() === '3,3';"
+                                                                    "ok = ok && [1, 2].map(function(v) { var f = function() { return v; }; return f(); }).join() === '1,2';"
+                                                                    "ok = ok && [3, 1, 2].sort(function(a, b) { return a - b; }).join() === '1,2,3' && [1, 2].reduce((a, v) => a + v * 1.5, 0) === 4.5;"
+                                                                    "ok && 'abcb'.replace(/b/g, function(m, i) { let r = m + i; return r; }) === 'ab1cb3' && 'ab'.replace('b', function(m) { return m + m; }) === 'abb'"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+}
+
+TEST(EvalScript, NumberAndIndexStringCache) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var a = [], o = {}, ok = true;"
+                                                                    "for (var i = 0; i < 3000; i++) { a['' + i] = i; o[i] = String(i); ok = ok && o[String(i)] === '' + i && (i * 0.5).toString() === String(i / 2); }"
+                                                                    "ok = ok && a.length === 3000 && a['2999'] === 2999 && Object.keys(o).length === 3000 && String(-0) === '0' && String(-70000) === '-70000';"
+                                                                    "a['01'] = 'x'; a['4294967295'] = 'y'; ok = ok && a.length === 3000 && a['01'] === 'x' && a[1] === 1 && a[4294967295] === 'y';"
+                                                                    "var t = new Uint8Array(4); t['2'] = 7; t['-0'] = 9; ok = ok && t[2] === 7 && t['-0'] === undefined;"
+                                                                    "ok && Object.keys({ 10: 1, b: 2, 2: 3 }).join() === '2,10,b' && String(1e21) === '1e+21' && String(123456789.25) === '123456789.25'"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+}
+
+TEST(EvalScript, IndexStringKeysStayStrings) {
+    // array index keys reach user code as strings, however the engine looked them up
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var failed = [];"
+                                                                    "function check(name, actual, expected) { if (actual !== expected) { failed.push(name + '=' + actual); } }"
+                                                                    "check('replacerArray', JSON.stringify([1], function(k, v) { return k === '' ? v : typeof k; }), '[\"string\"]');"
+                                                                    "check('replacerObject', JSON.stringify({ 0: 1 }, function(k, v) { return k === '' ? v : typeof k; }), '{\"0\":\"string\"}');"
+                                                                    "check('replacerList', JSON.stringify({ 1: 'a', 2: 'b' }, ['1', 2]), '{\"1\":\"a\",\"2\":\"b\"}');"
+                                                                    "var keys = []; JSON.stringify([{ toJSON: function(k) { keys.push(typeof k + k); } }, { 5: { toJSON: function(k) { keys.push(typeof k + k); } } }]);"
+                                                                    "check('toJSON', keys.join(), 'string0,string5');"
+                                                                    "check('reviverObject', JSON.stringify(JSON.parse('{\"0\":1}', function(k, v) { return k === '' ? v : typeof k; })), '{\"0\":\"string\"}');"
+                                                                    "check('reviverArray', JSON.parse('[1, [2]]', function(k, v) { return k === '' || typeof v === 'object' ? v : typeof k + k; }).join(), 'string0,string0');"
+                                                                    "var trapped = []; var p = new Proxy({}, { get: function(t, k) { trapped.push(typeof k); return 1; } }); p['3']; p[4];"
+                                                                    "check('proxyKey', trapped.join(), 'string,string');"
+                                                                    "check('keys', typeof Object.keys({ 7: 1 })[0], 'string');"
+                                                                    "failed.join(' ')"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "");
+}
+
+TEST(EvalScript, RopeStringOperations) {
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var s = '', parts = [], ok = true;"
+                                                                    "for (var i = 0; i < 20000; i++) { var p = 'p' + (i % 97) + ';'; s += p; parts.push(p); if (i % 1000 === 0) { ok = ok && s.charAt(s.length - 1) === ';'; } }"
+                                                                    "var flat = parts.join('');"
+                                                                    "ok = ok && s.length === flat.length && s.charCodeAt(12345) === flat.charCodeAt(12345) && s[0] === 'p';"
+                                                                    "ok = ok && s.startsWith('p0;p1;p2;') && s.endsWith(parts[19999]) && !s.startsWith('p1') && s.startsWith('p5;', 15);"
+                                                                    "var k1 = 'key-' + 'x'.repeat(30), k2 = 'key-' + 'x'.repeat(10) + 'x'.repeat(20), o = {}; o[k1] = 1;"
+                                                                    "ok = ok && o[k2] === 1 && k1 === k2 && s === flat && s.indexOf('p96;p0;') === flat.indexOf('p96;p0;');"
+                                                                    "var u = '\\u0100'.repeat(30) + 'a'; ok = ok && (u + s).charCodeAt(0) === 0x100 && (u + s).slice(31, 34) === 'p0;';"
+                                                                    "ok"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var a = 'x'.repeat(30) + '\\uD83D', b = '\\uDE00' + 'y'.repeat(30); a + b"),
+                   StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, std::string(30, 'x') + "\xF0\x9F\x98\x80" + std::string(30, 'y'));
+}
@@ -30,6 +30,7 @@
 #include "Yarr.h"
 #include "YarrCanonicalize.h"
 #include "BumpPointerAllocator.h"
+#include "runtime/RegExpPrefilter.h"
 
 using namespace WTF;
 
@@ -1475,10 +1476,21 @@ public:
 
             input.next();
 
+            if (prefilter) {
+                unsigned candidate = prefilter->nextCandidate(inputBase, input.end(), input.getPos());
+                if (candidate == ::Escargot::RegExpPrefilter::NoCandidate)
+                    return JSRegExpNoMatch;
+                input.setPos(candidate);
+            }
+
             context->matchBegin = input.getPos();
 
-            if (currentTerm().alternative.onceThrough)
+            // onceThrough alternatives are only tried at the first position. optimizeBOL keeps them in front
+            while (currentTerm().alternative.onceThrough) {
+                if (currentTerm().alternative.next <= 0)
+                    return JSRegExpNoMatch;
                 context->term += currentTerm().alternative.next;
+            }
 
             MATCH_NEXT();
         }
@@ -1603,6 +1615,13 @@ public:
         for (unsigned i = 0; i < pattern->m_body->m_numSubpatterns + 1; ++i)
             output[i << 1] = offsetNoMatch;
 
+        if (prefilter) {
+            unsigned candidate = prefilter->nextCandidate(inputBase, input.end(), startOffset);
+            if (candidate == ::Escargot::RegExpPrefilter::NoCandidate)
+                return offsetNoMatch;
+            input.setPos(candidate);
+        }
+
         allocatorPool = pattern->m_allocator->startAllocator();
         RELEASE_ASSERT(allocatorPool);
 
@@ -1623,11 +1642,13 @@ public:
         return output[0];
     }
 
-    Interpreter(BytecodePattern* pattern, unsigned* output, const CharType* input, unsigned length, unsigned start)
+    Interpreter(BytecodePattern* pattern, unsigned* output, const CharType* input, unsigned length, unsigned start, const ::Escargot::RegExpPrefilter* prefilter = nullptr)
         : pattern(pattern)
         , unicode(pattern->unicode())
         , output(output)
         , input(input, start, length, pattern->unicode())
+        , inputBase(input)
+        , prefilter(pattern->sticky() ? nullptr : prefilter)
         , allocatorPool(0)
         , startOffset(start)
         , remainingMatchCount(matchLimit)
@@ -1639,6 +1660,8 @@ private:
     bool unicode;
     unsigned* output;
     InputStream input;
+    const CharType* inputBase;
+    const ::Escargot::RegExpPrefilter* prefilter;
     BumpPointerPool* allocatorPool;
     unsigned startOffset;
     unsigned remainingMatchCount;
@@ -2141,14 +2164,14 @@ unsigned interpret(BytecodePattern* bytecode, const String& input, unsigned star
     return Interpreter<UChar>(bytecode, output, (UChar*)input.characters16(), input.length(), start).interpret();
 }
 
-unsigned interpret(BytecodePattern* bytecode, const LChar* input, unsigned length, unsigned start, unsigned* output)
+unsigned interpret(BytecodePattern* bytecode, const LChar* input, unsigned length, unsigned start, unsigned* output, const ::Escargot::RegExpPrefilter* prefilter)
 {
-    return Interpreter<LChar>(bytecode, output, input, length, start).interpret();
+    return Interpreter<LChar>(bytecode, output, input, length, start, prefilter).interpret();
 }
 
-unsigned interpret(BytecodePattern* bytecode, const UChar* input, unsigned length, unsigned start, unsigned* output)
+unsigned interpret(BytecodePattern* bytecode, const UChar* input, unsigned length, unsigned start, unsigned* output, const ::Escargot::RegExpPrefilter* prefilter)
 {
-    return Interpreter<UChar>(bytecode, output, input, length, start).interpret();
+    return Interpreter<UChar>(bytecode, output, input, length, start, prefilter).interpret();
 }
 
 // These should be the same for both UChar & LChar.
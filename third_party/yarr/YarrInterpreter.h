@@ -32,6 +32,10 @@ class BumpPointerAllocator;
 }
 using WTF::BumpPointerAllocator;
 
+namespace Escargot {
+class RegExpPrefilter;
+}
+
 namespace JSC {
 namespace Yarr {
 
@@ -411,7 +415,8 @@ private:
 
 JS_EXPORT_PRIVATE std::unique_ptr<BytecodePattern> byteCompile(YarrPattern&, BumpPointerAllocator*);
 JS_EXPORT_PRIVATE unsigned interpret(BytecodePattern*, const String& input, unsigned start, unsigned* output);
-unsigned interpret(BytecodePattern*, const LChar* input, unsigned length, unsigned start, unsigned* output);
-unsigned interpret(BytecodePattern*, const UChar* input, unsigned length, unsigned start, unsigned* output);
+// prefilter lets the interpreter skip start positions which cannot begin a match
+unsigned interpret(BytecodePattern*, const LChar* input, unsigned length, unsigned start, unsigned* output, const ::Escargot::RegExpPrefilter* prefilter = nullptr);
+unsigned interpret(BytecodePattern*, const UChar* input, unsigned length, unsigned start, unsigned* output, const ::Escargot::RegExpPrefilter* prefilter = nullptr);
 }
 } // namespace JSC::Yarr
@@ -640,8 +640,8 @@ public:
 
         if (numBOLAnchoredAlts) {
             m_alternative->m_containsBOL = true;
-            // If all the alternatives in parens start with BOL, then so does this one
-            if (numBOLAnchoredAlts == numParenAlternatives)
+            // If all the alternatives in parens start with BOL and the parens are the first term, then so does this one
+            if (numBOLAnchoredAlts == numParenAlternatives && m_alternative->m_terms.size() == 1)
                 m_alternative->m_startsWithBOL = true;
         }
 
@@ -705,7 +705,9 @@ public:
     }
 
     // deep copy the argument disjunction.  If filterStartsWithBOL is true,
-    // skip alternatives with m_startsWithBOL set true.
+    // skip alternatives with m_startsWithBOL set true. Nested parentheses are
+    // copied as they are, since a group which may be skipped can hold only
+    // anchored alternatives.
     PatternDisjunction* copyDisjunction(PatternDisjunction* disjunction, bool filterStartsWithBOL = false)
     {
         std::unique_ptr<PatternDisjunction> newDisjunction;
@@ -719,7 +721,7 @@ public:
                 PatternAlternative* newAlternative = newDisjunction->addNewAlternative();
                 newAlternative->m_terms.reserveInitialCapacity(alternative->m_terms.size());
                 for (unsigned i = 0; i < alternative->m_terms.size(); ++i)
-                    newAlternative->m_terms.append(copyTerm(alternative->m_terms[i], filterStartsWithBOL));
+                    newAlternative->m_terms.append(copyTerm(alternative->m_terms[i]));
             }
         }
 
@@ -731,13 +733,13 @@ public:
         return copiedDisjunction;
     }
 
-    PatternTerm copyTerm(PatternTerm& term, bool filterStartsWithBOL = false)
+    PatternTerm copyTerm(PatternTerm& term)
     {
         if ((term.type != PatternTerm::TypeParenthesesSubpattern) && (term.type != PatternTerm::TypeParentheticalAssertion))
             return PatternTerm(term);
 
         PatternTerm termCopy = term;
-        termCopy.parentheses.disjunction = copyDisjunction(termCopy.parentheses.disjunction, filterStartsWithBOL);
+        termCopy.parentheses.disjunction = copyDisjunction(termCopy.parentheses.disjunction);
         m_pattern.m_hasCopiedParenSubexpressions = true;
         return termCopy;
     }
@@ -747,6 +749,10 @@ public:
         ASSERT(min <= max);
         ASSERT(m_alternative->m_terms.size());
 
+        // A leading parentheses which may be skipped doesn't anchor the alternative
+        if (!min && m_alternative->m_terms.size() == 1)
+            m_alternative->m_startsWithBOL = false;
+
         if (!max) {
             m_alternative->removeLastTerm();
             return;
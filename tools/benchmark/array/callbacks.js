@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// builtins calling small script functions in tight loops
+var million = [];
+for (var i = 0; i < 1000000; i++) {
+    million.push(i);
+}
+
+benchmark("array-map-arrow-1m", 5, function() {
+    return million.map(x => x * 2).length;
+});
+
+benchmark("array-sort-comparator", 10, function() {
+    var values = [];
+    for (var i = 0; i < 50000; i++) {
+        values.push((i * 7919) % 50000);
+    }
+    values.sort(function(a, b) { return a - b; });
+    return values[0];
+});
+
+benchmark("string-replace-function", 10, function() {
+    var text = "a-b-c-d-e-f-g-h-i-j-".repeat(5000);
+    return text.replace(/-/g, function(m) { return "+"; }).length;
+});
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// callbacks and searches over dense arrays
+var numbers = [];
+var names = [];
+for (var i = 0; i < 1000; i++) {
+    numbers.push(i * 1.5);
+    names.push("name" + i);
+}
+
+benchmark("array-map-filter-reduce", 20, function() {
+    var total = 0;
+    for (var i = 0; i < 200; i++) {
+        total += numbers.map(function(v) { return v * 2; }).filter(function(v) { return v > 100; }).reduce(function(a, v) { return a + v; }, 0);
+    }
+    return total;
+});
+
+benchmark("array-forEach", 20, function() {
+    var total = 0;
+    for (var i = 0; i < 200; i++) {
+        numbers.forEach(function(v) { total += v; });
+    }
+    return total;
+});
+
+benchmark("array-indexOf-includes", 20, function() {
+    var found = 0;
+    for (var i = 0; i < 2000; i++) {
+        found += numbers.indexOf((i % 1000) * 1.5);
+        if (names.includes("name" + (i % 1200))) {
+            found++;
+        }
+    }
+    return found;
+});
+
+benchmark("array-slice-concat", 20, function() {
+    var length = 0;
+    for (var i = 0; i < 500; i++) {
+        length += numbers.slice(100, 900).concat(names).length;
+    }
+    return length;
+});
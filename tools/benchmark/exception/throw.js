@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// exceptions thrown and caught inside one function
+function validate(v) {
+    try {
+        if (typeof v !== "number") {
+            throw new TypeError("not a number");
+        }
+        {
+            let limit = 100;
+            if (v > limit) {
+                throw v;
+            }
+        }
+        return true;
+    } catch (e) {
+        return false;
+    }
+}
+
+function withFinally(n) {
+    var count = 0;
+    for (var i = 0; i < n; i++) {
+        try {
+            try {
+                throw i;
+            } finally {
+                count++;
+            }
+        } catch (e) {
+            count += e & 1;
+        }
+    }
+    return count;
+}
+
+benchmark("throw-validate", 20, function() {
+    var valid = 0;
+    for (var i = 0; i < 50000; i++) {
+        if (validate(i % 3 ? i : "x")) {
+            valid++;
+        }
+    }
+    return valid;
+});
+
+benchmark("throw-finally", 20, function() {
+    return withFinally(50000);
+});
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// async functions awaiting values which are already available, like request handlers hitting caches
+async function sumAwaited(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        sum += await i;
+    }
+    return sum;
+}
+
+async function sumAwaitedInTry(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        try {
+            sum += await Promise.resolve(i);
+        } catch (e) {
+            sum = -1;
+        }
+    }
+    return sum;
+}
+
+async function handler(i) {
+    var a = await i;
+    var b = await (a + 1);
+    return a + b;
+}
+
+benchmarkAsync("async-await", 20, function() {
+    return sumAwaited(50000);
+});
+
+benchmarkAsync("async-await-in-try", 20, function() {
+    return sumAwaitedInTry(50000);
+});
+
+benchmarkAsync("async-call-chain", 20, async function() {
+    var sum = 0;
+    for (var i = 0; i < 20000; i++) {
+        sum += await handler(i);
+    }
+    return sum;
+});
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// generators suspended and resumed once per value
+function* range(n) {
+    for (var i = 0; i < n; i++) {
+        yield i;
+    }
+}
+
+function* rangeInTry(n) {
+    try {
+        for (let i = 0; i < n; i++) {
+            yield i;
+        }
+    } finally {
+        n = 0;
+    }
+}
+
+function* delegate(n) {
+    yield* range(n);
+}
+
+benchmark("generator-yield", 20, function() {
+    var sum = 0;
+    for (var v of range(100000)) {
+        sum += v;
+    }
+    return sum;
+});
+
+benchmark("generator-yield-in-try", 20, function() {
+    var sum = 0;
+    for (var v of rangeInTry(100000)) {
+        sum += v;
+    }
+    return sum;
+});
+
+benchmark("generator-delegate", 20, function() {
+    var sum = 0;
+    var it = delegate(100000);
+    for (var r = it.next(); !r.done; r = it.next()) {
+        sum += r.value;
+    }
+    return sum;
+});
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// Loaded before every benchmark file. benchmark() runs fn for a warm-up round and then
+// for the given number of rounds, and prints the average time of a round.
+// fn should return a value depending on its work so the result can be checked.
+function benchmark(name, rounds, fn) {
+    var expected = fn();
+    var start = Date.now();
+    for (var i = 0; i < rounds; i++) {
+        var result = fn();
+        if (result !== expected) {
+            throw new Error(name + ": result changed from " + expected + " to " + result);
+        }
+    }
+    var elapsed = Date.now() - start;
+    print(name + ": " + (elapsed / rounds).toFixed(3) + " ms (" + rounds + " rounds, result " + expected + ")");
+}
+
+// same as benchmark() for a fn returning a promise. rounds run one after another on the job queue,
+// which the shell drains after each file, so the line is printed once the last round settles
+function benchmarkAsync(name, rounds, fn) {
+    var expected;
+    var start;
+    var i = 0;
+    function round(result) {
+        if (i == 0) {
+            expected = result;
+            start = Date.now();
+        } else if (result !== expected) {
+            throw new Error(name + ": result changed from " + expected + " to " + result);
+        }
+        if (i++ < rounds) {
+            return fn().then(round);
+        }
+        var elapsed = Date.now() - start;
+        print(name + ": " + (elapsed / rounds).toFixed(3) + " ms (" + rounds + " rounds, result " + expected + ")");
+    }
+    fn().then(round).catch(function(e) {
+        print(name + ": " + e);
+    });
+}
+
+function repeatString(str, count) {
+    var result = "";
+    for (var i = 0; i < count; i++) {
+        result += str;
+    }
+    return result;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// immutable updates of a reducer state
+var initialState = {
+    user: null,
+    loading: false,
+    error: null,
+    items: [],
+    page: 0,
+    pageSize: 20,
+    filter: "",
+    sortKey: "name",
+    sortAscending: true,
+    selected: -1
+};
+
+function reducer(state, action) {
+    switch (action.type) {
+    case "load":
+        return { ...state, loading: true, error: null };
+    case "loaded":
+        return { ...state, loading: false, page: state.page + 1 };
+    case "select":
+        return { ...state, selected: action.index };
+    case "filter":
+        return Object.assign({}, state, { filter: action.filter, page: 0 });
+    default:
+        return state;
+    }
+}
+
+var actions = [{ type: "load" }, { type: "loaded" }, { type: "select", index: 3 }, { type: "filter", filter: "a" }, { type: "none" }];
+
+benchmark("object-spread-reducer", 20, function() {
+    var state = initialState;
+    for (var i = 0; i < 50000; i++) {
+        state = reducer(state, actions[i % actions.length]);
+    }
+    return state.page + state.selected;
+});
+
+benchmark("object-spread-copy", 20, function() {
+    var total = 0;
+    for (var i = 0; i < 50000; i++) {
+        var copy = { ...initialState };
+        total += copy.pageSize;
+    }
+    return total;
+});
+
+benchmark("object-assign-copy", 20, function() {
+    var total = 0;
+    for (var i = 0; i < 50000; i++) {
+        var copy = Object.assign({}, initialState);
+        total += copy.pageSize;
+    }
+    return total;
+});
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// capture groups, alternatives and replace callbacks
+var lines = [];
+for (var i = 0; i < 3000; i++) {
+    lines.push((i % 2 ? "GET" : "POST") + " /api/v" + (i % 3 + 1) + "/items/" + i + "?q=" + (i * 7 % 1000) + " HTTP/1.1");
+}
+var requests = lines.join("\n");
+
+benchmark("regexp-captures-exec", 10, function() {
+    var re = /(GET|POST|PUT) \/api\/v(\d)\/(\w+)\/(\d+)(?:\?q=(\d+))? HTTP\/1\.[01]/g;
+    var sum = 0;
+    var m;
+    while ((m = re.exec(requests))) {
+        sum += m[2] * 1 + m[4].length + (m[5] ? 1 : 0);
+    }
+    return sum;
+});
+
+benchmark("regexp-replace-function", 10, function() {
+    return requests.replace(/\/items\/(\d+)/g, function(all, id) {
+        return "/i/" + (id % 10);
+    }).length;
+});
+
+benchmark("regexp-replace-pattern", 10, function() {
+    return requests.replace(/(\w+)=(\d+)/g, "$2=$1").length;
+});
+
+benchmark("regexp-split", 10, function() {
+    return requests.split(/[\/?=\s]+/).length;
+});
+
+var date = /(\d{4})-(\d{2})-(\d{2})(?:T(\d{2}):(\d{2}))?/;
+benchmark("regexp-date-parse", 10, function() {
+    var sum = 0;
+    for (var i = 0; i < 5000; i++) {
+        var m = date.exec("stamp 2020-0" + (i % 9 + 1) + "-1" + (i % 10) + (i % 2 ? "T12:30" : ""));
+        sum += m[2] * 1 + (m[4] ? 1 : 0);
+    }
+    return sum;
+});
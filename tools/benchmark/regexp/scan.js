@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// searches where most of the input cannot start a match
+var log = "";
+for (var i = 0; i < 2000; i++) {
+    log += "2020-05-" + (i % 28 + 10) + " INFO worker-" + (i % 7) + " handled request in " + (i % 97) + "ms\n";
+    if (i % 50 == 0) {
+        log += "2020-05-11 ERROR worker-3 timeout after 30000ms\n";
+    }
+}
+var wideLog = log + "あ";
+
+benchmark("regexp-literal-search", 50, function() {
+    return log.match(/ERROR/g).length;
+});
+
+benchmark("regexp-literal-search-16bit", 50, function() {
+    return wideLog.match(/ERROR/g).length;
+});
+
+benchmark("regexp-anchored-multiline", 20, function() {
+    return log.match(/^\d{4}-\d\d-\d\d ERROR/mg).length;
+});
+
+benchmark("regexp-class-scan", 20, function() {
+    return log.replace(/[A-Z]{4,5}/g, "").length;
+});
+
+benchmark("regexp-no-match", 50, function() {
+    return /WARN(ING)?/.test(log) ? 1 : 0;
+});
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// a small JavaScript lexer driven by one global regexp
+var source = repeatString("function add(a, b) { return a + b * 0x1f - 3.25; } // sum\nvar s = 'text' + \"more\";\n", 500);
+var token = /\s+|\/\/[^\n]*|[A-Za-z_$][\w$]*|0x[0-9a-fA-F]+|\d+(?:\.\d+)?|'[^']*'|"[^"]*"|[{}()\[\];,.+\-*\/=<>!]/g;
+
+benchmark("regexp-tokenizer", 20, function() {
+    var count = 0;
+    token.lastIndex = 0;
+    while (token.exec(source)) {
+        count++;
+    }
+    return count;
+});
+
+var identifier = /^[A-Za-z_$][\w$]*$/;
+var words = source.split(/\W+/);
+benchmark("regexp-identifier-test", 20, function() {
+    var count = 0;
+    for (var i = 0; i < words.length; i++) {
+        if (identifier.test(words[i])) {
+            count++;
+        }
+    }
+    return count;
+});
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// strings built by concatenation in loops and read before they are flattened
+benchmark("rope-append-check-last", 5, function() {
+    var s = "";
+    var count = 0;
+    for (var i = 0; i < 100000; i++) {
+        s += "item" + i + ",";
+        if (s.charCodeAt(s.length - 1) === 44) {
+            count++;
+        }
+    }
+    return count;
+});
+
+benchmark("rope-starts-ends-with", 5, function() {
+    var s = "header:";
+    var count = 0;
+    for (var i = 0; i < 100000; i++) {
+        s += "line " + i + "\n";
+        if (s.startsWith("header:") && s.endsWith("\n")) {
+            count++;
+        }
+    }
+    return count;
+});
+
+benchmark("rope-property-key", 10, function() {
+    var o = {};
+    for (var i = 0; i < 1000; i++) {
+        o["a-fairly-long-property-name-" + i] = i;
+    }
+    var sum = 0;
+    for (var j = 0; j < 100; j++) {
+        for (var i = 0; i < 1000; i++) {
+            sum += o["a-fairly-long-property-name-" + i];
+        }
+    }
+    return sum;
+});
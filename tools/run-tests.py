@@ -507,6 +507,26 @@ def run_intl(engine, arch):
     if fails > 0:
         raise Exception('Intl tests failed')
 
+BENCHMARK_DIR = join(PROJECT_SOURCE_DIR, 'tools', 'benchmark')
+BENCHMARK_TOPICS = sorted(topic for topic in os.listdir(BENCHMARK_DIR) if os.path.isdir(join(BENCHMARK_DIR, topic)))
+
+
+def run_benchmark(engine, topic):
+    for test in sorted(glob(join(BENCHMARK_DIR, topic, '*.js'))):
+        run([engine, join(BENCHMARK_DIR, 'harness.js'), test])
+
+
+# one '<topic>-benchmark' runner for each directory of tools/benchmark, and 'benchmark' for all of them
+for topic in BENCHMARK_TOPICS:
+    runner('%s-benchmark' % topic)(lambda engine, arch, topic=topic: run_benchmark(engine, topic))
+
+
+@runner('benchmark', default=False)
+def run_all_benchmarks(engine, arch):
+    for topic in BENCHMARK_TOPICS:
+        run_benchmark(engine, topic)
+
+
 @runner('cctest', default=False)
 def run_cctest(engine, arch):
     if engine is "escargot":